@@ -444,6 +444,176 @@ void SparseAllocator::PrintRequests( ostream * os ) const
   *os << "]." << endl;
 }
 
+//==================================================
+// BitAllocator
+//==================================================
+
+BitAllocator::BitAllocator( Module *parent, const string& name,
+			    int inputs, int outputs ) :
+  Allocator( parent, name, inputs, outputs ),
+  _in_occ( inputs ), _out_occ( outputs )
+{
+  _in_words  = ( _inputs + 63 ) / 64;
+  _out_words = ( _outputs + 63 ) / 64;
+
+  _request = new sRequest [_inputs*_outputs];
+  _top_pri = new int [_inputs*_outputs];
+  for ( int i = 0; i < _inputs; ++i ) {
+    for ( int j = 0; j < _outputs; ++j ) {
+      _Request( i, j ).port  = j;
+      _Request( i, j ).label = -1;
+    }
+  }
+
+  _in_bits  = new tWord [_inputs*_out_words];
+  _out_bits = new tWord [_outputs*_in_words];
+  for ( int k = 0; k < _inputs*_out_words; ++k ) {
+    _in_bits[k] = 0;
+  }
+  for ( int k = 0; k < _outputs*_in_words; ++k ) {
+    _out_bits[k] = 0;
+  }
+}
+
+BitAllocator::~BitAllocator( )
+{
+  delete [] _request;
+  delete [] _top_pri;
+  delete [] _in_bits;
+  delete [] _out_bits;
+}
+
+// only the occupied rows are touched
+void BitAllocator::Clear( )
+{
+  for ( int in = _in_occ.First( ); in >= 0; in = _in_occ.Next( in ) ) {
+    tWord *row = _InRow( in );
+    for ( int out = _NextBit( row, 0, _out_words, 0 ); out >= 0;
+	  out = _NextBit( row, 0, _out_words, out + 1 ) ) {
+      _Request( in, out ).label = -1;
+    }
+    for ( int w = 0; w < _out_words; ++w ) {
+      row[w] = 0;
+    }
+  }
+
+  for ( int out = _out_occ.First( ); out >= 0; out = _out_occ.Next( out ) ) {
+    tWord *row = _OutRow( out );
+    for ( int w = 0; w < _in_words; ++w ) {
+      row[w] = 0;
+    }
+  }
+
+  _in_occ.Clear( );
+  _out_occ.Clear( );
+}
+
+int BitAllocator::ReadRequest( int in, int out ) const
+{
+  assert( ( in >= 0 ) && ( in < _inputs ) &&
+	  ( out >= 0 ) && ( out < _outputs ) );
+
+  return _Request( in, out ).label;
+}
+
+bool BitAllocator::ReadRequest( sRequest &req, int in, int out ) const
+{
+  assert( ( in >= 0 ) && ( in < _inputs ) &&
+	  ( out >= 0 ) && ( out < _outputs ) );
+
+  req = _Request( in, out );
+
+  return ( req.label != -1 );
+}
+
+// as in the sparse allocator, a request replaces the one for the same
+// pair only if its input priority is higher
+void BitAllocator::AddRequest( int in, int out, int label, 
+			       int in_pri, int out_pri )
+{
+  assert( ( in >= 0 ) && ( in < _inputs ) &&
+	  ( out >= 0 ) && ( out < _outputs ) );
+
+  if ( label < 0 ) {
+    return;
+  }
+
+  sRequest &req = _Request( in, out );
+  int      &top = _top_pri[in*_outputs+out];
+
+  if ( req.label == -1 ) {
+    req.label   = label;
+    req.in_pri  = in_pri;
+    req.out_pri = out_pri;
+    top         = out_pri;
+
+    _InRow( in )[out >> 6]  |= 1ULL << ( out & 63 );
+    _OutRow( out )[in >> 6] |= 1ULL << ( in & 63 );
+    _in_occ.Set( in );
+    _out_occ.Set( out );
+  } else {
+    if ( req.in_pri < in_pri ) {
+      req.label   = label;
+      req.in_pri  = in_pri;
+      req.out_pri = out_pri;
+    }
+    if ( top < out_pri ) {
+      top = out_pri;
+    }
+  }
+}
+
+void BitAllocator::RemoveRequest( int in, int out, int label )
+{
+  assert( ( in >= 0 ) && ( in < _inputs ) &&
+	  ( out >= 0 ) && ( out < _outputs ) ); 
+  assert( _Request( in, out ).label != -1 );
+
+  _Request( in, out ).label = -1;
+
+  _InRow( in )[out >> 6]  &= ~( 1ULL << ( out & 63 ) );
+  _OutRow( out )[in >> 6] &= ~( 1ULL << ( in & 63 ) );
+  if ( _NextBit( _InRow( in ), 0, _out_words, 0 ) < 0 ) {
+    _in_occ.Reset( in );
+  }
+  if ( _NextBit( _OutRow( out ), 0, _in_words, 0 ) < 0 ) {
+    _out_occ.Reset( out );
+  }
+}
+
+void BitAllocator::PrintRequests( ostream * os ) const
+{
+  if(!os) os = &cout;
+  
+  *os << "Input requests = [ ";
+  for ( int input = 0; input < _inputs; ++input ) {
+    *os << input << " -> [ ";
+    const tWord *row = _InRow( input );
+    for ( int out = _NextBit( row, 0, _out_words, 0 ); out >= 0;
+	  out = _NextBit( row, 0, _out_words, out + 1 ) ) {
+      *os << out << " ";
+    }
+    *os << "]  ";
+  }
+  *os << "], output requests = [ ";
+  for ( int output = 0; output < _outputs; ++output ) {
+    *os << output << " -> ";
+    if ( _outmask[output] == 0 ) {
+      *os << "[ ";
+      const tWord *row = _OutRow( output );
+      for ( int in = _NextBit( row, 0, _in_words, 0 ); in >= 0;
+	    in = _NextBit( row, 0, _in_words, in + 1 ) ) {
+	*os << in << " ";
+      }
+      *os << "]  ";
+    } else {
+      *os << "masked  ";
+    }
+    *os << "] ";
+  }
+  *os << "]." << endl;
+}
+
 //==================================================
 // Global allocator allocation function
 //==================================================
@@ -461,18 +631,30 @@ Allocator *Allocator::NewAllocator( Module *parent, const string& name,
     a = new PIM( parent, name, inputs, outputs, iters );
   } else if ( alloc_type == "islip" ) {
     a = new iSLIP_Sparse( parent, name, inputs, outputs, iters );
+  } else if ( alloc_type == "dense_islip" ) {
+    a = new iSLIP_Dense( parent, name, inputs, outputs, iters );
   } else if ( alloc_type == "loa" ) {
     a = new LOA( parent, name, inputs, outputs );
   } else if ( alloc_type == "wavefront" ) {
     a = new Wavefront( parent, name, inputs, outputs );
+  } else if ( alloc_type == "dense_wavefront" ) {
+    a = new DenseWavefront( parent, name, inputs, outputs );
   } else if ( alloc_type == "select" ) {
     a = new SelAlloc( parent, name, inputs, outputs, iters );
+  } else if ( alloc_type == "dense_select" ) {
+    a = new DenseSelAlloc( parent, name, inputs, outputs, iters );
   } else if (alloc_type == "separable_input_first") {
     a = new SeparableInputFirstAllocator( parent, name, inputs, outputs,
 					  arb_type );
   } else if (alloc_type == "separable_output_first") {
     a = new SeparableOutputFirstAllocator( parent, name, inputs, outputs,
 					   arb_type );
+  } else if (alloc_type == "dense_separable_input_first") {
+    a = new DenseSeparableInputFirstAllocator( parent, name, inputs, outputs,
+					       arb_type );
+  } else if (alloc_type == "dense_separable_output_first") {
+    a = new DenseSeparableOutputFirstAllocator( parent, name, inputs, outputs,
+						arb_type );
   }
 
 //==================================================
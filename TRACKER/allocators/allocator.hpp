@@ -36,6 +36,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "module.hpp"
 #include "config_utils.hpp"
+#include "bitset.hpp"
 
 class Allocator : public Module {
 protected:
@@ -72,6 +73,10 @@ public:
   
   virtual void Allocate( ) = 0;
 
+  // false if Allocate( ) changes state even without requests, so the
+  // idle cycles of its router cannot be skipped
+  virtual bool IdleSkippable( ) const { return true; }
+
   void MaskOutput( int out, int mask = 1 );
 
   int OutputAssigned( int in ) const;
@@ -140,4 +145,76 @@ public:
   void PrintRequests( ostream * os = NULL ) const;
 };
 
+//==================================================
+// A bit allocator stores the request matrix in one
+// array and mirrors it in rows of bits per input and
+// per output, so requests are found with
+// find-first-set instead of list walks.
+//==================================================
+
+class BitAllocator : public Allocator {
+protected:
+  typedef unsigned long long tWord;
+
+  int _in_words;   // words in an output's row of inputs
+  int _out_words;  // words in an input's row of outputs
+
+  sRequest *_request;   // [in*_outputs+out], label -1 when empty
+  int      *_top_pri;   // highest out_pri requested for each pair
+
+  tWord *_in_bits;      // outputs requested by each input
+  tWord *_out_bits;     // inputs requesting each output
+
+  BitSet _in_occ;
+  BitSet _out_occ;
+
+  sRequest &_Request( int in, int out ) { return _request[in*_outputs+out]; }
+  const sRequest &_Request( int in, int out ) const { return _request[in*_outputs+out]; }
+  tWord *_InRow( int in ) const { return _in_bits + in*_out_words; }
+  tWord *_OutRow( int out ) const { return _out_bits + out*_in_words; }
+
+  // first bit at or after from set in a (and in b if given), -1 if none
+  static int _NextBit( const tWord *a, const tWord *b, int words, int from )
+  {
+    int w = from >> 6;
+    if ( w >= words ) {
+      return -1;
+    }
+    tWord bits = a[w] & ( b ? b[w] : ~0ULL ) & ( ~0ULL << ( from & 63 ) );
+    while ( !bits ) {
+      if ( ++w >= words ) {
+	return -1;
+      }
+      bits = a[w] & ( b ? b[w] : ~0ULL );
+    }
+    return ( w << 6 ) + __builtin_ctzll( bits );
+  }
+
+  // the same, wrapping around to 0: a round-robin pick starting at from
+  static int _FirstFrom( const tWord *a, const tWord *b, int words, int from )
+  {
+    int i = _NextBit( a, b, words, from );
+    if ( ( i < 0 ) && ( from > 0 ) ) {
+      i = _NextBit( a, b, words, 0 );
+    }
+    return i;
+  }
+
+public:
+  BitAllocator( Module *parent, const string& name,
+		int inputs, int outputs );
+  virtual ~BitAllocator( );
+
+  void Clear( );
+  
+  int  ReadRequest( int in, int out ) const;
+  bool ReadRequest( sRequest &req, int in, int out ) const;
+
+  void AddRequest( int in, int out, int label = 1, 
+		   int in_pri = 0, int out_pri = 0 );
+  void RemoveRequest( int in, int out, int label = 1 );
+  
+  void PrintRequests( ostream * os = NULL ) const;
+};
+
 #endif
@@ -196,3 +196,93 @@ void iSLIP_Sparse::Allocate( )
   cout << endl;
 #endif
 }
+
+iSLIP_Dense::iSLIP_Dense( Module *parent, const string& name,
+			  int inputs, int outputs, int iters ) :
+  BitAllocator( parent, name, inputs, outputs ),
+  _iSLIP_iter(iters)
+{
+  _grants = new int [_outputs];
+  _gptrs  = new int [_outputs];
+  _aptrs  = new int [_inputs];
+
+  for ( int i = 0; i < _inputs; ++i ) {
+    _aptrs[i] = 0;
+  }
+  for ( int j = 0; j < _outputs; ++j ) {
+    _grants[j] = -1;
+    _gptrs[j]  = 0;
+  }
+
+  _free_in    = new tWord [_in_words];
+  _grant_bits = new tWord [_inputs*_out_words];
+  for ( int k = 0; k < _inputs*_out_words; ++k ) {
+    _grant_bits[k] = 0;
+  }
+}
+
+iSLIP_Dense::~iSLIP_Dense( )
+{
+  delete [] _grants;
+  delete [] _gptrs;
+  delete [] _aptrs;
+  delete [] _free_in;
+  delete [] _grant_bits;
+}
+
+void iSLIP_Dense::Allocate( )
+{
+  int input;
+  int output;
+
+  _ClearMatching( );
+
+  for ( int w = 0; w < _in_words; ++w ) {
+    _free_in[w] = ~0ULL;
+  }
+
+  for ( int iter = 0; iter < _iSLIP_iter; ++iter ) {
+    // Grant phase: the first free requesting input from the pointer
+
+    for ( output = 0; output < _outputs; ++output ) {
+      if ( _grants[output] != -1 ) {
+	_grant_bits[_grants[output]*_out_words + ( output >> 6 )] &= 
+	  ~( 1ULL << ( output & 63 ) );
+	_grants[output] = -1;
+      }
+
+      if ( _outmatch[output] != -1 ) {
+	continue;
+      }
+
+      input = _FirstFrom( _OutRow( output ), _free_in, _in_words, 
+			  _gptrs[output] );
+      if ( input != -1 ) {
+	_grants[output] = input;
+	_grant_bits[input*_out_words + ( output >> 6 )] |= 
+	  1ULL << ( output & 63 );
+      }
+    }
+
+    // Accept phase: the first granting output from the pointer
+
+    for ( input = _in_occ.First( ); input >= 0; 
+	  input = _in_occ.Next( input ) ) {
+
+      output = _FirstFrom( _InRow( input ), _grant_bits + input*_out_words,
+			   _out_words, _aptrs[input] );
+      if ( output != -1 ) {
+	// Accept
+	_inmatch[input]   = output;
+	_outmatch[output] = input;
+	_free_in[input >> 6] &= ~( 1ULL << ( input & 63 ) );
+
+	// Only update pointers if accepted during the 1st iteration
+	if ( iter == 0 ) {
+	  _gptrs[output] = ( input + 1 ) % _inputs;
+	  _aptrs[input]  = ( output + 1 ) % _outputs;
+	}
+      }
+    }
+  }
+}
@@ -48,4 +48,24 @@ public:
   void Allocate( );
 };
 
+// iSLIP on a bit allocator: each round-robin grant and accept is a
+// find-first-set over a whole row of requests
+class iSLIP_Dense : public BitAllocator {
+  int _iSLIP_iter;
+
+  int *_grants;
+  int *_gptrs;
+  int *_aptrs;
+
+  tWord *_free_in;     // inputs not matched yet
+  tWord *_grant_bits;  // per input, the outputs granting it
+
+public:
+  iSLIP_Dense( Module *parent, const string& name,
+	       int inputs, int outputs, int iters );
+  ~iSLIP_Dense( );
+
+  void Allocate( );
+};
+
 #endif 
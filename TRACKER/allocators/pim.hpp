@@ -44,6 +44,9 @@ public:
   ~PIM( );
 
   void Allocate( );
+
+  // every Allocate( ) draws random numbers
+  bool IdleSkippable( ) const { return false; }
 };
 
 #endif
@@ -251,3 +251,173 @@ void SelAlloc::Allocate( )// for a single router
   cout << endl;
 #endif 
 }
+
+DenseSelAlloc::DenseSelAlloc( Module *parent, const string& name,
+			      int inputs, int outputs, int iters ) :
+  BitAllocator( parent, name, inputs, outputs )
+{
+  _iter = iters;
+
+  _grants = new int [outputs];
+  _gptrs  = new int [outputs];
+  _aptrs  = new int [inputs];
+
+  for ( int i = 0; i < inputs; ++i ) {
+    _aptrs[i] = 0;
+  }
+  for ( int j = 0; j < outputs; ++j ) {
+    _grants[j] = -1;
+    _gptrs[j]  = 0;
+  }
+
+  _free_in    = new tWord [_in_words];
+  _grant_bits = new tWord [inputs*_out_words];
+  for ( int k = 0; k < inputs*_out_words; ++k ) {
+    _grant_bits[k] = 0;
+  }
+}
+
+DenseSelAlloc::~DenseSelAlloc( )
+{
+  delete [] _grants;
+  delete [] _aptrs;
+  delete [] _gptrs;
+  delete [] _free_in;
+  delete [] _grant_bits;
+}
+
+// keeps _grant_bits in step with _grants
+void DenseSelAlloc::_Grant( int output, int input )
+{
+  tWord bit = 1ULL << ( output & 63 );
+  if ( _grants[output] != -1 ) {
+    _grant_bits[_grants[output]*_out_words + ( output >> 6 )] &= ~bit;
+  }
+  _grants[output] = input;
+  if ( input != -1 ) {
+    _grant_bits[input*_out_words + ( output >> 6 )] |= bit;
+  }
+}
+
+void DenseSelAlloc::Allocate( )
+{
+  int input;
+  int output;
+
+  int offset;
+  bool wrapped;
+
+  int max_index;
+  int max_pri;
+
+  _ClearMatching( );
+
+  for ( int i = 0; i < _outputs; ++i ) {
+    if ( _grants[i] != -1 ) {
+      _Grant( i, -1 );
+    }
+  }
+  for ( int w = 0; w < _in_words; ++w ) {
+    _free_in[w] = ~0ULL;
+  }
+
+  for ( int iter = 0; iter < _iter; ++iter ) {
+
+    // Grant phase: the free requesting input with the highest
+    // priority, the first from the pointer on a tie
+
+    for ( output = _out_occ.First( ); output >= 0; 
+	  output = _out_occ.Next( output ) ) {
+
+      if ( ( _outmatch[output] != -1 ) ||
+	   ( _outmask[output] != 0 ) ) {
+	continue;
+      }
+
+      const tWord *reqs = _OutRow( output );
+      offset  = _gptrs[output];
+      input   = _NextBit( reqs, _free_in, _in_words, offset );
+      wrapped = false;
+
+      max_index = -1;
+      max_pri   = 0;
+
+      for ( ; ; ) {
+	if ( input == -1 ) {
+	  if ( wrapped ) { break; }
+	  input   = _NextBit( reqs, _free_in, _in_words, 0 );
+	  wrapped = true;
+	  continue;
+	}
+	if ( wrapped && ( input >= offset ) ) {
+	  break;
+	}
+
+	int pri = _Request( input, output ).out_pri;
+	if ( ( pri > max_pri ) || ( max_index == -1 ) ) {
+	  max_pri   = pri;
+	  max_index = input;
+	}
+
+	input = _NextBit( reqs, _free_in, _in_words, input + 1 );
+      }
+
+      // as in SelAlloc, an output without a candidate keeps its grant
+      // from the previous iteration
+      if ( max_index != -1 ) {
+	_Grant( output, max_index );
+      }
+    }
+
+    // Accept phase: the granting output with the highest priority,
+    // the first from the pointer on a tie
+
+    for ( input = _in_occ.First( ); input >= 0; 
+	  input = _in_occ.Next( input ) ) {
+
+      const tWord *reqs  = _InRow( input );
+      const tWord *grant = _grant_bits + input*_out_words;
+      offset  = _aptrs[input];
+      output  = _NextBit( reqs, grant, _out_words, offset );
+      wrapped = false;
+
+      max_index = -1;
+      max_pri   = 0;
+
+      for ( ; ; ) {
+	if ( output == -1 ) {
+	  if ( wrapped ) { break; }
+	  output  = _NextBit( reqs, grant, _out_words, 0 );
+	  wrapped = true;
+	  continue;
+	}
+	if ( wrapped && ( output >= offset ) ) {
+	  break;
+	}
+
+	int pri = _Request( input, output ).in_pri;
+	if ( ( pri > max_pri ) || ( max_index == -1 ) ) {
+	  max_pri   = pri;
+	  max_index = output;
+	}
+
+	output = _NextBit( reqs, grant, _out_words, output + 1 );
+      }
+
+      if ( max_index != -1 ) {
+	// Accept
+	output = max_index;
+
+	_inmatch[input]   = output;
+	_outmatch[output] = input;
+	_free_in[input >> 6] &= ~( 1ULL << ( input & 63 ) );
+	
+	// Only update pointers if accepted during the 1st iteration
+	if ( iter == 0 ) {
+	  _gptrs[output] = ( input + 1 ) % _inputs;
+	  _aptrs[input]  = ( output + 1 ) % _outputs;
+	}
+      }
+    }
+  }
+}
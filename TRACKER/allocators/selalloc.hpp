@@ -48,4 +48,26 @@ public:
   void Allocate( );
 };
 
+// SelAlloc on a bit allocator: each grant and accept only visits the
+// requests that can still win, in the same round-robin order
+class DenseSelAlloc : public BitAllocator {
+  int _iter;
+
+  int *_grants;
+  int *_aptrs;
+  int *_gptrs;
+
+  tWord *_free_in;     // inputs not matched yet
+  tWord *_grant_bits;  // per input, the outputs granting it
+
+  void _Grant( int output, int input );
+
+public:
+  DenseSelAlloc( Module *parent, const string& name,
+		 int inputs, int outputs, int iters );
+  ~DenseSelAlloc( );
+
+  void Allocate( );
+};
+
 #endif 
@@ -174,3 +174,39 @@ void SeparableAllocator::PrintRequests( ostream * os ) const {
   }
   *os << "]." << endl;
 }
+
+DenseSeparableAllocator::DenseSeparableAllocator( Module* parent, const string& name,
+						  int inputs, int outputs,
+						  const string& arb_type )
+  : BitAllocator( parent, name, inputs, outputs )
+{
+  
+  _input_arb = new Arbiter*[inputs];
+  _output_arb = new Arbiter*[outputs];
+  
+  ostringstream arb_name;
+  
+  for (int i = 0; i < inputs; ++i) {
+    arb_name << "arb_i" << i;
+    _input_arb[i] = Arbiter::NewArbiter(this, arb_name.str(), arb_type, outputs);
+    arb_name.str("");
+  }
+  for (int i = 0; i < outputs; ++i) {
+    arb_name << "arb_o" << i;
+    _output_arb[i] = Arbiter::NewArbiter(this, arb_name.str( ), arb_type, inputs);
+    arb_name.str("");
+  }
+}
+
+DenseSeparableAllocator::~DenseSeparableAllocator() {
+
+  for (int i = 0; i < _inputs; ++i) {
+    delete _input_arb[i];
+  }
+  delete[] _input_arb ;
+
+  for (int i = 0; i < _outputs; ++i) {
+    delete _output_arb[i];
+  }
+  delete[] _output_arb ;
+}
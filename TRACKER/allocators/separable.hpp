@@ -75,4 +75,25 @@ public:
 
 } ;
 
+// The same arbiters fed from a bit allocator: one request per input and
+// output pair reaches each arbiter, the one it would have kept anyway,
+// and only inputs and outputs with requests are arbitrated
+class DenseSeparableAllocator : public BitAllocator {
+  
+protected:
+
+  Arbiter** _input_arb ;
+  Arbiter** _output_arb ;
+
+public:
+  
+  DenseSeparableAllocator( Module* parent, const string& name, int inputs,
+			   int outputs, const string& arb_type ) ;
+  
+  virtual ~DenseSeparableAllocator() ;
+
+  virtual void Allocate() = 0 ;
+
+} ;
+
 #endif
@@ -106,3 +106,43 @@ void SeparableInputFirstAllocator::Allocate() {
   in_event.clear();
   out_event.clear();
 }
+
+DenseSeparableInputFirstAllocator::
+DenseSeparableInputFirstAllocator( Module* parent, const string& name, int inputs,
+				   int outputs, const string& arb_type )
+  : DenseSeparableAllocator( parent, name, inputs, outputs, arb_type ),
+    _out_event( outputs )
+{}
+
+void DenseSeparableInputFirstAllocator::Allocate() {
+  
+  _ClearMatching() ;
+  
+  // Execute the input arbiters and propagate the grants to the
+  // output arbiters.
+  for ( int input = _in_occ.First(); input >= 0; input = _in_occ.Next( input ) ) {
+    const tWord *row = _InRow( input );
+    for ( int out = _NextBit( row, 0, _out_words, 0 ); out >= 0;
+	  out = _NextBit( row, 0, _out_words, out + 1 ) ) {
+      const sRequest& req = _Request( input, out );
+      _input_arb[input]->AddRequest( out, req.label, req.in_pri ) ;
+    }
+    int out = _input_arb[input]->Arbitrate( NULL, NULL );
+    const sRequest& req = _Request( input, out );
+    _output_arb[out]->AddRequest( input, req.label, req.out_pri );
+    _out_event.Set( out );
+  }
+
+  // Execute the output arbiters.
+  for ( int output = _out_event.First(); output >= 0; output = _out_event.Next( output ) ) {
+
+    int  input = _output_arb[output]->Arbitrate( NULL, NULL ) ;
+    assert( _inmatch[input] == -1 && _outmatch[output] == -1 ) ;
+    _inmatch[input]   = output ;
+    _outmatch[output] = input ;
+    _input_arb[input]->UpdateState() ;
+    _output_arb[output]->UpdateState() ;
+
+  }
+  _out_event.Clear();
+}
@@ -53,4 +53,16 @@ public:
 
 } ;
 
+class DenseSeparableInputFirstAllocator : public DenseSeparableAllocator {
+
+  BitSet _out_event;
+
+public:
+  
+  DenseSeparableInputFirstAllocator( Module* parent, const string& name, int inputs,
+				     int outputs, const string& arb_type ) ;
+  virtual void Allocate() ;
+
+} ;
+
 #endif
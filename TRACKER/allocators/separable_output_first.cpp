@@ -106,3 +106,46 @@ void SeparableOutputFirstAllocator::Allocate() {
     }
   }
 }
+
+DenseSeparableOutputFirstAllocator::
+DenseSeparableOutputFirstAllocator( Module* parent, const string& name, int inputs,
+				    int outputs, const string& arb_type )
+  : DenseSeparableAllocator( parent, name, inputs, outputs, arb_type ),
+    _in_event( inputs )
+{}
+
+void DenseSeparableOutputFirstAllocator::Allocate() {
+  
+  _ClearMatching() ;
+
+  // Add requests to the output arbiters, each at the highest output
+  // priority asked for by that input
+  for ( int output = _out_occ.First(); output >= 0; output = _out_occ.Next( output ) ) {
+    const tWord *row = _OutRow( output );
+    for ( int in = _NextBit( row, 0, _in_words, 0 ); in >= 0;
+	  in = _NextBit( row, 0, _in_words, in + 1 ) ) {
+      _output_arb[output]->AddRequest( in, _Request( in, output ).label,
+				       _top_pri[in*_outputs+output] );
+    }
+
+    // Execute the output arbiters and propagate the grants to the
+    // input arbiters.
+    int in = _output_arb[output]->Arbitrate( NULL, NULL ) ;
+    const sRequest& req = _Request( in, output );
+    _input_arb[in]->AddRequest( output, req.label, req.in_pri );
+    _in_event.Set( in );
+  }
+  
+  // Execute the input arbiters.
+  for ( int input = _in_event.First(); input >= 0; input = _in_event.Next( input ) ) {
+
+    int output = _input_arb[input]->Arbitrate( NULL, NULL ) ;
+  
+    assert( _inmatch[input] == -1 && _outmatch[output] == -1 ) ;
+    _inmatch[input]   = output ;
+    _outmatch[output] = input ;
+    _input_arb[input]->UpdateState() ;
+    _output_arb[output]->UpdateState() ;
+  }
+  _in_event.Clear();
+}
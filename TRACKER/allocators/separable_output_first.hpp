@@ -50,4 +50,17 @@ public:
 
 } ;
 
+class DenseSeparableOutputFirstAllocator : public DenseSeparableAllocator {
+
+  BitSet _in_event;
+
+public:
+  
+  DenseSeparableOutputFirstAllocator( Module* parent, const string& name, int inputs,
+				      int outputs, const string& arb_type ) ;
+  
+  virtual void Allocate() ;
+
+} ;
+
 #endif
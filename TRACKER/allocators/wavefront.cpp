@@ -136,4 +136,103 @@ void Wavefront::Allocate( )
   _pri = ( _pri + 1 ) % _square;
 }
 
+DenseWavefront::DenseWavefront( Module *parent, const string& name,
+				int inputs, int outputs ) :
+  BitAllocator( parent, name, inputs, outputs ),
+  _square((inputs > outputs) ? inputs : outputs),
+  _pri(0), _num_requests(0), _last_in(-1), _last_out(-1)
+{
+  _diag = new tWord [_square*_out_words];
+  for ( int k = 0; k < _square*_out_words; ++k ) {
+    _diag[k] = 0;
+  }
+  _free_out = new tWord [_out_words];
+}
+
+DenseWavefront::~DenseWavefront( )
+{
+  delete [] _diag;
+  delete [] _free_out;
+}
+
+void DenseWavefront::Clear( )
+{
+  for ( int in = _in_occ.First( ); in >= 0; in = _in_occ.Next( in ) ) {
+    const tWord *row = _InRow( in );
+    for ( int out = _NextBit( row, 0, _out_words, 0 ); out >= 0;
+	  out = _NextBit( row, 0, _out_words, out + 1 ) ) {
+      _Diag( in, out )[out >> 6] = 0;
+    }
+  }
+  BitAllocator::Clear( );
+}
+
+void DenseWavefront::AddRequest( int in, int out, int label, 
+				 int in_pri, int out_pri )
+{
+  // count unique requests, as Wavefront does
+  sRequest req;
+  bool overwrite = ReadRequest(req, in, out);
+  if(!overwrite || (req.in_pri < in_pri)) {
+    _num_requests++;
+    _last_in = in;
+    _last_out = out;
+  }
+  BitAllocator::AddRequest(in, out, label, in_pri, out_pri);
+  if ( label >= 0 ) {
+    _Diag( in, out )[out >> 6] |= 1ULL << ( out & 63 );
+  }
+}
+
+void DenseWavefront::RemoveRequest( int in, int out, int label )
+{
+  BitAllocator::RemoveRequest(in, out, label);
+  _Diag( in, out )[out >> 6] &= ~( 1ULL << ( out & 63 ) );
+}
+
+void DenseWavefront::Allocate( )
+{
+  _ClearMatching( );
+
+  if(_num_requests == 0)
 
+    // bypass allocator completely if there were no requests
+    return;
+  
+  if(_num_requests == 1) {
+
+    // if we only had a single request, we can immediately grant it
+    _inmatch[_last_in] = _last_out;
+    _outmatch[_last_out] = _last_in;
+    
+  } else {
+
+    // the upward diagonals from the priority one on; the inputs and
+    // outputs on a diagonal are all distinct, so only the free inputs
+    // need checking once the free outputs are masked in
+    for ( int w = 0; w < _out_words; ++w ) {
+      _free_out[w] = ~0ULL;
+    }
+    for ( int p = 0; p < _square; ++p ) {
+      int diag = ( _pri + p ) % _square;
+      const tWord *reqs = _diag + diag*_out_words;
+      for ( int output = _NextBit( reqs, _free_out, _out_words, 0 ); output >= 0;
+	    output = _NextBit( reqs, _free_out, _out_words, output + 1 ) ) {
+	int input = ( diag - output + _square ) % _square;
+	if ( _inmatch[input] == -1 ) {
+	  // Grant!
+	  _inmatch[input] = output;
+	  _outmatch[output] = input;
+	  _free_out[output >> 6] &= ~( 1ULL << ( output & 63 ) );
+	}
+      }
+    }
+  }
+  
+  _num_requests = 0;
+  _last_in = -1;
+  _last_out = -1;
+  
+  // Round-robin the priority diagonal
+  _pri = ( _pri + 1 ) % _square;
+}
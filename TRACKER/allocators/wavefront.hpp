@@ -49,4 +49,34 @@ public:
   void Allocate( );
 };
 
+// Wavefront on a bit allocator that also keeps each diagonal of the
+// request matrix as a row of bits by output, so a whole diagonal is
+// matched against the free outputs at once
+class DenseWavefront : public BitAllocator {
+  int _square;
+  int _pri;
+  int _num_requests;
+  int _last_in;
+  int _last_out;
+
+  tWord *_diag;      // [(in+out)%_square], bit out
+  tWord *_free_out;  // outputs not matched yet
+
+  tWord *_Diag( int in, int out ) const
+  {
+    return _diag + ( ( in + out ) % _square )*_out_words;
+  }
+
+public:
+  DenseWavefront( Module *parent, const string& name,
+		  int inputs, int outputs );
+  ~DenseWavefront( );
+  
+  void Clear( );
+  void AddRequest( int in, int out, int label = 1, 
+		   int in_pri = 0, int out_pri = 0 );
+  void RemoveRequest( int in, int out, int label = 1 );
+  void Allocate( );
+};
+
 #endif
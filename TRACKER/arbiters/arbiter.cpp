@@ -80,6 +80,10 @@ Arbiter *Arbiter::NewArbiter( Module *parent, const string& name,
     a = new RoundRobinArbiter( parent, name, size );
   } else if(arb_type == "matrix") {
     a = new MatrixArbiter( parent, name, size );
+  } else if(arb_type == "dense_round_robin") {
+    a = new DenseRoundRobinArbiter( parent, name, size );
+  } else if(arb_type == "dense_matrix") {
+    a = new DenseMatrixArbiter( parent, name, size );
   } else assert(false);
   return a;
 }
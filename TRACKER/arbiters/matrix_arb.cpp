@@ -133,3 +133,102 @@ int MatrixArbiter::Arbitrate( int* id, int* pri ) {
 
   return _selected ;
 }
+
+// starts from the order MatrixArbiter sets up: each input ahead of the
+// ones below it, and the last input behind all of them
+DenseMatrixArbiter::DenseMatrixArbiter( Module *parent, const string &name, int size )
+  : Arbiter( parent, name, size ), _beaten_by( size, BitSet( size ) ),
+    _valid( size ), _top( size ) {
+  for ( int c = 0 ; c < size ; c++ ) {
+    for ( int r = 0 ; r < size ; r++ ) {
+      if ( ( r == size-1 ) || ( c == r ) )
+	continue ;
+      if ( ( c == size-1 ) || ( r > c ) )
+	_beaten_by[c].Set( r ) ;
+    }
+  }
+}
+
+void DenseMatrixArbiter::PrintState() const  {
+  cout << "Priority Matrix: " << endl ;
+  for ( int r = 0; r < _input_size ; r++ ) {
+    for ( int c = 0 ; c < _input_size ; c++ ) {
+      cout << _beaten_by[c].Test( r ) << " " ;
+    }
+    cout << endl ;
+  }
+  cout << endl ;
+}
+
+void DenseMatrixArbiter::UpdateState() {
+  // update priority matrix using last grant
+  if ( _selected > -1 ) {
+    for ( int i = 0; i < _input_size ; i++ ) {
+      _beaten_by[i].Reset( _selected ) ;
+    }
+    _beaten_by[_selected].Fill( ) ;
+    _beaten_by[_selected].Reset( _selected ) ;
+  }
+}
+
+void DenseMatrixArbiter::AddRequest( int input, int id, int pri )
+{
+  assert( 0 <= input && input < _input_size ) ;
+  bool valid = _valid.Test( input );
+  if(!valid || (_request[input].pri < pri)) {
+    _last_req = input ;
+    if(!valid) {
+      _num_reqs++ ;
+      _valid.Set( input );
+    }
+    _request[input].id = id ;
+    _request[input].pri = pri ;
+    if(_top.Empty() || (_highest_pri<pri)){
+      _highest_pri = pri;
+      _top.Clear();
+      _top.Set( input );
+    } else if(_highest_pri==pri){
+      _top.Set( input );
+    }
+  }
+}
+
+int DenseMatrixArbiter::Arbitrate( int* id, int* pri ) {
+  
+  // avoid running arbiter if it has not recevied at least two requests
+  // (in this case, requests and grants are identical)
+  if ( _num_reqs < 2 ) {
+    
+    _selected = _last_req ;
+    
+  } else {
+    
+    // only a request at the highest priority can win, and then only
+    // if no other one there beats it
+    _selected = -1 ;
+    for ( int input = _top.First( ); input >= 0; input = _top.Next( input ) ) {
+      if ( !_beaten_by[input].Intersects( _top ) ) {
+	_selected = input ;
+	break ;
+      }
+    }
+  }
+    
+  if ( _selected != -1 ) {
+    if ( id )
+      *id  = _request[_selected].id ;
+    if ( pri )
+      *pri = _request[_selected].pri ;
+
+    // clear the request vector
+    _valid.Clear( );
+    _top.Clear( );
+    _num_reqs = 0 ;
+    _last_req = -1 ;
+  } else {
+    assert(_num_reqs == 0);
+    assert(_last_req == -1);
+  }
+
+  return _selected ;
+}
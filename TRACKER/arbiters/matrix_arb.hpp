@@ -38,6 +38,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define _MATRIX_ARB_HPP_
 
 #include "arbiter.hpp"
+#include "bitset.hpp"
+
+#include <vector>
 
 #include <iostream>
 using namespace std ;
@@ -66,4 +69,32 @@ public:
 
 } ;
 
+// The same priority matrix kept as one bit set per column, the inputs
+// that beat it. A grant moves the winner below everyone, which is one
+// filled column and one bit cleared in each of the others.
+class DenseMatrixArbiter : public Arbiter {
+
+  vector<BitSet> _beaten_by ;
+
+  BitSet _valid ;
+  BitSet _top ;   // valid requests at _highest_pri
+
+public:
+
+  // Constructors
+  DenseMatrixArbiter( Module *parent, const string &name, int size ) ;
+
+  // Print priority matrix to standard output
+  virtual void PrintState() const ;
+  
+  // Update priority matrix based on last aribtration result
+  virtual void UpdateState() ; 
+
+  // Arbitrate amongst requests. Returns winning input and 
+  // updates pointers to metadata when valid pointers are passed
+  virtual int Arbitrate( int* id = 0, int* pri = 0) ;
+
+  virtual void AddRequest( int input, int id, int pri ) ;
+} ;
+
 #endif
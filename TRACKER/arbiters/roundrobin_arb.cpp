@@ -101,3 +101,65 @@ int RoundRobinArbiter::Arbitrate( int* id, int* pri ) {
   
   return _selected ;
 }
+
+DenseRoundRobinArbiter::DenseRoundRobinArbiter( Module *parent, const string &name,
+						int size ) 
+  : Arbiter( parent, name, size ), _pointer( 0 ), _valid( size ), _top( size ) {
+}
+
+void DenseRoundRobinArbiter::PrintState() const  {
+  cout << "Round Robin Priority Pointer: " << endl ;
+  cout << "  _pointer = " << _pointer << endl ;
+}
+
+void DenseRoundRobinArbiter::UpdateState() {
+  // update priority matrix using last grant
+  if ( _selected > -1 ) 
+    _pointer = _selected ;
+}
+
+void DenseRoundRobinArbiter::AddRequest( int input, int id, int pri )
+{
+  assert( 0 <= input && input < _input_size ) ;
+  bool valid = _valid.Test( input );
+  if(!valid || (_request[input].pri < pri)) {
+    if(!valid) {
+      _num_reqs++ ;
+      _valid.Set( input );
+    }
+    _request[input].id = id ;
+    _request[input].pri = pri ;
+    if(_highest_pri<pri){
+      _highest_pri = pri;
+      _top.Clear();
+      _top.Set( input );
+    } else if(_highest_pri==pri){
+      _top.Set( input );
+    }
+  }
+}
+
+int DenseRoundRobinArbiter::Arbitrate( int* id, int* pri ) {
+  
+  // the first top request after the pointer, the pointer itself last
+  _selected = _top.Next( _pointer );
+  if ( _selected < 0 )
+    _selected = _top.First( );
+  
+  if ( _selected > -1 ) {
+    if ( id ) 
+      *id = _request[_selected].id ;
+    if ( pri ) 
+      *pri = _request[_selected].pri ;
+    
+    // clear the request vector
+    _valid.Clear( );
+    _top.Clear( );
+    _num_reqs = 0 ;
+    _highest_pri = numeric_limits<int>::min();
+  } else {
+    assert(_num_reqs == 0);
+  }
+  
+  return _selected ;
+}
@@ -38,6 +38,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define _ROUNDROBIN_HPP_
 
 #include "arbiter.hpp"
+#include "bitset.hpp"
 
 class RoundRobinArbiter : public Arbiter {
 
@@ -62,4 +63,32 @@ public:
   virtual void AddRequest( int input, int id, int pri ) ;
 } ;
 
+// The same grants from bit masks: the requests at the highest priority
+// are kept in a mask and the winner is the first of them after the
+// pointer, found with count-trailing-zeros
+class DenseRoundRobinArbiter : public Arbiter {
+
+  int  _pointer ;
+
+  BitSet _valid ;
+  BitSet _top ;   // valid requests at _highest_pri
+
+public:
+
+  // Constructors
+  DenseRoundRobinArbiter( Module *parent, const string &name, int size ) ;
+
+  // Print priority matrix to standard output
+  virtual void PrintState() const ;
+  
+  // Update priority matrix based on last aribtration result
+  virtual void UpdateState() ; 
+
+  // Arbitrate amongst requests. Returns winning input and 
+  // updates pointers to metadata when valid pointers are passed
+  virtual int Arbitrate( int* id = 0, int* pri = 0) ;
+
+  virtual void AddRequest( int input, int id, int pri ) ;
+} ;
+
 #endif
@@ -0,0 +1,143 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _BITSET_HPP_
+#define _BITSET_HPP_
+
+#include <vector>
+#include <assert.h>
+
+using namespace std;
+
+// Set of small non-negative ints in 64-bit words, walked in increasing
+// order with count-trailing-zeros:
+//   for ( int i = s.First( ); i >= 0; i = s.Next( i ) )
+class BitSet {
+  vector<unsigned long long> _words;
+  int _size;
+  int _count;
+
+public:
+  BitSet( int size = 0 ) { Resize( size ); }
+
+  // empties the set and makes room for 0..size-1
+  void Resize( int size )
+  {
+    _size  = size;
+    _count = 0;
+    _words.assign( ( size + 63 ) >> 6, 0ULL );
+  }
+
+  void Clear( )
+  {
+    _words.assign( _words.size( ), 0ULL );
+    _count = 0;
+  }
+
+  void Set( int i )
+  {
+    assert( ( i >= 0 ) && ( i < _size ) );
+    unsigned long long bit = 1ULL << ( i & 63 );
+    unsigned long long &w  = _words[i >> 6];
+    if ( !( w & bit ) ) {
+      w |= bit;
+      ++_count;
+    }
+  }
+
+  void Reset( int i )
+  {
+    assert( ( i >= 0 ) && ( i < _size ) );
+    unsigned long long bit = 1ULL << ( i & 63 );
+    unsigned long long &w  = _words[i >> 6];
+    if ( w & bit ) {
+      w &= ~bit;
+      --_count;
+    }
+  }
+
+  // every int in 0..size-1
+  void Fill( )
+  {
+    for ( size_t w = 0; w < _words.size( ); ++w ) {
+      _words[w] = ~0ULL;
+    }
+    if ( _size & 63 ) {
+      _words.back( ) = ( 1ULL << ( _size & 63 ) ) - 1;
+    }
+    _count = _size;
+  }
+
+  bool Test( int i ) const
+  {
+    assert( ( i >= 0 ) && ( i < _size ) );
+    return ( _words[i >> 6] >> ( i & 63 ) ) & 1ULL;
+  }
+
+  // any member in common with a set of the same size
+  bool Intersects( const BitSet &s ) const
+  {
+    for ( size_t w = 0; w < _words.size( ); ++w ) {
+      if ( _words[w] & s._words[w] ) {
+	return true;
+      }
+    }
+    return false;
+  }
+
+  int  Count( ) const { return _count; }
+  bool Empty( ) const { return _count == 0; }
+
+  // smallest member, -1 if empty
+  int First( ) const { return _count ? _From( 0 ) : -1; }
+
+  // smallest member above i, -1 if none
+  int Next( int i ) const { return _From( i + 1 ); }
+
+private:
+  int _From( int i ) const
+  {
+    int n = (int)_words.size( );
+    int w = i >> 6;
+    if ( w >= n ) {
+      return -1;
+    }
+    unsigned long long bits = _words[w] & ( ~0ULL << ( i & 63 ) );
+    while ( !bits ) {
+      if ( ++w >= n ) {
+	return -1;
+      }
+      bits = _words[w];
+    }
+    return ( w << 6 ) + __builtin_ctzll( bits );
+  }
+};
+
+#endif
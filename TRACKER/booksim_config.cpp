@@ -87,6 +87,14 @@ BookSimConfig::BookSimConfig( )            // initilaize all values. can be over
   _int_map["n"] = 2; //network dimension
   _int_map["c"] = 1; //concentration
   AddStrField( "routing_function", "none" );
+  AddStrField( "route_table", "xy" ); //route builder or routing function rajagiri routes are compiled from
+  AddStrField( "route_table_file", "" ); //load the route table from here, or save it if missing
+  _int_map["route_candidates"] = 1; //paths kept per pair when route_table is a routing function
+  _int_map["route_vc_classes"] = 1; //VC classes carried per hop, 2 for torus datelines
+  AddStrField( "path_selection", "first" ); //first, congestion, round_robin, flow_hash or weighted, see pathselect.hpp
+  AddStrField( "path_congestion_metric", "nof" ); //nof, nop, tracker or fluidity
+  _int_map["path_congestion_period"] = 16; //cycles between congestion snapshots
+  AddStrField( "selection_function", "fluidity" ); //output selection strategy of the iq router, see iq_router_baseline.cpp
   _int_map["use_noc_latency"] = 1;
 
   //not critical
@@ -142,6 +150,7 @@ BookSimConfig::BookSimConfig( )            // initilaize all values. can be over
   _int_map["output_speedup"]    = 1;  // expansion of output ports into crossbar
 
   _int_map["routing_delay"]    = 0;  
+  _int_map["lookahead_routing"] = 0; // source routed flits decode their next hop on buffer write and skip the routing stage
   _int_map["vc_alloc_delay"]   = 0;  
   _int_map["sw_alloc_delay"]   = 0;  
   _int_map["st_prepare_delay"] = 0;
@@ -237,6 +246,11 @@ _float_map["warmup_thres"] = 0.05;//added by KVM
   _float_map["acc_stopping_thres"] = 0.05;
 
   _int_map["sim_count"]     = 1;   // number of simulations to perform
+  _int_map["router_threads"] = 0;  // threads stepping the routers, 0 steps them serially (see parallelstep.hpp)
+  _int_map["skip_idle_routers"] = 0; // step only routers with flits or credits to handle, same results
+  _int_map["event_driven"] = 0;    // skip_idle_routers with time-stamped channels and a wake-up wheel, same results
+  _int_map["subnet_threads"] = 0;  // threads stepping the physical subnetworks, 0 steps them serially
+  _int_map["sweep_threads"] = 0;   // concurrent points of a "field = {...};" sweep, 0 uses every core (see sweep.hpp)
 
 
   _int_map["include_queuing"] =1; // non-zero includes source queuing latency
@@ -252,6 +266,7 @@ _float_map["warmup_thres"] = 0.05;//added by KVM
 
   _int_map["print_csv_results"] = 0; 
   _int_map["print_vc_stats"] =0;  
+  _int_map["print_flit_arena"] = 0; // report the peak number of flits in use
 
   _int_map["drain_measured_only"] = 0;
 
@@ -122,7 +122,7 @@ BufferState::~BufferState( )
 void BufferState::ProcessCredit( Credit *c )
 {
   assert( c );
-//fp<<"in process credit"<<endl;
+//gSim->Trace( )<<"in process credit"<<endl;
   for ( int v = 0; v < c->vc_cnt; ++v ) {
     assert( ( c->vc[v] >= 0 ) && ( c->vc[v] < _vcs ) );
 
@@ -40,10 +40,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef CHANNEL_HPP
 #define CHANNEL_HPP
 
-#include <queue>
+#include <assert.h>
+
+#include "ring.hpp"
 
 using namespace std;
 
+// told about everything sent down a channel, see Router::Sleep
+class ChannelListener {
+public:
+  virtual ~ChannelListener( ) { }
+  // due is the cycle the data can be received in, 0 on untimed channels
+  virtual void Arriving( int due ) = 0;
+};
+
 template<class T>
 class Channel {
 public:
@@ -62,14 +72,30 @@ public:
   // Peek at data
   T* Peek( );
 
+  // told on every non-null Send
+  void SetListener( ChannelListener *listener ) { _listener = listener; }
+  bool InFlight( ) const { return _in_flight > 0; }
+
+  // time the channel by the clocks of its two ends instead of keeping a
+  // slot per cycle: null sends are dropped and data is held until due,
+  // so either end may skip cycles (see Network::SetEventDriven)
+  void SetClock( const int *send_clock, const int *receive_clock );
+
 protected:
   int       _delay;
-  queue<T*> _queue;
+  Ring<T*>  _queue;  // sized for the latency, see SetLatency
+
+  ChannelListener *_listener;
+  int              _in_flight;  // non-null entries in _queue
+
+  const int       *_send_clock;  // 0 when untimed
+  const int       *_receive_clock;
+  Ring<int>        _due;          // receive cycle of each entry when timed
 
 };
 
 template<class T>
-Channel<T>::Channel( int cycles ) {
+Channel<T>::Channel( int cycles ) : _listener( 0 ), _in_flight( 0 ), _send_clock( 0 ), _receive_clock( 0 ) {
   SetLatency(cycles);
 }
 
@@ -77,40 +103,78 @@ template<class T>
 void Channel<T>::SetLatency( int cycles ) {
 
   _delay = cycles ;
-  while ( !_queue.empty() )
-    _queue.pop( );
+  // one slot per cycle of latency, plus the one sent ahead of a receive
+  _queue.Reserve( _delay + 2 );
+  _due.Reserve( _delay + 2 );
+  _in_flight = 0;
+  if ( _send_clock )
+    return;
   for (int i = 0; i < _delay; i++)
-    _queue.push(0);
+    _queue.Push(0);
 }
 
 template<class T>
-void Channel<T>::Send( T* data ) {
+void Channel<T>::SetClock( const int *send_clock, const int *receive_clock ) {
 
-  while ( (_queue.size() > (unsigned int)_delay) && (_queue.front() == 0) )
-    _queue.pop( );
+  assert( _in_flight == 0 );
+  _queue.Clear( );
+  _send_clock    = send_clock;
+  _receive_clock = receive_clock;
+}
 
-  _queue.push(data);
+template<class T>
+void Channel<T>::Send( T* data ) {
+
+  if ( _send_clock ) {
+    if ( data ) {
+      int due = *_send_clock + _delay;
+      _queue.Push(data);
+      _due.Push(due);
+      ++_in_flight;
+      if ( _listener )
+	_listener->Arriving( due );
+    }
+    return;
+  }
+
+  while ( (_queue.Size() > _delay) && (_queue.Front() == 0) )
+    _queue.Pop( );
+
+  _queue.Push(data);
+  if ( data ) {
+    ++_in_flight;
+    if ( _listener )
+      _listener->Arriving( 0 );
+  }
 
 }
 
 template<class T>
 T* Channel<T>::Receive() {
 
-  if ( _queue.empty( ) )
+  if ( _queue.Empty( ) )
+    return 0;
+  if ( _receive_clock && ( _due.Front( ) > *_receive_clock ) )
     return 0;
 
-  T* data = _queue.front();
-  _queue.pop();
+  T* data = _queue.Front();
+  _queue.Pop();
+  if ( _receive_clock )
+    _due.Pop();
+  if ( data )
+    --_in_flight;
   return data;
 }
 
 template<class T>
 T* Channel<T>::Peek( ) 
 {
-  if ( _queue.empty() )
+  if ( _queue.Empty() )
+    return 0;
+  if ( _receive_clock && ( _due.Front( ) > *_receive_clock ) )
     return 0;
 
-  return _queue.front( );
+  return _queue.Front( );
 }
 
 #endif
@@ -39,6 +39,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sstream>
 #include <fstream>
 #include <cstdlib>
+#include <iomanip>
 
 #include "config_utils.hpp"
 
@@ -49,7 +50,32 @@ ifstream lfp;
 Configuration::Configuration( )
 {
 	  theConfig = this;
-	  _config_file = 0;
+}
+
+// a copy owns its strings and does not become the parser's target
+Configuration::Configuration( const Configuration &config ) :
+  _sweeps( config._sweeps ),
+  _int_map( config._int_map ),
+  _float_map( config._float_map )
+{
+	  for ( map<string,char *>::const_iterator i = config._str_map.begin( );
+		i != config._str_map.end( ); ++i )
+	  {
+		    _str_map[i->first] = strdup( i->second );
+	  }
+}
+
+Configuration::~Configuration( )
+{
+	  for ( map<string,char *>::iterator i = _str_map.begin( );
+		i != _str_map.end( ); ++i )
+	  {
+		    free( i->second );
+	  }
+	  if ( theConfig == this )
+	  {
+		    theConfig = 0;
+	  }
 }
 
 void Configuration::AddStrField( const string &field, const string &value )
@@ -70,6 +96,7 @@ void Configuration::Assign( const string &field, const string &value ) // for st
 	  {
 		    free( _str_map[field] );
 		    _str_map[field] = strdup( value.c_str( ) );
+		    _DropSweep( field );
 		   cout<<"param"<<zz++<<" S "<<field<<" = "<<_str_map[field]<<endl;// added John
 	  } 
 	  else
@@ -90,6 +117,7 @@ void Configuration::Assign( const string &field, unsigned int value )  // for in
 	  if ( match != _int_map.end( ) ) 
 	 {
 	   	 _int_map[field] = value;
+		 _DropSweep( field );
 			cout<<"param"<<zz++<<" I  "<<field<<" = "<<_int_map[field]<<endl;// added John
 	 }
 	 else
@@ -109,6 +137,7 @@ void Configuration::Assign( const string &field, double value )  // for double
 	  if ( match != _float_map.end( ) )
 	  {
 	   	 _float_map[field] = value;
+		_DropSweep( field );
 		cout<<"param"<<zz++<<" F  "<<field<<" = "<<_float_map[field]<<endl;// added John
 	  }
 	 else
@@ -120,6 +149,34 @@ void Configuration::Assign( const string &field, double value )  // for double
 	 }
 }
 
+void Configuration::AssignText( const string &field, const string &value )
+{
+	  char *end;
+
+	  if ( _int_map.count( field ) )
+	  {
+		    unsigned int v = strtoul( value.c_str( ), &end, 10 );
+		    if ( *end || value.empty( ) )
+		    {
+			      ParseError( "Bad int value '" + value + "' for " + field, 0 );
+		    }
+		    Assign( field, v );
+	  }
+	  else if ( _float_map.count( field ) )
+	  {
+		    double v = strtod( value.c_str( ), &end );
+		    if ( *end || value.empty( ) )
+		    {
+			      ParseError( "Bad double value '" + value + "' for " + field, 0 );
+		    }
+		    Assign( field, v );
+	  }
+	  else
+	  {
+		    Assign( field, value );
+	  }
+}
+
 void Configuration::GetStr( const string &field, string &value, const string &def ) const
 {
 	 map<string,char *>::const_iterator match;
@@ -168,16 +225,16 @@ double Configuration::GetFloat( const string &field, double def ) const
 
 void Configuration::ParseFile( const string& filename )
 {
-	  if ( ( _config_file = fopen( filename.c_str( ), "r" ) ) == 0 )  // if config file couldnot be opened, show error
+	  ifstream in( filename.c_str( ) );
+	  if ( !in )  // if config file couldnot be opened, show error
 	 {
 		cerr << "Could not open configuration file " << filename << endl;
 		exit( -1 );
 	  }
 
-	  configparse( );
-
-	  fclose( _config_file );
-	  _config_file = 0;
+	  ostringstream text;
+	  text << in.rdbuf( );
+	  _Parse( text.str( ) );
 }
 void parse_load_file(const string& filename)
 {
@@ -190,26 +247,173 @@ void parse_load_file(const string& filename)
 
 void Configuration::ParseString( const string& str )
 {
-	  _config_string = str + ';';
-	  configparse( );
+	  _Parse( str + ';' );
+}
+
+void Configuration::_Parse( const string &text )
+{
+	  vector< pair<string, string> > sweeps;
+
+	  _config_string = _ExtractSweeps( text, &sweeps );
+
+	  // the grammar needs at least one command, and a line holding only a
+	  // sweep has none left
+	  if ( _config_string.find_first_not_of( " \t\r\n" ) != string::npos )
+	  {
+		    configparse( );
+	  }
 	  _config_string = "";
+
+	  // after the plain assignments, so within one text the sweep wins
+	  for ( size_t i = 0; i < sweeps.size( ); ++i )
+	  {
+		    _AddSweep( sweeps[i].first, sweeps[i].second );
+	  }
 }
 
-int Configuration::Input( char *line, int max_size )
+// Sweeps ("injection_rate = {0.1:0.55:0.01};", "traffic = {uniform, tornado};")
+// are not part of the grammar: they are collected here and blanked out of the
+// text, keeping newlines so parse errors still report the right line.
+string Configuration::_ExtractSweeps( const string &text, vector< pair<string, string> > *sweeps )
 {
-	  int length = 0;
+	  const char *space = " \t\r\n";
+	  const char *name  = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_-/.+";
+	  string out( text );
+	  size_t pos = 0;
 
-	  if ( _config_file )
+	  while ( pos < out.size( ) )
 	  {
-	  	   length = fread( line, 1, max_size, _config_file );
-	  } 
-	  else
+		    if ( out.compare( pos, 2, "//" ) == 0 )
+		    {
+			      pos = out.find( '\n', pos );
+			      continue;
+		    }
+		    if ( out[pos] != '{' )
+		    {
+			      ++pos;
+			      continue;
+		    }
+
+		    size_t eq = pos ? out.find_last_not_of( space, pos - 1 ) : string::npos;
+		    size_t name_end = ( eq != string::npos && eq > 0 ) ?
+		      out.find_last_not_of( space, eq - 1 ) : string::npos;
+		    if ( eq == string::npos || out[eq] != '=' || name_end == string::npos ||
+			 !strchr( name, out[name_end] ) )
+		    {
+			      ParseError( "Sweep list without a field name", 0 );
+		    }
+		    size_t name_start = out.find_last_not_of( name, name_end );
+		    name_start = ( name_start == string::npos ) ? 0 : name_start + 1;
+
+		    size_t close = out.find( '}', pos );
+		    if ( close == string::npos )
+		    {
+			      ParseError( "Unterminated sweep list", 0 );
+		    }
+		    size_t end = out.find_first_not_of( space, close + 1 );
+		    if ( end == string::npos || out[end] != ';' )
+		    {
+			      ParseError( "Missing ';' after sweep list", 0 );
+		    }
+
+		    sweeps->push_back( make_pair( out.substr( name_start, name_end + 1 - name_start ),
+						  out.substr( pos + 1, close - pos - 1 ) ) );
+
+		    for ( size_t i = name_start; i <= end; ++i )
+		    {
+			      if ( out[i] != '\n' )
+			      {
+					out[i] = ' ';
+			      }
+		    }
+		    pos = end + 1;
+	  }
+	  return out;
+}
+
+// values: comma separated items, each a value or an inclusive
+// start:stop[:step] range
+void Configuration::_AddSweep( const string &field, const string &values )
+{
+	  vector<string> points;
+	  istringstream items( values );
+	  string item;
+
+	  while ( getline( items, item, ',' ) )
 	  {
-		    length = _config_string.length();
-		    _config_string.copy(line, max_size);
-		    _config_string.clear();
+		    size_t first = item.find_first_not_of( " \t\r\n" );
+		    if ( first == string::npos )
+		    {
+			      continue;
+		    }
+		    item = item.substr( first, item.find_last_not_of( " \t\r\n" ) + 1 - first );
+
+		    if ( item.find( ':' ) == string::npos )
+		    {
+			      points.push_back( item );
+			      continue;
+		    }
+
+		    double range[3] = { 0.0, 0.0, 1.0 };
+		    istringstream parts( item );
+		    string part;
+		    int n = 0;
+		    while ( getline( parts, part, ':' ) )
+		    {
+			      char *end;
+			      if ( n < 3 )
+			      {
+					range[n] = strtod( part.c_str( ), &end );
+			      }
+			      if ( n >= 3 || end == part.c_str( ) )
+			      {
+					n = 0;
+					break;
+			      }
+			      ++n;
+		    }
+		    if ( n < 2 || range[2] <= 0.0 || range[1] < range[0] )
+		    {
+			      ParseError( "Bad sweep range '" + item + "' for " + field, 0 );
+		    }
+
+		    // computed from the start each time so 0.1 + 4 * 0.01 prints as 0.14
+		    int steps = int( ( range[1] - range[0] ) / range[2] + 1e-6 );
+		    for ( int i = 0; i <= steps; ++i )
+		    {
+			      ostringstream v;
+			      v << setprecision( 10 ) << range[0] + i * range[2];
+			      points.push_back( v.str( ) );
+		    }
 	  }
 
+	  if ( points.empty( ) )
+	  {
+		    ParseError( "Empty sweep list for " + field, 0 );
+	  }
+
+	  _DropSweep( field );
+	  _sweeps.push_back( make_pair( field, points ) );
+}
+
+// a later plain assignment overrides an earlier sweep of the same field
+void Configuration::_DropSweep( const string &field )
+{
+	  for ( size_t i = 0; i < _sweeps.size( ); ++i )
+	  {
+		    if ( _sweeps[i].first == field )
+		    {
+			      _sweeps.erase( _sweeps.begin( ) + i );
+			      return;
+		    }
+	  }
+}
+
+int Configuration::Input( char *line, int max_size )
+{
+	  int length = _config_string.copy( line, max_size );
+
+	  _config_string.erase( 0, length );
 	  return length;
 }
 
@@ -39,9 +39,16 @@ extern int configparse( );
 
 class Configuration {
   static Configuration *theConfig;
-  FILE *_config_file;
   string _config_string;
 
+  // swept parameters ("field = {a:b:step, x, y};"), in the order given
+  vector< pair<string, vector<string> > > _sweeps;
+
+  string _ExtractSweeps( const string &text, vector< pair<string, string> > *sweeps );
+  void _AddSweep( const string &field, const string &values );
+  void _DropSweep( const string &field );
+  void _Parse( const string &text );
+
 protected:
   map<string,char *>       _str_map;
   map<string,unsigned int> _int_map;
@@ -49,6 +56,8 @@ protected:
   
 public:
   Configuration( );
+  Configuration( const Configuration &config );
+  virtual ~Configuration( );
 
   void AddStrField( const string &field, const string &value );
 
@@ -56,6 +65,9 @@ public:
   void Assign( const string &field, unsigned int value );
   void Assign( const string &field, double value );
 
+  // assign a value given as text to whichever type the field has
+  void AssignText( const string &field, const string &value );
+
   void GetStr( const string &field, string &value, const string &def = "" ) const;  //constant function
   unsigned int GetInt( const string &field, unsigned int def = 0 ) const;
   double GetFloat( const string &field, double def = 0.0 ) const;
@@ -67,6 +79,10 @@ public:
   
   void WriteFile( const string& filename);
 
+  const vector< pair<string, vector<string> > > &GetSweeps( ) const {
+    return _sweeps;
+  }
+
   //These Get functions are for the GUI to display all the options of booksim
   //const something maybe?
   map<string,char *> * GetStrMap(){
@@ -36,17 +36,58 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "booksim.hpp"
 #include "credit.hpp"
 
-Credit::Credit( int max_vcs )
+#include <new>
+
+// credits per slab
+#define CREDIT_SLAB 256
+
+Credit::Credit( )
 {
-  vc = new int [max_vcs];
+  vc = 0;
   vc_cnt = 0;
 
+  head = false;
   tail = false;
   id   = -1;
   dest_router = -1;
 }
 
-Credit::~Credit( )
+CreditPool::CreditPool( int vcs ) : _vcs( vcs )
+{
+  size_t align = sizeof( void * );
+  _slot = ( sizeof( Credit ) + vcs * sizeof( int ) + align - 1 ) / align * align;
+}
+
+// only the own slabs; credits of other pools on the free list stay theirs
+CreditPool::~CreditPool( )
+{
+  for ( size_t s = 0; s < _slabs.size( ); ++s ) {
+    delete [] _slabs[s];
+  }
+}
+
+void CreditPool::_Grow( )
+{
+  char *slab = new char [_slot * CREDIT_SLAB];
+  _slabs.push_back( slab );
+  for ( int i = CREDIT_SLAB - 1; i >= 0; --i ) {
+    Credit *c = new ( slab + i * _slot ) Credit;
+    c->vc = reinterpret_cast<int *>( c + 1 );
+    _free.push_back( c );
+  }
+}
+
+Credit *CreditPool::New( )
 {
-  delete [] vc;
+  if ( _free.empty( ) ) {
+    _Grow( );
+  }
+  Credit *c = _free.back( );
+  _free.pop_back( );
+  c->vc_cnt = 0;
+  c->head = false;
+  c->tail = false;
+  c->id = -1;
+  c->dest_router = -1;
+  return c;
 }
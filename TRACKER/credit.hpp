@@ -31,10 +31,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef _CREDIT_HPP_
 #define _CREDIT_HPP_
 
+#include <vector>
+
+using namespace std;
+
+// credits come from a CreditPool, which keeps the vc array inline
 class Credit {
 public:
-  Credit( int max_vcs = 1 );
-  ~Credit( );
+  Credit( );
 
   int  *vc;
   int  vc_cnt;
@@ -44,4 +48,27 @@ public:
   int dest_router;
 };
 
+// Recycles credits with room for up to vcs VCs each. A credit may be
+// freed into any pool of the same simulation, normally that of the
+// router or traffic manager that consumed it; since every pool is only
+// used by its owner, routers stepped on different threads need no locks,
+// and as much is sent as received, no pool keeps growing.
+class CreditPool {
+  int    _vcs;
+  size_t _slot;           // a credit and its vc array
+  vector<char *>   _slabs;
+  vector<Credit *> _free;
+
+  void _Grow( );
+
+public:
+  CreditPool( int vcs );
+  ~CreditPool( );
+
+  int Capacity( ) const { return _vcs; }
+
+  Credit *New( );
+  void    Free( Credit *c ) { _free.push_back( c ); }
+};
+
 #endif
@@ -84,9 +84,7 @@ Flit::Flit()
   x_then_y = -1;
   data = 0;
   from_router = -1;
-  for(int i=0;i<20;i++)
-  test[i]=-1;
-  itest=-1;
+  route.Start( 0, 0, 0 );
 }  
 
 void Flit::Reset() 
@@ -118,5 +116,6 @@ void Flit::Reset()
   x_then_y = -1;
   data = 0;
   from_router = -1;
+  route.Start( 0, 0, 0 );
 }  
 
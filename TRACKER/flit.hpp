@@ -33,6 +33,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "booksim.hpp"
 #include <iostream>
+#include "sourceroute.hpp"
 
 struct Flit {
 
@@ -42,14 +43,26 @@ struct Flit {
 		  WRITE_REQUEST = 2,
 		  WRITE_REPLY   = 3,
                   ANY_TYPE      = 4 };
-  FlitType type;
+  // the fields the routers use on every hop share the first cache line
+  mutable SourceRouteCursor route; // the route is shared by all flits of the packet
+  int  vc;
+  int  dest;
+  int  pri;
+  int  id;
+
+  //for credit tracking, last router visited
+  mutable int from_router;
 
-  int vc;
+  int time_in_router;//shankar
+ int in_port;//shankar
 
   bool head;
   bool tail;
+  bool watch;
   bool true_tail;
-  
+
+  FlitType type;
+
   int  time;
   int  ttime;
   int  atime;
@@ -57,22 +70,13 @@ struct Flit {
   int  sn;
   int  rob_time;
 
-  int  id;
   int  pid;
   bool record;
+  short subnetwork;
 
   int  src;
-  int  dest;
 
-  int  pri;
-int test[20];
-int itest;
   int  hops;
-  bool watch;
-  short subnetwork;
-
-  //for credit tracking, last router visited
-  mutable int from_router;
 
   // Fields for multi-phase algorithms
   mutable int intm;
@@ -89,8 +93,6 @@ int itest;
 
   // Fields for arbitrary data
   void* data ;
-  int time_in_router;//shankar
- int in_port;//shankar
 
   // Constructor
   Flit() ;
@@ -0,0 +1,92 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*flitarena.cpp
+ *
+ *Slab allocator for the flits of a traffic manager
+ *
+ */
+
+#include "booksim.hpp"
+#include <new>
+#include "flitarena.hpp"
+
+FlitArena::FlitArena( int slab_flits ) :
+  _slab_flits( slab_flits ), _free( 0 ), _live( 0 ), _peak( 0 )
+{
+}
+
+// flits still in use are dropped with their slabs, Flit owns nothing
+FlitArena::~FlitArena( )
+{
+  for ( size_t s = 0; s < _slabs.size( ); ++s ) {
+    delete [] _slabs[s];
+  }
+}
+
+void FlitArena::_Grow( )
+{
+  _Slot *slab = new _Slot[_slab_flits];
+  _slabs.push_back( slab );
+  // link back to front so the slots are handed out in address order
+  for ( int i = _slab_flits - 1; i >= 0; --i ) {
+    slab[i].next = _free;
+    _free = &slab[i];
+  }
+}
+
+Flit *FlitArena::New( )
+{
+  if ( !_free ) {
+    _Grow( );
+  }
+  _Slot *slot = _free;
+  _free = slot->next;
+  if ( ++_live > _peak ) {
+    _peak = _live;
+  }
+  return new ( slot->flit ) Flit;
+}
+
+void FlitArena::Free( Flit *f )
+{
+  f->~Flit( );
+  _Slot *slot = reinterpret_cast<_Slot *>( f );
+  slot->next = _free;
+  _free = slot;
+  --_live;
+}
+
+void FlitArena::Display( ostream & os ) const
+{
+  os << "Flit arena: " << _peak << " flits at peak, "
+     << _live << " in use, " << Capacity( ) << " allocated in "
+     << _slabs.size( ) << " slabs of " << _slab_flits << " ("
+     << sizeof( _Slot ) << " bytes per flit)" << endl;
+}
@@ -0,0 +1,74 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _FLITARENA_HPP_
+#define _FLITARENA_HPP_
+
+#include <vector>
+#include <iostream>
+
+#include "flit.hpp"
+
+// cache line the flit slots are aligned to
+#define FLIT_ALIGN 64
+
+// Hands out flits from slabs that are never returned to the heap. A freed
+// flit is destroyed and its slot linked into a free list, so New and Free
+// are O(1) and a run settles on the flits it needs at its peak.
+class FlitArena {
+
+  union alignas(FLIT_ALIGN) _Slot {
+    _Slot         *next;   // while free
+    unsigned char  flit[sizeof(Flit)];
+  };
+
+  int _slab_flits;
+  vector<_Slot *> _slabs;
+  _Slot *_free;
+
+  int _live;
+  int _peak;
+
+  void _Grow( );
+
+public:
+  FlitArena( int slab_flits = 256 );
+  ~FlitArena( );
+
+  Flit *New( );          // a default constructed flit
+  void  Free( Flit *f );
+
+  int Live( ) const { return _live; }
+  int Peak( ) const { return _peak; }
+  int Capacity( ) const { return _slab_flits * (int)_slabs.size( ); }
+
+  void Display( ostream & os = cout ) const;
+};
+
+#endif
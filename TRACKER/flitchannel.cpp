@@ -47,7 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //  $Date: 2007/06/27 23:10:17 $
 //  $Id$
 // ----------------------------------------------------------------------
-FlitChannel::FlitChannel( int cycles ) : Channel<Flit>(cycles), _idle(0) {
+FlitChannel::FlitChannel( int cycles ) : Channel<Flit>(cycles), _routerSource(-1), _routerSink(-1), _idle(0) {
   for ( int i = 0; i < Flit::NUM_FLIT_TYPES; ++i)
     _active[i] = 0;
 }
@@ -91,12 +91,6 @@ int FlitChannel::GetSink(){
   return _routerSink;
 }
 
-bool FlitChannel::InUse() {
-  if ( _queue.empty() )
-    return false;
-  return ( _queue.back() != 0 );
-}
-
 void FlitChannel::Send( Flit* flit ) {
 
   if ( flit )
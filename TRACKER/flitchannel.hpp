@@ -65,8 +65,8 @@ public:
 
   int* GetActivity(){return _active;}
 
-  // Check for flit on input. Used for tracking channel use
-  bool InUse();
+  // idle cycles of a sender that skipped them (see Router::Wake)
+  void AddIdle( int cycles ) { _idle += cycles; }
 
   // Send flit 
   virtual void Send( Flit* flit );
@@ -35,6 +35,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include<fstream>
 
+#include "simcontext.hpp"
+
 /*all declared in main.cpp*/
 
 int GetSimTime();
@@ -44,37 +46,9 @@ Stats * GetStats(const std::string & name);
 
 extern bool _print_activity;
 
-extern int gK;
-extern int gN;
-extern int gC;
-
-
-extern int realgk;
-extern int realgn;
-
-extern int gNodes;
-
-
-extern int xrouter;
-extern int yrouter;
-extern int xcount ;
-extern int ycount;
-
 extern bool gTrace;
 
-extern double gBurstAlpha;
-extern double gBurstBeta;
-
-/*number of flits per packet, set by the configuration file*/
-extern int    gConstPacketSize;
-
-extern std::vector<int> gNodeStates;
-
-extern std::ostream * gWatchOut;
-
 //added by kvm
-extern std::ofstream fp;
-extern std::ofstream fp_stats;
 extern std::ifstream lfp;
 
 #endif
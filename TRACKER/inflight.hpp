@@ -0,0 +1,110 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _INFLIGHT_HPP_
+#define _INFLIGHT_HPP_
+
+#include <vector>
+#include <assert.h>
+
+using namespace std;
+
+// Objects in flight keyed by ids that are handed out in increasing order,
+// like flit and packet ids. The ids from the oldest one still in the table
+// on are kept in a ring of slots indexed by id modulo its size, which
+// doubles whenever that span outgrows it.
+template<class T>
+class InFlightTable {
+  vector<T *> _slots;
+  int _mask;
+  int _begin;   // oldest id that may be in the table
+  int _end;     // one past the newest id inserted
+  int _size;
+
+  T *&_Slot( int id ) { return _slots[id & _mask]; }
+
+  void _Grow( )
+  {
+    vector<T *> slots( 2 * _slots.size( ), (T *)0 );
+    int mask = (int)slots.size( ) - 1;
+    for ( int id = _begin; id < _end; ++id ) {
+      slots[id & mask] = _Slot( id );
+    }
+    _slots.swap( slots );
+    _mask = mask;
+  }
+
+public:
+  InFlightTable( int slots = 1024 ) :
+    _slots( slots, (T *)0 ), _mask( slots - 1 ), _begin( 0 ), _end( 0 ), _size( 0 )
+  {
+    assert( ( slots & _mask ) == 0 );
+  }
+
+  void Insert( int id, T *p )
+  {
+    assert( p && ( id >= _end ) );
+    if ( _size == 0 ) {
+      _begin = id;
+    }
+    while ( id - _begin >= (int)_slots.size( ) ) {
+      _Grow( );
+    }
+    _end = id + 1;
+    _Slot( id ) = p;
+    ++_size;
+  }
+
+  void Erase( int id )
+  {
+    assert( Find( id ) );
+    _Slot( id ) = 0;
+    --_size;
+    while ( ( _begin < _end ) && !_Slot( _begin ) ) {
+      ++_begin;
+    }
+  }
+
+  T *Find( int id ) const
+  {
+    if ( ( id < _begin ) || ( id >= _end ) ) {
+      return 0;
+    }
+    return _slots[id & _mask];
+  }
+
+  int  Size( ) const { return _size; }
+  bool Empty( ) const { return _size == 0; }
+
+  // the ids to scan with Find, in increasing order
+  int Begin( ) const { return _begin; }
+  int End( ) const { return _end; }
+};
+
+#endif
@@ -33,7 +33,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *Class of injection methods, bernouli and on_off
  *
  *The rate is packet rate not flit rate. Each time a packet is generated
- *gConstPacketSize number of flits are generated
+ *gSim->const_packet_size number of flits are generated
  */
 
 #include "booksim.hpp"
@@ -53,7 +53,7 @@ int bernoulli( int /*source*/, double rate )
 {
   //this is the packet injection rate, not flit rate
   return ( RandomFloat( ) < ( rate ) ) ? 
-    gConstPacketSize : 0;
+    gSim->const_packet_size : 0;
 }
 
 //=============================================================
@@ -63,35 +63,35 @@ int on_off( int source, double rate )
   double r1;
   bool issue;
 
-  assert( ( source >= 0 ) && ( source < gNodes ) );
+  assert( ( source >= 0 ) && ( source < gSim->nodes ) );
 
-  if ( gNodeStates.size() != gNodes ) {
-    gNodeStates.resize(gNodes, 0);
+  if ( gSim->node_states.size() != gSim->nodes ) {
+    gSim->node_states.resize(gSim->nodes, 0);
   }
 
   // advance state
 
-  if ( gNodeStates[source] == 0 ) {
-    if ( RandomFloat( ) < gBurstAlpha ) { // from off to on
-      gNodeStates[source] = 1;
+  if ( gSim->node_states[source] == 0 ) {
+    if ( RandomFloat( ) < gSim->burst_alpha ) { // from off to on
+      gSim->node_states[source] = 1;
     }
-  } else if ( RandomFloat( ) < gBurstBeta ) { // from on to off
-    gNodeStates[source] = 0;
+  } else if ( RandomFloat( ) < gSim->burst_beta ) { // from on to off
+    gSim->node_states[source] = 0;
   }
 
   // generate packet
 
   issue = false;
-  if ( gNodeStates[source] ) { // on?
-    r1 = rate * ( 1.0 + gBurstBeta / gBurstAlpha ) / 
-      (double)gConstPacketSize;
+  if ( gSim->node_states[source] ) { // on?
+    r1 = rate * ( 1.0 + gSim->burst_beta / gSim->burst_alpha ) / 
+      (double)gSim->const_packet_size;
 
     if ( RandomFloat( ) < r1 ) {
       issue = true;
     }
   }
 
-  return issue ? gConstPacketSize : 0;
+  return issue ? gSim->const_packet_size : 0;
 }
 
 //=============================================================
@@ -122,9 +122,9 @@ tInjectionProcess GetInjectionProcess( const Configuration& config )
     exit(-1);
   }
 
-  gConstPacketSize = config.GetInt( "const_flits_per_packet" );
-  gBurstAlpha      = config.GetFloat( "burst_alpha" );
-  gBurstBeta       = config.GetFloat( "burst_beta" );
+  gSim->const_packet_size = config.GetInt( "const_flits_per_packet" );
+  gSim->burst_alpha      = config.GetFloat( "burst_alpha" );
+  gSim->burst_beta       = config.GetFloat( "burst_beta" );
 
   return ip;
 }
@@ -52,6 +52,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sstream>
 #include "booksim.hpp"
 #include "routefunc.hpp"
+#include "routetable.hpp"
+#include "iq_router_baseline.hpp"
 #include "traffic.hpp"
 #include "booksim_config.hpp"
 #include "trafficmanager.hpp"
@@ -59,6 +61,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "network.hpp"
 #include "injection.hpp"
 #include "power_module.hpp"
+#include "sweep.hpp"
+#include <mutex>
 
 
 
@@ -83,16 +87,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //Global declarations
 //////////////////////
 
- /* the current traffic manager instance */
-TrafficManager * trafficManager = NULL;
-
  int GetSimTime() {
-	  return trafficManager->getTime();
+	  return gSim->manager->getTime();
 }
 
 class Stats;
 Stats * GetStats(const std::string & name) {
-  Stats* test =  trafficManager->getStats(name);
+  Stats* test =  gSim->manager->getStats(name);
   if(test == 0){
     cout<<"warning statistics "<<name<<" not found"<<endl;
   }
@@ -102,28 +103,9 @@ Stats * GetStats(const std::string & name) {
 /* printing activity factor*/ 
 bool _print_activity = true;  // added JOHN intial false
 
-int gK = 0;//radix
-int gN = 0;//dimension
-int gC = 0;//concentration
-
-/*These extra variables are necessary for correct traffic pattern generation
- *The difference is due to concentration, radix 4 with concentration of 4 is
- *equivalent to radix 8 with no concentration. Though this only really applies
- *under NOCs since NOCS are inheriently 2 dimension
- */
-int realgk;
-int realgn;
-
-int gNodes = 0;
-
-/*These variables are used by NOCS to specify the node concentration per 
- *router. Technically the realdgk realgn can be calculated from these 
- *global variables, thus they maybe removed later
+/* radix, dimension, node counts and the rest of the state a simulation
+ * changes live in its SimContext (simcontext.hpp), reached through gSim
  */
-int xrouter = 0;
-int yrouter = 0;
-int xcount  = 0;
-int ycount  = 0;
 
 //generate nocviewer trace
 bool gTrace = false;
@@ -131,31 +113,28 @@ bool gTrace = false;
 //injection functions
 map<string, tInjectionProcess> gInjectionProcessMap;
 
-//burst rates
-double gBurstAlpha;
-double gBurstBeta;
-
-/*number of flits per packet, when _use_read_write is false*/
-int    gConstPacketSize;
-
-//for on_off injections
-vector<int> gNodeStates;
-
-ostream * gWatchOut;
-ofstream fp,fp_stats;
-
 
 bool gGUIMode = false;  // if made true then results are not displayed fully (JOHN)
 
 /////////////////////////////////////////////////////////////////////////////
 
+// The routing function and selection maps are process wide and filled in
+// again by each network built, so simulations build one at a time.
+static mutex gSetupLock;
+
 bool AllocatorSim( const Configuration& config )
+{
+	return AllocatorSim( config, NULL );
+}
+
+bool AllocatorSim( const Configuration& config, SweepPoint *point )
 {
 	vector<Network *> net;
 	string topo;
 
 	config.GetStr( "topology", topo );
 	short networks = config.GetInt("physical_subnetworks");
+	gSetupLock.lock( );
 	  /*To include a new network, must register the network here
 	   *add an else if statement with the name of the network
 	   */
@@ -265,11 +244,12 @@ bool AllocatorSim( const Configuration& config )
 
 	 /*tcc and characterize are legacy
 	 *not sure how to use them    */
-	if(trafficManager)
+	if(gSim->manager)
 	{
-		delete trafficManager ;
+		delete gSim->manager ;
 	}
-	trafficManager = new TrafficManager( config, net ) ;  // creates an object for traffic manager. Pass config object.
+	gSim->manager = new TrafficManager( config, net ) ;  // creates an object for traffic manager. Pass config object.
+	gSetupLock.unlock( );
 	cout<< "& returned to MAIN!!!"<<endl;
 
 	  /*Start the simulation run 	   */
@@ -282,7 +262,7 @@ bool AllocatorSim( const Configuration& config )
 
 	/***************************** Ready... Steady...Start
 	*****************************/
-	bool result = trafficManager->Run() ; // invoke Run() of TrafficManager
+	bool result = gSim->manager->Run() ; // invoke Run() of TrafficManager
 	
 	/*****************************
 	*****************************/
@@ -296,10 +276,17 @@ bool AllocatorSim( const Configuration& config )
 	///Power analysis
 	if(config.GetInt("sim_power")==1)
 	{
-		Power_Module * pnet = new Power_Module(net[0], trafficManager, config);
+		Power_Module * pnet = new Power_Module(net[0], gSim->manager, config);
 		pnet->run();
 		delete pnet;
 	}
+	// a sweep point's thread ends here, nothing else can reach its manager
+	if ( point )
+	{
+		point->Record( gSim->manager );
+		delete gSim->manager;
+		gSim->manager = NULL;
+	}
 	for (int i=0; i<networks; ++i)
 	{
 		delete net[i];
@@ -312,11 +299,13 @@ bool AllocatorSim( const Configuration& config )
 
 int main( int argc, char **argv )
 {
-	fp.open("track.txt");
-	if(fp)
+	SimContext sim;   // the context of this run (a sweep gives each point its own)
+	gSim = &sim;
+	sim.trace.open("track.txt");
+	if(sim.trace)
 		cout<<"track file opened succesfully";
-		fp_stats.open("stats_lat.txt",ios::app);
-	if(fp_stats)
+		sim.stats.open("stats_lat.txt",ios::app);
+	if(sim.stats)
 		cout<<"statistics file opened succesfully";
 	cout<<".........................$$ Simulation Output $$......................."<<endl;       //  added JOHN
 	BookSimConfig config;   // creates object for Booksimconfig- set all default configuration value for parameters.
@@ -357,6 +346,8 @@ int main( int argc, char **argv )
   
 	  /*initialize routing, traffic, injection functions    */
 	InitializeRoutingMap( );   // goto @@ routefunc.cpp ...  does all the registration of routing fns.
+	InitializeRouteBuilderMap( );   // goto @@ routetable.cpp ...  source route builders for rajagiri.
+	InitializeSelectionMap( );   // goto @@ iq_router_baseline.cpp ...  output selection strategies.
 	InitializeTrafficMap( );   // goto @@ traffic.cpp ...  does all the registration of traffic fns.
 	InitializeInjectionMap( );  // goto @@ injection.cpp ...  does all the registration of injection process fns.
 	
@@ -369,22 +360,29 @@ int main( int argc, char **argv )
 	config.GetStr( "watch_out", watch_out_file );    // accept value from config file / default config value 
 	if(watch_out_file == "")
 	{
-	 	gWatchOut = NULL;
+	 	gSim->watch_out = NULL;
 	}
 	else if(watch_out_file == "-")
 	{
-		gWatchOut = &cout;
+		gSim->watch_out = &cout;
 	}
 	else
 	{
-		gWatchOut = new ofstream(watch_out_file.c_str());
+		gSim->watch_out = new ofstream(watch_out_file.c_str());
 	}
 	  
 	  /*configure and run the simulator   */
 	 bool result;
 	if(!gGUIMode)
 	{
-		result = AllocatorSim( config );    // function in main.cpp go up |^| 
+		if ( config.GetSweeps( ).empty( ) )
+		{
+			result = AllocatorSim( config );    // function in main.cpp go up |^| 
+		}
+		else
+		{
+			result = RunSweep( config );    // sweep.cpp, one AllocatorSim per point
+		}
 	}
 	else    // configutaion settings ig GUI mode
 	{
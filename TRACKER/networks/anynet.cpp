@@ -39,7 +39,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sstream>
 
 //this is a hack, I can't easily get the routing talbe out of the network
-map<int, int>* global_routing_table;
+// (kept in gSim->anynet_routing_table)
 
 AnyNet::AnyNet( const Configuration &config, const string & name )
   :  Network( config, name ){
@@ -178,24 +178,24 @@ void min_anynet( const Router *r, const Flit *f, int in_channel,
   int rID = r->GetID();
   int dest = f->dest;
   
-  out_port = global_routing_table[rID].find(dest)->second;
+  out_port = gSim->anynet_routing_table[rID].find(dest)->second;
 
-  int vcBegin = 0, vcEnd = gNumVCS-1;
+  int vcBegin = 0, vcEnd = gSim->num_vcs-1;
   if ( f->type == Flit::READ_REQUEST ) {
-    vcBegin = gReadReqBeginVC;
-    vcEnd   = gReadReqEndVC;
+    vcBegin = gSim->read_req_begin_vc;
+    vcEnd   = gSim->read_req_end_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-    vcBegin = gWriteReqBeginVC;
-    vcEnd   = gWriteReqEndVC;
+    vcBegin = gSim->write_req_begin_vc;
+    vcEnd   = gSim->write_req_end_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-    vcBegin = gReadReplyBeginVC;
-    vcEnd   = gReadReplyEndVC;
+    vcBegin = gSim->read_reply_begin_vc;
+    vcEnd   = gSim->read_reply_end_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-    vcBegin = gWriteReplyBeginVC;
-    vcEnd   = gWriteReplyEndVC;
+    vcBegin = gSim->write_reply_begin_vc;
+    vcEnd   = gSim->write_reply_end_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
     vcBegin = 0;
-    vcEnd   = gNumVCS-1;
+    vcEnd   = gSim->num_vcs-1;
   }
 
   outputs->AddRange( out_port , vcBegin, vcEnd );
@@ -237,7 +237,7 @@ void AnyNet::buildRoutingTable(){
       (routing_table[i])[j] = outport;
     }
   }
-  global_routing_table = routing_table;
+  gSim->anynet_routing_table = routing_table;
 }
 
 int AnyNet::findPath(int router, int dest, int* hop_count,map<int, bool>* visited){
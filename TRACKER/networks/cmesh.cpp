@@ -50,12 +50,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "misc_utils.hpp"
 #include "cmesh.hpp"
 
-int CMesh::_cX = 0 ;
-int CMesh::_cY = 0 ;
-int CMesh::_memo_NodeShiftX = 0 ;
-int CMesh::_memo_NodeShiftY = 0 ;
-int CMesh::_memo_PortShiftY = 0 ;
-
 CMesh::CMesh( const Configuration& config, const string & name ) 
   : Network(config, name) 
 {
@@ -66,6 +60,7 @@ CMesh::CMesh( const Configuration& config, const string & name )
 
 void CMesh::RegisterRoutingFunctions() {
   gRoutingFunctionMap["dor_cmesh"] = &dor_cmesh;
+  gRoutingFunctionMap["rajagiri_cmesh"] = &rajagiri;
   gRoutingFunctionMap["dor_no_express_cmesh"] = &dor_no_express_cmesh;
   gRoutingFunctionMap["xy_yx_cmesh"] = &xy_yx_cmesh;
   gRoutingFunctionMap["xy_yx_no_express_cmesh"]  = &xy_yx_no_express_cmesh;
@@ -79,19 +74,19 @@ void CMesh::_ComputeSize( const Configuration &config ) {
   
   ostringstream router_name;
   //how many routers in the x or y direction
-  xcount = config.GetInt("x");
-  ycount = config.GetInt("y");
+  gSim->x = config.GetInt("x");
+  gSim->y = config.GetInt("y");
   //configuration of hohw many clients in X and Y per router
-  xrouter = config.GetInt("xr");
-  yrouter = config.GetInt("yr");
+  gSim->xr = config.GetInt("xr");
+  gSim->yr = config.GetInt("yr");
 
   _express_channels = (config.GetInt("express_channels") == 1);
 
-  gK = _k = k ;
-  gN = _n = n ;
-  gC = _c = c ;
+  gSim->k = _k = k ;
+  gSim->n = _n = n ;
+  gSim->c = _c = c ;
 
-  assert(c == xrouter*yrouter);
+  assert(c == gSim->xr*gSim->yr);
   
   _sources  = _c * powi( _k, _n); // Source nodes in network
   _dests    = _c * powi( _k, _n); // Destination nodes in network
@@ -101,11 +96,6 @@ void CMesh::_ComputeSize( const Configuration &config ) {
   _cX = _c / _n ;   // Concentration in X Dimension 
   _cY = _c / _cX ;  // Concentration in Y Dimension
 
-  //
-  _memo_NodeShiftX = _cX >> 1 ;
-  _memo_NodeShiftY = log_two(gK * _cX) + ( _cY >> 1 ) ;
-  _memo_PortShiftY = log_two(gK * _cX)  ;
-
 }
 
 void CMesh::_BuildNet( const Configuration& config ) {
@@ -363,24 +353,30 @@ void CMesh::_BuildNet( const Configuration& config ) {
 //
 // ----------------------------------------------------------------------
 
+// static, so the concentration comes from the simulation's context
 int CMesh::NodeToRouter( int address ) {
 
-  int y  = (address /  (_cX*gK))/_cY ;
-  int x  = (address %  (_cX*gK))/_cY ;
-  int router = y*gK + x ;
+  const int _cX = gSim->c / gSim->n ;
+  const int _cY = gSim->c / _cX ;
+
+  int y  = (address /  (_cX*gSim->k))/_cY ;
+  int x  = (address %  (_cX*gSim->k))/_cY ;
+  int router = y*gSim->k + x ;
   
   return router ;
 }
 
 int CMesh::NodeToPort( int address ) {
   
+  const int _cX = gSim->c / gSim->n ;
+  const int _cY = gSim->c / _cX ;
   const int maskX  = _cX - 1 ;
   const int maskY  = _cY - 1 ;
 
   int x = address & maskX ;
-  int y = (int)(address/(2*gK)) & maskY ;
+  int y = (int)(address/(2*gSim->k)) & maskY ;
 
-  return (gC / 2) * y + x;
+  return (gSim->c / 2) * y + x;
 }
 
 // ----------------------------------------------------------------------
@@ -397,51 +393,51 @@ int cmesh_xy( int cur, int dest ) {
   const int POSITIVE_Y = 2 ;
   const int NEGATIVE_Y = 3 ;
 
-  int cur_y  = cur / gK;
-  int cur_x  = cur % gK;
-  int dest_y = dest / gK;
-  int dest_x = dest % gK;
+  int cur_y  = cur / gSim->k;
+  int cur_x  = cur % gSim->k;
+  int dest_y = dest / gSim->k;
+  int dest_x = dest % gSim->k;
 
   // Dimension-order Routing: x , y
   if (cur_x < dest_x) {
     // Express?
     if ((dest_x - cur_x) > 1){
       if (cur_y == 0)
-    	return gC + NEGATIVE_Y ;
-      if (cur_y == (gK-1))
-    	return gC + POSITIVE_Y ;
+    	return gSim->c + NEGATIVE_Y ;
+      if (cur_y == (gSim->k-1))
+    	return gSim->c + POSITIVE_Y ;
     }
-    return gC + POSITIVE_X ;
+    return gSim->c + POSITIVE_X ;
   }
   if (cur_x > dest_x) {
     // Express ? 
     if ((cur_x - dest_x) > 1){
       if (cur_y == 0)
-    	return gC + NEGATIVE_Y ;
-      if (cur_y == (gK-1))
-    	return gC + POSITIVE_Y ;
+    	return gSim->c + NEGATIVE_Y ;
+      if (cur_y == (gSim->k-1))
+    	return gSim->c + POSITIVE_Y ;
     }
-    return gC + NEGATIVE_X ;
+    return gSim->c + NEGATIVE_X ;
   }
   if (cur_y < dest_y) {
     // Express?
     if ((dest_y - cur_y) > 1) {
       if (cur_x == 0)
-    	return gC + NEGATIVE_X ;
-      if (cur_x == (gK-1))
-    	return gC + POSITIVE_X ;
+    	return gSim->c + NEGATIVE_X ;
+      if (cur_x == (gSim->k-1))
+    	return gSim->c + POSITIVE_X ;
     }
-    return gC + POSITIVE_Y ;
+    return gSim->c + POSITIVE_Y ;
   }
   if (cur_y > dest_y) {
     // Express ?
     if ((cur_y - dest_y) > 1 ){
       if (cur_x == 0)
-    	return gC + NEGATIVE_X ;
-      if (cur_x == (gK-1))
-    	return gC + POSITIVE_X ;
+    	return gSim->c + NEGATIVE_X ;
+      if (cur_x == (gSim->k-1))
+    	return gSim->c + POSITIVE_X ;
     }
-    return gC + NEGATIVE_Y ;
+    return gSim->c + NEGATIVE_Y ;
   }
   return 0;
 }
@@ -453,51 +449,51 @@ int cmesh_yx( int cur, int dest ) {
   const int POSITIVE_Y = 2 ;
   const int NEGATIVE_Y = 3 ;
 
-  int cur_y  = cur / gK ;
-  int cur_x  = cur % gK ;
-  int dest_y = dest / gK ;
-  int dest_x = dest % gK ;
+  int cur_y  = cur / gSim->k ;
+  int cur_x  = cur % gSim->k ;
+  int dest_y = dest / gSim->k ;
+  int dest_x = dest % gSim->k ;
 
   // Dimension-order Routing: y, x
   if (cur_y < dest_y) {
     // Express?
     if ((dest_y - cur_y) > 1) {
       if (cur_x == 0)
-    	return gC + NEGATIVE_X ;
-      if (cur_x == (gK-1))
-    	return gC + POSITIVE_X ;
+    	return gSim->c + NEGATIVE_X ;
+      if (cur_x == (gSim->k-1))
+    	return gSim->c + POSITIVE_X ;
     }
-    return gC + POSITIVE_Y ;
+    return gSim->c + POSITIVE_Y ;
   }
   if (cur_y > dest_y) {
     // Express ?
     if ((cur_y - dest_y) > 1 ){
       if (cur_x == 0)
-    	return gC + NEGATIVE_X ;
-      if (cur_x == (gK-1))
-    	return gC + POSITIVE_X ;
+    	return gSim->c + NEGATIVE_X ;
+      if (cur_x == (gSim->k-1))
+    	return gSim->c + POSITIVE_X ;
     }
-    return gC + NEGATIVE_Y ;
+    return gSim->c + NEGATIVE_Y ;
   }
   if (cur_x < dest_x) {
     // Express?
     if ((dest_x - cur_x) > 1){
       if (cur_y == 0)
-    	return gC + NEGATIVE_Y ;
-      if (cur_y == (gK-1))
-    	return gC + POSITIVE_Y ;
+    	return gSim->c + NEGATIVE_Y ;
+      if (cur_y == (gSim->k-1))
+    	return gSim->c + POSITIVE_Y ;
     }
-    return gC + POSITIVE_X ;
+    return gSim->c + POSITIVE_X ;
   }
   if (cur_x > dest_x) {
     // Express ? 
     if ((cur_x - dest_x) > 1){
       if (cur_y == 0)
-    	return gC + NEGATIVE_Y ;
-      if (cur_y == (gK-1))
-    	return gC + POSITIVE_Y ;
+    	return gSim->c + NEGATIVE_Y ;
+      if (cur_y == (gSim->k-1))
+    	return gSim->c + POSITIVE_Y ;
     }
-    return gC + NEGATIVE_X ;
+    return gSim->c + NEGATIVE_X ;
   }
   return 0;
 }
@@ -543,23 +539,23 @@ void xy_yx_cmesh( const Router *r, const Flit *f, int in_channel,
   }
 
   // ( Traffic Class , Routing Order ) -> Virtual Channel Range
-  int vcBegin = 0, vcEnd = gNumVCS-1;
+  int vcBegin = 0, vcEnd = gSim->num_vcs-1;
   int available_vcs = 0;
   //each class must have ast east 2 vcs assigned or else xy_yx will deadlock
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    vcBegin = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    vcBegin = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-   available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-   vcBegin = gWriteReqBeginVC;
+   available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+   vcBegin = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-   available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-   vcBegin = gReadReplyBeginVC;
+   available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+   vcBegin = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-   available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;      
-   vcBegin = gWriteReplyBeginVC;
+   available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;      
+   vcBegin = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = gNumVCS;
+    available_vcs = gSim->num_vcs;
     vcBegin = 0;
   }
   assert( available_vcs>=2);
@@ -588,27 +584,27 @@ int cmesh_xy_no_express( int cur, int dest ) {
   const int POSITIVE_Y = 2 ;
   const int NEGATIVE_Y = 3 ;
 
-  const int cur_y  = cur  / gK ;
-  const int cur_x  = cur  % gK ;
-  const int dest_y = dest / gK ;
-  const int dest_x = dest % gK ;
+  const int cur_y  = cur  / gSim->k ;
+  const int cur_x  = cur  % gSim->k ;
+  const int dest_y = dest / gSim->k ;
+  const int dest_x = dest % gSim->k ;
 
 
-  //  Note: channel numbers bellow gC (degree of concentration) are
+  //  Note: channel numbers bellow gSim->c (degree of concentration) are
   //        injection and ejection links
 
   // Dimension-order Routing: X , Y
   if (cur_x < dest_x) {
-    return gC + POSITIVE_X ;
+    return gSim->c + POSITIVE_X ;
   }
   if (cur_x > dest_x) {
-    return gC + NEGATIVE_X ;
+    return gSim->c + NEGATIVE_X ;
   }
   if (cur_y < dest_y) {
-    return gC + POSITIVE_Y ;
+    return gSim->c + POSITIVE_Y ;
   }
   if (cur_y > dest_y) {
-    return gC + NEGATIVE_Y ;
+    return gSim->c + NEGATIVE_Y ;
   }
   return 0;
 }
@@ -620,26 +616,26 @@ int cmesh_yx_no_express( int cur, int dest ) {
   const int POSITIVE_Y = 2 ;
   const int NEGATIVE_Y = 3 ;
   
-  const int cur_y  = cur / gK ;
-  const int cur_x  = cur % gK ;
-  const int dest_y = dest / gK ;
-  const int dest_x = dest % gK ;
+  const int cur_y  = cur / gSim->k ;
+  const int cur_x  = cur % gSim->k ;
+  const int dest_y = dest / gSim->k ;
+  const int dest_x = dest % gSim->k ;
 
-  //  Note: channel numbers bellow gC (degree of concentration) are
+  //  Note: channel numbers bellow gSim->c (degree of concentration) are
   //        injection and ejection links
 
   // Dimension-order Routing: X , Y
   if (cur_y < dest_y) {
-    return gC + POSITIVE_Y ;
+    return gSim->c + POSITIVE_Y ;
   }
   if (cur_y > dest_y) {
-    return gC + NEGATIVE_Y ;
+    return gSim->c + NEGATIVE_Y ;
   }
   if (cur_x < dest_x) {
-    return gC + POSITIVE_X ;
+    return gSim->c + POSITIVE_X ;
   }
   if (cur_x > dest_x) {
-    return gC + NEGATIVE_X ;
+    return gSim->c + NEGATIVE_X ;
   }
   return 0;
 }
@@ -685,23 +681,23 @@ void xy_yx_no_express_cmesh( const Router *r, const Flit *f, int in_channel,
   }
 
   // ( Traffic Class , Routing Order ) -> Virtual Channel Range
-  int vcBegin = 0, vcEnd = gNumVCS-1;
+  int vcBegin = 0, vcEnd = gSim->num_vcs-1;
   int available_vcs = 0;
   //each class must have ast east 2 vcs assigned or else xy_yx will deadlock
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    vcBegin = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    vcBegin = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-   available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-   vcBegin = gWriteReqBeginVC;
+   available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+   vcBegin = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-   available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-   vcBegin = gReadReplyBeginVC;
+   available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+   vcBegin = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-   available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;      
-   vcBegin = gWriteReplyBeginVC;
+   available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;      
+   vcBegin = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = gNumVCS;
+    available_vcs = gSim->num_vcs;
     vcBegin = 0;
   }
   assert( available_vcs>=2);
@@ -724,51 +720,51 @@ int cmesh_next( int cur, int dest ) {
   const int POSITIVE_Y = 2 ;
   const int NEGATIVE_Y = 3 ;
   
-  int cur_y  = cur / gK ;
-  int cur_x  = cur % gK ;
-  int dest_y = dest / gK ;
-  int dest_x = dest % gK ;
+  int cur_y  = cur / gSim->k ;
+  int cur_x  = cur % gSim->k ;
+  int dest_y = dest / gSim->k ;
+  int dest_x = dest % gSim->k ;
 
   // Dimension-order Routing: x , y
   if (cur_x < dest_x) {
     // Express?
-    if ((dest_x - cur_x) > gK/2-1){
+    if ((dest_x - cur_x) > gSim->k/2-1){
       if (cur_y == 0)
-	return gC + NEGATIVE_Y ;
-      if (cur_y == (gK-1))
-	return gC + POSITIVE_Y ;
+	return gSim->c + NEGATIVE_Y ;
+      if (cur_y == (gSim->k-1))
+	return gSim->c + POSITIVE_Y ;
     }
-    return gC + POSITIVE_X ;
+    return gSim->c + POSITIVE_X ;
   }
   if (cur_x > dest_x) {
     // Express ? 
-    if ((cur_x - dest_x) > gK/2-1){
+    if ((cur_x - dest_x) > gSim->k/2-1){
       if (cur_y == 0)
-	return gC + NEGATIVE_Y ;
-      if (cur_y == (gK-1)) 
-	return gC + POSITIVE_Y ;
+	return gSim->c + NEGATIVE_Y ;
+      if (cur_y == (gSim->k-1)) 
+	return gSim->c + POSITIVE_Y ;
     }
-    return gC + NEGATIVE_X ;
+    return gSim->c + NEGATIVE_X ;
   }
   if (cur_y < dest_y) {
     // Express?
-    if ((dest_y - cur_y) > gK/2-1) {
+    if ((dest_y - cur_y) > gSim->k/2-1) {
       if (cur_x == 0)
-	return gC + NEGATIVE_X ;
-      if (cur_x == (gK-1))
-	return gC + POSITIVE_X ;
+	return gSim->c + NEGATIVE_X ;
+      if (cur_x == (gSim->k-1))
+	return gSim->c + POSITIVE_X ;
     }
-    return gC + POSITIVE_Y ;
+    return gSim->c + POSITIVE_Y ;
   }
   if (cur_y > dest_y) {
     // Express ?
-    if ((cur_y - dest_y) > gK/2-1){
+    if ((cur_y - dest_y) > gSim->k/2-1){
       if (cur_x == 0)
-	return gC + NEGATIVE_X ;
-      if (cur_x == (gK-1))
-	return gC + POSITIVE_X ;
+	return gSim->c + NEGATIVE_X ;
+      if (cur_x == (gSim->k-1))
+	return gSim->c + POSITIVE_X ;
     }
-    return gC + NEGATIVE_Y ;
+    return gSim->c + NEGATIVE_Y ;
   }
 
   assert(false);
@@ -798,15 +794,15 @@ void dor_cmesh( const Router *r, const Flit *f, int in_channel,
     out_port = cmesh_next( cur_router, dest_router );
   }
   if (f->type == Flit::READ_REQUEST)
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
+    outputs->AddRange( out_port, gSim->read_req_begin_vc, gSim->read_req_end_vc );
   if (f->type == Flit::WRITE_REQUEST)
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
+    outputs->AddRange( out_port, gSim->write_req_begin_vc, gSim->write_req_end_vc );
   if (f->type ==  Flit::READ_REPLY)
-      outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
+      outputs->AddRange( out_port, gSim->read_reply_begin_vc, gSim->read_reply_end_vc );
   if (f->type ==  Flit::WRITE_REPLY)
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
+    outputs->AddRange( out_port, gSim->write_reply_begin_vc, gSim->write_reply_end_vc );
  if (f->type ==  Flit::ANY_TYPE)
-      outputs->AddRange( out_port, 0, gNumVCS-1);
+      outputs->AddRange( out_port, 0, gSim->num_vcs-1);
 }
 
 //============================================================
@@ -820,23 +816,23 @@ int cmesh_next_no_express( int cur, int dest ) {
   const int NEGATIVE_Y = 3 ;
   
   //magic constant 2, which is supose to be _cX and _cY
-  int cur_y  = cur/gK ;
-  int cur_x  = cur%gK ;
-  int dest_y = dest/gK;
-  int dest_x = dest%gK ;
+  int cur_y  = cur/gSim->k ;
+  int cur_x  = cur%gSim->k ;
+  int dest_y = dest/gSim->k;
+  int dest_x = dest%gSim->k ;
 
   // Dimension-order Routing: x , y
   if (cur_x < dest_x) {
-    return gC + POSITIVE_X ;
+    return gSim->c + POSITIVE_X ;
   }
   if (cur_x > dest_x) {
-    return gC + NEGATIVE_X ;
+    return gSim->c + NEGATIVE_X ;
   }
   if (cur_y < dest_y) {
-    return gC + POSITIVE_Y ;
+    return gSim->c + POSITIVE_Y ;
   }
   if (cur_y > dest_y) {
-    return gC + NEGATIVE_Y ;
+    return gSim->c + NEGATIVE_Y ;
   }
   assert(false);
   return -1;
@@ -863,16 +859,16 @@ void dor_no_express_cmesh( const Router *r, const Flit *f, int in_channel,
     // Forward to neighbouring router
     out_port = cmesh_next_no_express( cur_router, dest_router );
   }
-  outputs->AddRange( out_port, 0, gNumVCS - 1 );
+  outputs->AddRange( out_port, 0, gSim->num_vcs - 1 );
   if (f->type == Flit::READ_REQUEST)
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
+    outputs->AddRange( out_port, gSim->read_req_begin_vc, gSim->read_req_end_vc );
   if (f->type == Flit::WRITE_REQUEST)
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
+    outputs->AddRange( out_port, gSim->write_req_begin_vc, gSim->write_req_end_vc );
   if (f->type ==  Flit::READ_REPLY)
-    outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
+    outputs->AddRange( out_port, gSim->read_reply_begin_vc, gSim->read_reply_end_vc );
   if (f->type ==  Flit::WRITE_REPLY)
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
+    outputs->AddRange( out_port, gSim->write_reply_begin_vc, gSim->write_reply_end_vc );
   if (f->type ==  Flit::ANY_TYPE)
-    outputs->AddRange( out_port, 0, gNumVCS-1 );
+    outputs->AddRange( out_port, 0, gSim->num_vcs-1 );
   
 }
@@ -54,9 +54,9 @@ CMeshX2::CMeshX2( const Configuration &config, const string & name )
   int c = config.GetInt( "c" ) ;
 
 
-  gK = _k = k ;
-  gN = _n = n ;
-  gC = _c = c ;
+  gSim->k = _k = k ;
+  gSim->n = _n = n ;
+  gSim->c = _c = c ;
   
   _sources  = _c * powi( _k, _n); // Source nodes in network
   _dests    = _c * powi( _k, _n); // Destination nodes in network
@@ -69,11 +69,11 @@ void CMO::_ComputeSize( const Configuration &config )
 {
   _c = config.GetInt( "c" );
   
-  gC = _c;
+  gSim->c = _c;
 
   //this assume c= 4 nodes, need to change this
-  realgk = 8;
-  realgk = 2;
+  gSim->real_k = 8;
+  gSim->real_k = 2;
 
   _size     = 8*2; //16 routers
   _channels = 2*12*2 + 2*8;// ocatagon bidirectional*slice + slice connect
@@ -411,18 +411,18 @@ void dim_order_cmo( const Router *r, const Flit *f, int in_channel,
   // for deadlock avoidance in ring
   if ( f->ring_par == 0 ) {
     vc_min = 0;
-    vc_max = gNumVCS - 1;
+    vc_max = gSim->num_vcs - 1;
   } else if ( f->ring_par == 1) {
     vc_min = 0;
-    vc_max = gNumVCS -2;
+    vc_max = gSim->num_vcs -2;
   }
   else {
     vc_min = 1;
-    vc_max = gNumVCS - 1;
+    vc_max = gSim->num_vcs - 1;
   }
 
   if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "Adding VC range [" 
 		  << vc_min << "," 
 		  << vc_max << "]"
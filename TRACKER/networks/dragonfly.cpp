@@ -40,7 +40,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // //reservation
 // int** reservation;
-// extern int gConstPacketSize;
+// extern int gSim->const_packet_size;
 // extern int compressed_buffersensitivity;
 
 // //statistics tracking
@@ -110,7 +110,7 @@ void DragonFlyNew::_ComputeSize( const Configuration &config )
 
   
   // FIX...
-  gK = _p; gN = _n;
+  gSim->k = _p; gSim->n = _n;
 
   // with 1 dimension, total of 2p routers per group
   // N = 2p * p * (2p^2 + 1)
@@ -153,10 +153,10 @@ void DragonFlyNew::_ComputeSize( const Configuration &config )
 //     //reservation level of each router
 //     reservation = (int**)malloc(_num_of_switch*sizeof(int*));
 //     for(int i = 0 ; i<_num_of_switch; i++){
-//       reservation[i]=(int *)malloc(gK*sizeof(int));
+//       reservation[i]=(int *)malloc(gSim->k*sizeof(int));
 //     }
 //     for(int i = 0 ; i<_num_of_switch; i++){
-//       for(int j = 0; j<gK; j++){
+//       for(int j = 0; j<gSim->k; j++){
 // 	reservation[i][j]= 0;
 //       }
 //     }
@@ -170,12 +170,12 @@ void DragonFlyNew::_ComputeSize( const Configuration &config )
 //     }
 //     for(int i = 0 ; i<_num_of_switch; i++){
 //       for(int j = 0; j<_a; j++){
-// 	compressed_data[i][j]=(int *)malloc(gK*sizeof(int));
+// 	compressed_data[i][j]=(int *)malloc(gSim->k*sizeof(int));
 //       }
 //     }
 //     for(int i = 0 ; i<_num_of_switch; i++){
 //       for(int j = 0; j<_a; j++){
-// 	for(int l = 0; l<gK; l++){
+// 	for(int l = 0; l<gSim->k; l++){
 // 	  compressed_data[i][j][l]=0;
 // 	}
 //       }
@@ -448,7 +448,7 @@ void DragonFlyNew::RegisterRoutingFunctions(){
 
 int flatfly_selfrouting(int dest) {
   int out_port;
-  out_port = dest % gK;
+  out_port = dest % gSim->k;
   return out_port;
 }
 
@@ -459,10 +459,10 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 
   int dest  = f->dest;
   int rID =  r->GetID(); 
-  int _radix = gK;
+  int _radix = gSim->k;
   int _dim_found;
-  int grp_size_routers = 2* gK;
-  int grp_size_nodes = grp_size_routers * gK;
+  int grp_size_routers = 2* gSim->k;
+  int grp_size_nodes = grp_size_routers * gSim->k;
   int grp_ID = (int) (rID / grp_size_routers); 
   int debug = f->watch;
   int out_port = -1;
@@ -472,15 +472,15 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
   int grp_output;
 
   
-  if ( in_channel < gK ) out_vc = 0; 
+  if ( in_channel < gSim->k ) out_vc = 0; 
   else if (f->vc == 1)  out_vc = 1;
 
-  if ( in_channel < gK )  
+  if ( in_channel < gSim->k )  
     f->ph  = 0;  
 
   if (debug)
-    *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
-		<< " FLIT ID: " << f->id << " Router: " << rID << " routing  from src : " << f->src <<  " to dest : " << f->dest << " f->ph: " << f->ph << " in_channel: " << in_channel << " gK: " << gK << endl;
+    *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
+		<< " FLIT ID: " << f->id << " Router: " << rID << " routing  from src : " << f->src <<  " to dest : " << f->dest << " f->ph: " << f->ph << " in_channel: " << in_channel << " gSim->k: " << gSim->k << endl;
   
   if (dest >= grp_ID*grp_size_nodes && dest < (grp_ID+1)*grp_size_nodes) {
     // routing within router.
@@ -490,7 +490,7 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
   if (f->ph == 0) {
     // find "optical" long link to route 
 
-    dest_grp_ID = (int)((dest / gK) / grp_size_routers);
+    dest_grp_ID = (int)((dest / gSim->k) / grp_size_routers);
     if (dest_grp_ID == grp_ID) {
       f->ph = 2;
       dest  = f->dest;
@@ -500,10 +500,10 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
       else
 	grp_output = dest_grp_ID - 1;
 
-      grp_output_RID = ((int) (grp_output / (gK))) + grp_ID * grp_size_routers;
+      grp_output_RID = ((int) (grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 
       // create dummy dest for routing purpose
-      dest = grp_output_RID * gK;
+      dest = grp_output_RID * gSim->k;
     }
 
   } else if (f->ph == 2) {
@@ -513,15 +513,15 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
   _dim_found = 0;
   if (f->ph == 0 && grp_output_RID == rID) {
     if (debug)
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << " routing directly... " << endl;
-    out_port = gK + (2*gK-1) + grp_output %(gK);
+    out_port = gSim->k + (2*gSim->k-1) + grp_output %(gSim->k);
     _dim_found = 1;
     out_vc = 1;
     f->ph = 2;
   } else if (dest >= rID*_radix && dest < (rID+1)*_radix) {
     if (debug)
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << " selfrouting directly... " << endl;
 
     out_port = flatfly_selfrouting(dest);
@@ -529,19 +529,19 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
   } else {
     // routing within GROUP 
     _dim_found = 1;
-    int dest_rID = (int) (dest / gK);
+    int dest_rID = (int) (dest / gSim->k);
     //out_vc = 0;
     if (debug)
-    *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+    *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		<< " rID: " << rID << " dest_rID: " << dest_rID << " dest: " << dest << endl;
     if (rID < dest_rID)
-      out_port = (dest_rID % grp_size_routers) - 1 + gK;
+      out_port = (dest_rID % grp_size_routers) - 1 + gSim->k;
     else
-      out_port = (dest_rID % grp_size_routers) + gK;
+      out_port = (dest_rID % grp_size_routers) + gSim->k;
   }
 
   if (debug) {
-    *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+    *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		<< " grp_size_routers: " << grp_size_routers << endl
 		<< " grp_ID: " << grp_ID
 		<< " dest_grp_ID: " << dest_grp_ID << endl
@@ -553,7 +553,7 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 
   if (out_port == -1) { cout << " ERROR: no out_port found ! " << endl; exit(-1); }
   if (debug)
-    *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+    *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		<< "	through output port : " << out_port << " out vc: " << out_vc << endl;
 
   outputs->AddRange( out_port, out_vc, out_vc );
@@ -572,9 +572,9 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
   
 //   bool debug = false;
 
-//   int _radix = gK;
-//   int grp_size_routers = 2* gK;
-//   int grp_size_nodes = grp_size_routers * gK;
+//   int _radix = gSim->k;
+//   int grp_size_routers = 2* gSim->k;
+//   int grp_size_nodes = grp_size_routers * gSim->k;
 
 //  beginning:
 
@@ -582,12 +582,12 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //   int intm_dest = f->intm;
 
 //   int rID =  r->GetID();
-//   int intm_rID = (int)(f->intm/gK);
-//   int dest_rID =  (int)(f->dest/gK);
+//   int intm_rID = (int)(f->intm/gSim->k);
+//   int dest_rID =  (int)(f->dest/gSim->k);
 
 //   int grp_ID = (int)(rID / grp_size_routers);
-//   int dest_grp_ID = (int)((dest / gK) / grp_size_routers);
-//   int intm_grp_ID = (int)((intm_dest / gK) / grp_size_routers);
+//   int dest_grp_ID = (int)((dest / gSim->k) / grp_size_routers);
+//   int intm_grp_ID = (int)((intm_dest / gSim->k) / grp_size_routers);
 
 //   int grp_output_RID;
 //   int grp_output;
@@ -608,10 +608,10 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //     cout<<"/////////////////////"<<rID<<"//////////////////////////////////"<<endl;
 //     cout<<*f;
 //   }
-//   if(debug && in_channel < gK)
+//   if(debug && in_channel < gSim->k)
 //     cout<<"NEW FLIT"<<endl;
 
-//   if(in_channel < gK && !f->reservation_flit){
+//   if(in_channel < gSim->k && !f->reservation_flit){
 //     total_packet++;
 
 
@@ -637,13 +637,13 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //     if (dest_rID == rID) {
 //       if(debug)
 // 	cout<<"WITHIN ROUTER  router id "<<rID<<endl;
-//       out_port = dest%gK;
+//       out_port = dest%gSim->k;
 //     } else {
 //       //if the destination is not within the router 
 //       if (rID < dest_rID)
-// 	out_port = (dest_rID % grp_size_routers) - 1 + gK;
+// 	out_port = (dest_rID % grp_size_routers) - 1 + gSim->k;
 //       else
-// 	out_port = (dest_rID % grp_size_routers) + gK;
+// 	out_port = (dest_rID % grp_size_routers) + gSim->k;
 //     }
 //     goto done;
 //   }
@@ -656,14 +656,14 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //   } else {
 //     grp_output = dest_grp_ID - 1;
 //   }
-//   grp_output_RID = ((int) (grp_output / (gK))) + grp_ID * grp_size_routers;
+//   grp_output_RID = ((int) (grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 //   // create dummy dest for routing purpose
-//   dest = grp_output_RID * gK;
+//   dest = grp_output_RID * gSim->k;
   
 //   //////////////////////////////////////////////////////////////////////
 //   //For a brand new flit at the source group
 //   //////////////////////////////////////////////////////////////////////
-//   if ( in_channel < gK ){
+//   if ( in_channel < gSim->k ){
 
 //     f->ph  = 0;
 //     {
@@ -673,7 +673,7 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 	
 //       //check the minimal router "optical cable"
 //       //dest here should be the dummy dest
-//       dest_rID = (int) (dest / gK);
+//       dest_rID = (int) (dest / gSim->k);
 
 //       //MOTHER OF ALL COMPARISONS
 
@@ -697,12 +697,12 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 
 // 	f->minimal = 0;
 // 	if(debug){
-// 	  cout<<"Reservaiton failed actual "<<reservation[dest_rID][grp_output%gK]<<" Router"<<dest_rID<<endl;
+// 	  cout<<"Reservaiton failed actual "<<reservation[dest_rID][grp_output%gSim->k]<<" Router"<<dest_rID<<endl;
 // 	}
 // 	intm_dest = RandomInt((grp_size_nodes)*(grp_size_nodes+1)-1);//(a*p+1)*a*p
 
 // 	intm_grp_ID = (int)(intm_dest/grp_size_nodes); 
-// 	intm_rID = (int)(intm_dest/gK);
+// 	intm_rID = (int)(intm_dest/gSim->k);
 // 	f->ph=0;
 // 	f->intm = intm_dest;
 // 	if(debug)
@@ -721,10 +721,10 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	  grp_output = intm_grp_ID;
 // 	else
 // 	  grp_output = intm_grp_ID - 1;
-// 	grp_output_RID = ((int) (grp_output / (gK))) + grp_ID * grp_size_routers;
+// 	grp_output_RID = ((int) (grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 
 // 	if(grp_output_RID == rID){
-// 	  out_port = gK + (2*gK-1) + grp_output %(gK);
+// 	  out_port = gSim->k + (2*gSim->k-1) + grp_output %(gSim->k);
 // 	  if(debug)
 // 	    cout<<"LEAVING BY SELF"<<endl;
 // 	  if(intm_grp_ID == dest_grp_ID){
@@ -734,26 +734,26 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	}
 
 // 	if (rID < grp_output_RID)
-// 	  out_port = (grp_output_RID % grp_size_routers) - 1 + gK;
+// 	  out_port = (grp_output_RID % grp_size_routers) - 1 + gSim->k;
 // 	else
-// 	  out_port = (grp_output_RID % grp_size_routers) + gK;
+// 	  out_port = (grp_output_RID % grp_size_routers) + gSim->k;
 // 	goto done;
 //       } else { 
 // 	//minimal routing
 // 	f->ph=1;
 // 	f->reserve = true;
 // 	if(debug)
-// 	  cout<<"RESERVATION SUCCEDE limit  actual "<<reservation[dest_rID][grp_output%gK]-1<<" router "<<dest_rID<<endl;
+// 	  cout<<"RESERVATION SUCCEDE limit  actual "<<reservation[dest_rID][grp_output%gSim->k]-1<<" router "<<dest_rID<<endl;
 	
 // 	if(rID == dest_rID){
-// 	  out_port = gK + (2*gK-1) + grp_output%gK;
+// 	  out_port = gSim->k + (2*gSim->k-1) + grp_output%gSim->k;
 // 	  goto done;
 // 	}
 // 	//route based on minimal routing
 // 	if (rID < dest_rID)
-// 	  out_port = (dest_rID % grp_size_routers) - 1 + gK;
+// 	  out_port = (dest_rID % grp_size_routers) - 1 + gSim->k;
 // 	else
-// 	  out_port = (dest_rID % grp_size_routers) + gK;
+// 	  out_port = (dest_rID % grp_size_routers) + gSim->k;
 // 	goto done;
 //       }
 //     }
@@ -768,17 +768,17 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //     if (grp_output_RID == rID) {
 //       if(debug)
 // 	cout<<"LEAVING OPTICS"<<endl;
-//       out_port = gK + (2*gK-1) + grp_output %(gK);
+//       out_port = gSim->k + (2*gSim->k-1) + grp_output %(gSim->k);
 //       {
 // 	if(debug)
-// 	  cout<<"USED UP RESERVATION channel "<<grp_output %(gK)<<" reservation level "<<reservation[rID][grp_output %(gK)]<<endl;
+// 	  cout<<"USED UP RESERVATION channel "<<grp_output %(gSim->k)<<" reservation level "<<reservation[rID][grp_output %(gSim->k)]<<endl;
 //       }
 //       goto done;
 //     } else {
 //       if (rID < grp_output_RID)
-// 	out_port = (grp_output_RID % grp_size_routers) - 1 + gK;
+// 	out_port = (grp_output_RID % grp_size_routers) - 1 + gSim->k;
 //       else
-// 	out_port = (grp_output_RID % grp_size_routers) + gK;
+// 	out_port = (grp_output_RID % grp_size_routers) + gSim->k;
 //       goto done;
 //     }
 
@@ -789,8 +789,8 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //     if(debug)
 //       cout<<"NONMINIMAL ROUTING"<<endl;
 //     dest = f->intm;
-//     dest_grp_ID = (int)((dest / gK) / grp_size_routers);
-//     dest_rID = (int)((dest / gK));
+//     dest_grp_ID = (int)((dest / gSim->k) / grp_size_routers);
+//     dest_rID = (int)((dest / gSim->k));
 //     if (dest_rID == rID) {
 //       if(debug)
 // 	cout<<"SWITCHING TO MINIMAL ROUTING AT INTERM GROUP"<<endl;
@@ -799,7 +799,7 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //     rewin:
 //       f->ph = 1;
 //       dest = f->dest;
-//       dest_grp_ID = (int)((dest / gK) / grp_size_routers);
+//       dest_grp_ID = (int)((dest / gSim->k) / grp_size_routers);
  
 //       //switching to minimal routing
 //       if (grp_ID > dest_grp_ID){
@@ -807,7 +807,7 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //       } else{
 // 	grp_output = dest_grp_ID - 1;
 //       }
-//       grp_output_RID = ((int) (grp_output / (gK))) + grp_ID * grp_size_routers;
+//       grp_output_RID = ((int) (grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 //       if(debug){
 // 	cout<<"MINIMAL ROUTING"<<endl;
 //       }
@@ -815,15 +815,15 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	f->ph = 1;
 // 	if(debug)
 // 	  cout<<"LEAVING OPTICS"<<endl;
-// 	out_port = gK + (2*gK-1) + grp_output %(gK);
+// 	out_port = gSim->k + (2*gSim->k-1) + grp_output %(gSim->k);
     
 // 	goto done;
 //       } else {
 
 // 	if (rID < grp_output_RID)
-// 	  out_port = (grp_output_RID % grp_size_routers) - 1 + gK;
+// 	  out_port = (grp_output_RID % grp_size_routers) - 1 + gSim->k;
 // 	else
-// 	  out_port = (grp_output_RID % grp_size_routers) + gK;
+// 	  out_port = (grp_output_RID % grp_size_routers) + gSim->k;
 // 	goto done;
 //       }
       
@@ -835,18 +835,18 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //       }
 
 //       if(grp_ID == dest_grp_ID){
-// 	grp_output_RID =(int)(dest/gK);
+// 	grp_output_RID =(int)(dest/gSim->k);
 //       } else {
-// 	grp_output_RID = ((int) (grp_output / (gK))) + grp_ID * grp_size_routers;
+// 	grp_output_RID = ((int) (grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 //       }
 //       if (rID < grp_output_RID){
-// 	out_port = (grp_output_RID % grp_size_routers) - 1 + gK;
+// 	out_port = (grp_output_RID % grp_size_routers) - 1 + gSim->k;
 //       } else if(rID == grp_output_RID){
 // 	if(debug)
 // 	  cout<<"LEAVING OPTICS"<<endl;
-// 	out_port = gK + (2*gK-1) + grp_output %(gK);
+// 	out_port = gSim->k + (2*gSim->k-1) + grp_output %(gSim->k);
 //       } else{ 
-// 	out_port = (grp_output_RID % grp_size_routers) + gK;   
+// 	out_port = (grp_output_RID % grp_size_routers) + gSim->k;   
 //       }   
 //       goto done;
 //     }
@@ -879,9 +879,9 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //   outputs->Clear( );
 //   bool debug = false;
 
-//   int _radix = gK;
-//   int grp_size_routers = 2* gK;
-//   int grp_size_nodes = grp_size_routers * gK;
+//   int _radix = gSim->k;
+//   int grp_size_routers = 2* gSim->k;
+//   int grp_size_nodes = grp_size_routers * gSim->k;
 
 //  beginning:
 
@@ -889,12 +889,12 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //   int intm_dest = f->intm;
 
 //   int rID =  r->GetID();
-//   int intm_rID = (int)(f->intm/gK);
-//   int dest_rID =  (int)(f->dest/gK);
+//   int intm_rID = (int)(f->intm/gSim->k);
+//   int dest_rID =  (int)(f->dest/gSim->k);
 
 //   int grp_ID = (int)(rID / grp_size_routers);
-//   int dest_grp_ID = (int)((dest / gK) / grp_size_routers);
-//   int intm_grp_ID = (int)((intm_dest / gK) / grp_size_routers);
+//   int dest_grp_ID = (int)((dest / gSim->k) / grp_size_routers);
+//   int intm_grp_ID = (int)((intm_dest / gSim->k) / grp_size_routers);
 //   int intm_grp_output;
 //   int intm_grp_output_RID ;
 //   int grp_output_RID;
@@ -914,11 +914,11 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //     cout<<"/////////////////////"<<rID<<"//////////////////////////////////"<<endl;
 //     cout<<*f;
 //   }
-//   if(debug && in_channel < gK){
+//   if(debug && in_channel < gSim->k){
 //     cout<<"NEW FLIT"<<endl;
 //   }
 
-//   if ( in_channel < gK ){
+//   if ( in_channel < gSim->k ){
 //     total_packet++;
 //     if(dual_traffic){
 //       if(f->time>=dual_time && f->time<dual_time+dual_window){
@@ -948,28 +948,28 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //       if(debug){
 // 	cout<<"WITHIN ROUTER  router id "<<rID<<endl;
 //       }
-//       out_port = dest%gK;
+//       out_port = dest%gSim->k;
 //     } else {
 //       //if the destination is not within the router 
 //       if (rID < dest_rID)
-// 	out_port = (dest_rID % grp_size_routers) - 1 + gK;
+// 	out_port = (dest_rID % grp_size_routers) - 1 + gSim->k;
 //       else
-// 	out_port = (dest_rID % grp_size_routers) + gK;
+// 	out_port = (dest_rID % grp_size_routers) + gSim->k;
 //     }
 
 //     //gotta check local ugal
-//     if(in_channel<gK){
+//     if(in_channel<gSim->k){
 
 //       intm_dest = RandomInt((grp_size_nodes)-1)+grp_ID*grp_size_nodes;
-//       intm_rID = (int)(intm_dest/gK);
+//       intm_rID = (int)(intm_dest/gSim->k);
 //       if(intm_rID !=rID){
 // 	if (rID < intm_rID)
-// 	  intm_grp_output = (intm_rID % grp_size_routers) - 1 + gK;
+// 	  intm_grp_output = (intm_rID % grp_size_routers) - 1 + gSim->k;
 // 	else
-// 	  intm_grp_output = (intm_rID % grp_size_routers) + gK;
+// 	  intm_grp_output = (intm_rID % grp_size_routers) + gSim->k;
 // 	int min_queue = r->GetCredit(out_port, -1, -1) ;  
 // 	int nonmin_queue =  r->GetCredit(intm_grp_output, -1, -1) ;  
-// 	nonmin_queue = 2*nonmin_queue+compressed_buffersensitivity*gConstPacketSize;
+// 	nonmin_queue = 2*nonmin_queue+compressed_buffersensitivity*gSim->const_packet_size;
 // 	if(min_queue>nonmin_queue){
 // 	  f->ph = 0;
 // 	  failed_packet++;
@@ -1000,24 +1000,24 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //   } else {
 //     grp_output = dest_grp_ID - 1;
 //   }
-//   grp_output_RID = ((int) (grp_output / (gK))) + grp_ID * grp_size_routers;
+//   grp_output_RID = ((int) (grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 //   // create dummy dest for routing purpose
-//   dest = grp_output_RID * gK;
+//   dest = grp_output_RID * gSim->k;
   
 //   //////////////////////////////////////////////////////////////////////
 //   //For a brand new flit at the source group
 //   //////////////////////////////////////////////////////////////////////
-//   if ( in_channel < gK ){
+//   if ( in_channel < gSim->k ){
 //     f->ph  = 0;
 //     {
 //       //generate a nonminimal path
 //       //check the minimal router "optical cable"
-//       dest_rID = (int) (dest / gK);
+//       dest_rID = (int) (dest / gSim->k);
 
 //       do{
 // 	intm_dest = RandomInt((grp_size_nodes)*(grp_size_nodes+1)-1);
 // 	intm_grp_ID = (int)(intm_dest/grp_size_nodes); 
-// 	intm_rID = (int)(intm_dest/gK);
+// 	intm_rID = (int)(intm_dest/gSim->k);
 	
 // 	//do the noniminal routing based on the intermetidate router
 	
@@ -1027,7 +1027,7 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	else 
 // 	  intm_grp_output = intm_grp_ID;
 	
-// 	intm_grp_output_RID = ((int) (intm_grp_output / (gK))) + grp_ID * grp_size_routers;
+// 	intm_grp_output_RID = ((int) (intm_grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 //     } while((grp_ID == intm_grp_ID)||((f->dest/grp_size_nodes)==intm_grp_ID));
 
 // 	if((grp_ID == intm_grp_ID)||((f->dest/grp_size_nodes)==intm_grp_ID)){
@@ -1035,8 +1035,8 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	}
 
       
-//       bool minimal_decision = compressed_data[r->GetID()][dest_rID%grp_size_routers][grp_output%gK]>compressed_threshold;
-//       bool nonminimal_decision = compressed_data[r->GetID()][intm_grp_output_RID%grp_size_routers][intm_grp_output%gK]>compressed_threshold;
+//       bool minimal_decision = compressed_data[r->GetID()][dest_rID%grp_size_routers][grp_output%gSim->k]>compressed_threshold;
+//       bool nonminimal_decision = compressed_data[r->GetID()][intm_grp_output_RID%grp_size_routers][intm_grp_output%gSim->k]>compressed_threshold;
 
 //       //local ugal
 
@@ -1044,20 +1044,20 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //       int min_port = -1;
 //       int nonmin_port = -1;
 //       if(rID==dest_rID)
-// 	min_port = grp_output%gK+3*gK-1;
+// 	min_port = grp_output%gSim->k+3*gSim->k-1;
 //       else 
 // 	if (rID > dest_rID)
-// 	  min_port = (dest_rID % grp_size_routers) + gK;
+// 	  min_port = (dest_rID % grp_size_routers) + gSim->k;
 // 	else
-// 	  min_port = (dest_rID % grp_size_routers)-1 + gK;
+// 	  min_port = (dest_rID % grp_size_routers)-1 + gSim->k;
       
 //       if(rID == intm_grp_output_RID)
-// 	nonmin_port = intm_grp_output%gK+3*gK-1;
+// 	nonmin_port = intm_grp_output%gSim->k+3*gSim->k-1;
 //       else 
 // 	if (rID > intm_grp_output_RID)
-// 	  nonmin_port = (intm_grp_output_RID % grp_size_routers) + gK;
+// 	  nonmin_port = (intm_grp_output_RID % grp_size_routers) + gSim->k;
 // 	else
-// 	  nonmin_port = (intm_grp_output_RID % grp_size_routers)-1 + gK;
+// 	  nonmin_port = (intm_grp_output_RID % grp_size_routers)-1 + gSim->k;
 
 //       int min_queue = r->GetCredit(min_port, -1, -1) ;  
 //       int nonmin_queue =  r->GetCredit(nonmin_port, -1, -1) ;  
@@ -1106,7 +1106,7 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	  grp_output = intm_grp_ID;
 // 	else
 // 	  grp_output = intm_grp_ID - 1;
-// 	grp_output_RID = ((int) (grp_output / (gK))) + grp_ID * grp_size_routers;
+// 	grp_output_RID = ((int) (grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 	
 // 	f->ph=0;
 // 	f->intm = intm_dest;
@@ -1115,11 +1115,11 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	}
 
 // 	if(grp_output_RID == rID){
-// 	  out_port = gK + (2*gK-1) + grp_output %(gK);
+// 	  out_port = gSim->k + (2*gSim->k-1) + grp_output %(gSim->k);
 // 	  if(debug){
 // 	    cout<<"LEAVING BY SELF"<<endl;
 // 	  }
-// 	  //	  uncompressed_data[r->GetID()][out_port-gK*3+1]+=gConstPacketSize;
+// 	  //	  uncompressed_data[r->GetID()][out_port-gSim->k*3+1]+=gSim->const_packet_size;
 // 	  if(intm_grp_ID == dest_grp_ID){
 // 	    f->ph = 1;
 // 	  }
@@ -1127,15 +1127,15 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	}
 
 // 	if (rID < grp_output_RID)
-// 	  out_port = (grp_output_RID % grp_size_routers) - 1 + gK;
+// 	  out_port = (grp_output_RID % grp_size_routers) - 1 + gSim->k;
 // 	else
-// 	  out_port = (grp_output_RID % grp_size_routers) + gK;
+// 	  out_port = (grp_output_RID % grp_size_routers) + gSim->k;
 // 	goto done;
 //       } else { 
 // 	//////////////////////////////////////////////
 // 	//EPIC WIN
 // 	//////////////////////////////////////////////
-// 	nonmin_queue = 2*nonmin_queue+compressed_buffersensitivity*gConstPacketSize;
+// 	nonmin_queue = 2*nonmin_queue+compressed_buffersensitivity*gSim->const_packet_size;
 
 // 	if(min_queue > nonmin_queue){
 // 	  if(debug){cout<<"Refailed!\n";}
@@ -1148,18 +1148,18 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	f->minimal =  1;
 // 	f->reserve = true;
 // 	if(debug)
-// 	  cout<<"RESERVATION SUCCEDE limit  actual "<<reservation[dest_rID][grp_output%gK]-1<<" router "<<dest_rID<<endl;
+// 	  cout<<"RESERVATION SUCCEDE limit  actual "<<reservation[dest_rID][grp_output%gSim->k]-1<<" router "<<dest_rID<<endl;
 	
 // 	if(rID == dest_rID){
-// 	  out_port = gK + (2*gK-1) + grp_output%gK;
-// 	  //uncompressed_data[r->GetID()][out_port-gK*3+1]+=gConstPacketSize;
+// 	  out_port = gSim->k + (2*gSim->k-1) + grp_output%gSim->k;
+// 	  //uncompressed_data[r->GetID()][out_port-gSim->k*3+1]+=gSim->const_packet_size;
 // 	  goto done;
 // 	}
 // 	//route based on minimal routing
 // 	if (rID < dest_rID)
-// 	  out_port = (dest_rID % grp_size_routers) - 1 + gK;
+// 	  out_port = (dest_rID % grp_size_routers) - 1 + gSim->k;
 // 	else
-// 	  out_port = (dest_rID % grp_size_routers) + gK;
+// 	  out_port = (dest_rID % grp_size_routers) + gSim->k;
 // 	goto done;
 //       }
 //     }
@@ -1177,17 +1177,17 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //       if(debug){
 // 	cout<<"LEAVING OPTICS"<<endl;
 //       }
-//       out_port = gK + (2*gK-1) + grp_output %(gK);
-//       //uncompressed_data[r->GetID()][out_port-gK*3+1]+=gConstPacketSize;
+//       out_port = gSim->k + (2*gSim->k-1) + grp_output %(gSim->k);
+//       //uncompressed_data[r->GetID()][out_port-gSim->k*3+1]+=gSim->const_packet_size;
 //       if(debug){
-// 	cout<<"USED UP RESERVATION channel "<<grp_output %(gK)<<" reservation level "<<reservation[rID][grp_output %(gK)]<<endl;
+// 	cout<<"USED UP RESERVATION channel "<<grp_output %(gSim->k)<<" reservation level "<<reservation[rID][grp_output %(gSim->k)]<<endl;
 //       }
 //       goto done;
 //     } else {
 //       if (rID < grp_output_RID)
-// 	out_port = (grp_output_RID % grp_size_routers) - 1 + gK;
+// 	out_port = (grp_output_RID % grp_size_routers) - 1 + gSim->k;
 //       else
-// 	out_port = (grp_output_RID % grp_size_routers) + gK;
+// 	out_port = (grp_output_RID % grp_size_routers) + gSim->k;
 //       goto done;
 //     }
     
@@ -1199,8 +1199,8 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //       cout<<"NONMINIMAL ROUTING"<<endl;
 //     }
 //     dest = f->intm;
-//     dest_grp_ID = (int)((dest / gK) / grp_size_routers);
-//     dest_rID = (int)((dest / gK));
+//     dest_grp_ID = (int)((dest / gSim->k) / grp_size_routers);
+//     dest_rID = (int)((dest / gSim->k));
 //     if (dest_rID == rID) {
 //       if(debug){
 // 	cout<<"SWITCHING TO MINIMAL ROUTING AT INTERM GROUP"<<endl;
@@ -1210,7 +1210,7 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //     rewin:
 //       f->ph = 1;
 //       dest = f->dest;
-//       dest_grp_ID = (int)((dest / gK) / grp_size_routers);
+//       dest_grp_ID = (int)((dest / gSim->k) / grp_size_routers);
  
 //       //switching to minimal routing
 //       if (grp_ID > dest_grp_ID){
@@ -1218,7 +1218,7 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //       } else{
 // 	grp_output = dest_grp_ID - 1;
 //       }
-//       grp_output_RID = ((int) (grp_output / (gK))) + grp_ID * grp_size_routers;
+//       grp_output_RID = ((int) (grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 //       if(debug){
 // 	cout<<"MINIMAL ROUTING"<<endl;
 //       }
@@ -1227,15 +1227,15 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 // 	if(debug){
 // 	  cout<<"LEAVING OPTICS"<<endl;
 // 	}
-// 	out_port = gK + (2*gK-1) + grp_output %(gK);
-// 	//uncompressed_data[r->GetID()][out_port-gK*3+1]+=gConstPacketSize;
+// 	out_port = gSim->k + (2*gSim->k-1) + grp_output %(gSim->k);
+// 	//uncompressed_data[r->GetID()][out_port-gSim->k*3+1]+=gSim->const_packet_size;
 // 	goto done;
 //       } else {
 
 // 	if (rID < grp_output_RID)
-// 	  out_port = (grp_output_RID % grp_size_routers) - 1 + gK;
+// 	  out_port = (grp_output_RID % grp_size_routers) - 1 + gSim->k;
 // 	else
-// 	  out_port = (grp_output_RID % grp_size_routers) + gK;
+// 	  out_port = (grp_output_RID % grp_size_routers) + gSim->k;
 // 	goto done;
 //       }
       
@@ -1247,20 +1247,20 @@ void min_dragonflynew( const Router *r, const Flit *f, int in_channel,
 //       }
 
 //       if(grp_ID == dest_grp_ID){
-// 	grp_output_RID =(int)(dest/gK);
+// 	grp_output_RID =(int)(dest/gSim->k);
 //       } else {
-// 	grp_output_RID = ((int) (grp_output / (gK))) + grp_ID * grp_size_routers;
+// 	grp_output_RID = ((int) (grp_output / (gSim->k))) + grp_ID * grp_size_routers;
 //       }
 //       if (rID < grp_output_RID){
-// 	out_port = (grp_output_RID % grp_size_routers) - 1 + gK;
+// 	out_port = (grp_output_RID % grp_size_routers) - 1 + gSim->k;
 //       } else if(rID == grp_output_RID){
 // 	if(debug){
 // 	  cout<<"LEAVING OPTICS"<<endl;
 // 	}
-// 	out_port = gK + (2*gK-1) + grp_output %(gK);
-// 	//uncompressed_data[r->GetID()][out_port-gK*3+1]+=gConstPacketSize;
+// 	out_port = gSim->k + (2*gSim->k-1) + grp_output %(gSim->k);
+// 	//uncompressed_data[r->GetID()][out_port-gSim->k*3+1]+=gSim->const_packet_size;
 //       } else{ 
-// 	out_port = (grp_output_RID % grp_size_routers) + gK;   
+// 	out_port = (grp_output_RID % grp_size_routers) + gSim->k;   
 //       }   
 //       goto done;
 //     }
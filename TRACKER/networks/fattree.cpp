@@ -74,14 +74,14 @@ void FatTree::_ComputeSize( const Configuration& config )
 
   _k = config.GetInt( "k" );
   _n = config.GetInt( "n" );
-  yrouter = config.GetInt( "yr" );
-  xrouter = config.GetInt( "xr" );
+  gSim->yr = config.GetInt( "yr" );
+  gSim->xr = config.GetInt( "xr" );
 
   /*in case that we are using fattree other than 64 nodes*/
   //latency_correction = (double)_k/4;
  
    
-  gK = _k; gN = _n;
+  gSim->k = _k; gSim->n = _n;
 
   
   
@@ -143,8 +143,8 @@ void FatTree::_BuildNet( const Configuration& config )
   //  placement and power consumption
   //
   
-  int _cY =  yrouter;
-  int _cX =  xrouter;
+  int _cY =  gSim->yr;
+  int _cX =  gSim->xr;
 
   for ( pos = 0 ; pos < nPos ; ++pos ) {
 
@@ -89,16 +89,16 @@ void FlatFlyOnChip::_ComputeSize( const Configuration &config )
   FlatFlyOnChip::half_vcs = (short)config.GetInt("num_vcs") / 2;
 
   //how many routers in the x or y direction
-  xcount = config.GetInt("x");
-  ycount = config.GetInt("y");
+  gSim->x = config.GetInt("x");
+  gSim->y = config.GetInt("y");
   //configuration of hohw many clients in X and Y per router
-  xrouter = config.GetInt("xr");
-  yrouter = config.GetInt("yr");
-  gK = _k; 
-  gN = _n;
-  gC = _c;
+  gSim->xr = config.GetInt("xr");
+  gSim->yr = config.GetInt("yr");
+  gSim->k = _k; 
+  gSim->n = _n;
+  gSim->c = _c;
   
-  assert(_c == xrouter*yrouter);
+  assert(_c == gSim->xr*gSim->yr);
 
   _sources = powi( _k, _n )*_c;   //network size
   _dests   = powi( _k, _n )*_c;
@@ -154,16 +154,16 @@ void FlatFlyOnChip::_BuildNet( const Configuration &config )
     //******************************************************************
     
     //as accurately model the length of these channels as possible
-    int yleng = -yrouter/2;
-    int xleng = -xrouter/2;
-    bool yodd = yrouter%2==1;
-    bool xodd = xrouter%2==1;
+    int yleng = -gSim->yr/2;
+    int xleng = -gSim->xr/2;
+    bool yodd = gSim->yr%2==1;
+    bool xodd = gSim->xr%2==1;
     
-    int y_index = node/(xcount);
-    int x_index = node%(xcount);
+    int y_index = node/(gSim->x);
+    int x_index = node%(gSim->x);
     //estimating distance from client to router
-    for (int y = 0; y < yrouter ; y++) {
-      for (int x = 0; x < xrouter ; x++) {
+    for (int y = 0; y < gSim->yr ; y++) {
+      for (int x = 0; x < gSim->xr ; x++) {
 	//Zero is a naughty number
 	if(yleng == 0 && !yodd){
 	  yleng++;
@@ -182,12 +182,12 @@ void FlatFlyOnChip::_BuildNet( const Configuration &config )
 	}
 	//increment for the next client, add Y, if full, reset y add x
 	yleng++;
-	if(yleng>yrouter/2){
-	  yleng= -yrouter/2;
+	if(yleng>gSim->yr/2){
+	  yleng= -gSim->yr/2;
 	  xleng++;
 	}
 	//adopted from the CMESH, the first node has 0,1,8,9 (as an example)
-	int link = (xcount * xrouter) * (yrouter * y_index + y) + (xrouter * x_index + x) ;
+	int link = (gSim->x * gSim->xr) * (gSim->yr * y_index + y) + (gSim->xr * x_index + x) ;
 
 	if(use_noc_latency){
 	  _inject[link]->SetLatency(ileng);
@@ -261,9 +261,9 @@ void FlatFlyOnChip::_BuildNet( const Configuration &config )
 	}
 	//calculate channel length
 	int length = 0;
-	int oned = abs((node%xcount)-(other%xcount));
-	int twod = abs(node/xcount-other/xcount);
-	length = xrouter*oned + yrouter *twod;
+	int oned = abs((node%gSim->x)-(other%gSim->x));
+	int twod = abs(node/gSim->x-other/gSim->x);
+	length = gSim->xr*oned + gSim->yr *twod;
 	//oh the node<other silly ness
 	if(node<other){
 	  offset = -1;
@@ -325,6 +325,7 @@ void FlatFlyOnChip::RegisterRoutingFunctions(){
   
   gRoutingFunctionMap["ran_min_flatfly"] = &min_flatfly;
   gRoutingFunctionMap["xyyx_flatfly"] = &xyyx_flatfly;
+  gRoutingFunctionMap["rajagiri_flatfly"] = &rajagiri;
   gRoutingFunctionMap["valiant_flatfly"] = &valiant_flatfly;
   gRoutingFunctionMap["ugal_flatfly"] = &ugal_flatfly_onchip;
   gRoutingFunctionMap["ugal_xyyx_flatfly"] = &ugal_xyyx_flatfly_onchip;
@@ -338,11 +339,11 @@ void xyyx_flatfly( const Router *r, const Flit *f, int in_channel,
  
   outputs->Clear( );
   int dest  = flatfly_transformation(f->dest);
-  int targetr= (int)(dest/gC);
+  int targetr= (int)(dest/gSim->c);
   int out_port = -1;
 
 
-  if(in_channel<gC){
+  if(in_channel<gSim->c){
     if(RandomInt(1)){
       f->x_then_y = true;
     } else {
@@ -351,7 +352,7 @@ void xyyx_flatfly( const Router *r, const Flit *f, int in_channel,
   }  
   
   if(targetr==r->GetID()){ //if we are at the final router, yay, output to client
-    out_port = dest  - targetr*gC;
+    out_port = dest  - targetr*gSim->c;
   } else{
    
     if(f->x_then_y){
@@ -362,23 +363,23 @@ void xyyx_flatfly( const Router *r, const Flit *f, int in_channel,
   }
   
 
-  int vcBegin = 0, vcEnd = gNumVCS-1;
+  int vcBegin = 0, vcEnd = gSim->num_vcs-1;
   int available_vcs = 0;
   //each class must have ast east 2 vcs assigned or else xy_yx will deadlock
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    vcBegin = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    vcBegin = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-   available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-   vcBegin = gWriteReqBeginVC;
+   available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+   vcBegin = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-   available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-   vcBegin = gReadReplyBeginVC;
+   available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+   vcBegin = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-   available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;      
-   vcBegin = gWriteReplyBeginVC;
+   available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;      
+   vcBegin = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = gNumVCS;
+    available_vcs = gSim->num_vcs;
     vcBegin = 0;
   }
   assert( available_vcs>=2);
@@ -393,21 +394,21 @@ void xyyx_flatfly( const Router *r, const Flit *f, int in_channel,
 
 int flatfly_outport_yx(int dest, int rID) {
   int dest_rID;
-  int _dim   = gN;
+  int _dim   = gSim->n;
   int output = -1, dID, sID;
   
-  dest_rID = (int) (dest / gC);
+  dest_rID = (int) (dest / gSim->c);
   
   if(dest_rID==rID){
-    return dest  - rID*gC;
+    return dest  - rID*gSim->c;
   }
 
   for (int d=_dim-1;d >= 0; d--) {
-    int power = powi(gK,d);
+    int power = powi(gSim->k,d);
     dID = int(dest_rID / power);
     sID = int(rID / power);
     if ( dID != sID ) {
-      output = gC + ((gK-1)*d) - 1;
+      output = gSim->c + ((gSim->k-1)*d) - 1;
       if (dID > sID) {
 	output += dID;
       } else {
@@ -431,15 +432,15 @@ void valiant_flatfly( const Router *r, const Flit *f, int in_channel,
   outputs->Clear( );
   int dest  = flatfly_transformation(f->dest);
   int out_port;
-  int vcBegin = 0, vcEnd = (gNumVCS-1); 
-  if ( in_channel < gC ){
+  int vcBegin = 0, vcEnd = (gSim->num_vcs-1); 
+  if ( in_channel < gSim->c ){
     f->ph = 0;
-    f->intm = RandomInt( powi( gK, gN )*gC-1);
+    f->intm = RandomInt( powi( gSim->k, gSim->n )*gSim->c-1);
   }
 
   int intm = flatfly_transformation(f->intm);
 
-  if((int)(intm/gC) == r->GetID() || (int)(dest/gC)== r->GetID()){
+  if((int)(intm/gSim->c) == r->GetID() || (int)(dest/gSim->c)== r->GetID()){
     f->ph = 1;
   }  
 
@@ -455,19 +456,19 @@ void valiant_flatfly( const Router *r, const Flit *f, int in_channel,
     //each class must have ast east 2 vcs assigned or else valiant valiant will deadlock
   int available_vcs = 0;
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    vcBegin = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    vcBegin = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-   available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-   vcBegin = gWriteReqBeginVC;
+   available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+   vcBegin = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-   available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-   vcBegin = gReadReplyBeginVC;
+   available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+   vcBegin = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-   available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;      
-   vcBegin = gWriteReplyBeginVC;
+   available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;      
+   vcBegin = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = gNumVCS;
+    available_vcs = gSim->num_vcs;
     vcBegin = 0;
   }
   assert( available_vcs>=2);
@@ -488,37 +489,37 @@ void min_flatfly( const Router *r, const Flit *f, int in_channel,
  
   outputs->Clear( );
   int dest  = flatfly_transformation(f->dest);
-  int targetr= (int)(dest/gC);
-  int xdest = ((int)(dest/gC)) % gK;
-  int xcurr = ((r->GetID())) % gK;
+  int targetr= (int)(dest/gSim->c);
+  int xdest = ((int)(dest/gSim->c)) % gSim->k;
+  int xcurr = ((r->GetID())) % gSim->k;
 
-  int ydest = ((int)(dest/gC)) / gK;
-  int ycurr = ((r->GetID())) / gK;
+  int ydest = ((int)(dest/gSim->c)) / gSim->k;
+  int ycurr = ((r->GetID())) / gSim->k;
 
   int out_port = -1;
 
   if(targetr==r->GetID()){ //if we are at the final router, yay, output to client
-    out_port = dest  - targetr*gC;
+    out_port = dest  - targetr*gSim->c;
   } else{ //else select a dimension at random
     out_port = flatfly_outport(dest, r->GetID());
   }
  
-  int vcBegin = 0, vcEnd = gNumVCS-1;
+  int vcBegin = 0, vcEnd = gSim->num_vcs-1;
   if ( f->type == Flit::READ_REQUEST ) {
-    vcBegin = gReadReqBeginVC;
-    vcEnd   = gReadReqEndVC;
+    vcBegin = gSim->read_req_begin_vc;
+    vcEnd   = gSim->read_req_end_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-    vcBegin = gWriteReqBeginVC;
-    vcEnd   = gWriteReqEndVC;
+    vcBegin = gSim->write_req_begin_vc;
+    vcEnd   = gSim->write_req_end_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-    vcBegin = gReadReplyBeginVC;
-    vcEnd   = gReadReplyEndVC;
+    vcBegin = gSim->read_reply_begin_vc;
+    vcEnd   = gSim->read_reply_end_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-    vcBegin = gWriteReplyBeginVC;
-    vcEnd   = gWriteReplyEndVC;
+    vcBegin = gSim->write_reply_begin_vc;
+    vcEnd   = gSim->write_reply_end_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
     vcBegin = 0;
-    vcEnd   = gNumVCS-1;
+    vcEnd   = gSim->num_vcs-1;
   }
     outputs->AddRange( out_port , vcBegin, vcEnd );
 }
@@ -537,7 +538,7 @@ void ugal_xyyx_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
   int dest  = flatfly_transformation(f->dest);
 
   int rID =  r->GetID();
-  int _concentration = gC;
+  int _concentration = gSim->c;
   int out_port;
   int found;
   int debug = 0;
@@ -546,10 +547,10 @@ void ugal_xyyx_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
   int threshold = 2;
 
   int vcBegin = 0;
-  int vcEnd = gNumVCS - 1;
+  int vcEnd = gSim->num_vcs - 1;
 
 
-  if ( in_channel < gC ){
+  if ( in_channel < gSim->c ){
     if(gTrace){
       cout<<"New Flit "<<f->src<<endl;
     }
@@ -591,7 +592,7 @@ void ugal_xyyx_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
     }
     else  {
       found = 1;
-      out_port = dest % gC;
+      out_port = dest % gSim->c;
       if (debug)   cout << "      final routing to destination ";
     }
   }
@@ -669,10 +670,10 @@ void ugal_xyyx_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
     cout << *f; exit (-1);
   }
   
-  if (out_port >= gN*(gK-1) + gC)  {
+  if (out_port >= gSim->n*(gSim->k-1) + gSim->c)  {
     cout << " ERROR: output port too big! " << endl;
     cout << " OUTPUT select: " << out_port << endl;
-    cout << " router radix: " <<  gN*(gK-1) + gK << endl;
+    cout << " router radix: " <<  gSim->n*(gSim->k-1) + gSim->k << endl;
     exit (-1);
   }
   
@@ -684,19 +685,19 @@ void ugal_xyyx_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
   int begin_vcs = -1;
   int available_vcs = 0;
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    begin_vcs = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    begin_vcs = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-    available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-    begin_vcs = gWriteReqBeginVC;
+    available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+    begin_vcs = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-    available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-    begin_vcs = gReadReplyBeginVC;
+    available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+    begin_vcs = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-    available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;
-    begin_vcs = gWriteReplyBeginVC;
+    available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;
+    begin_vcs = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = (gNumVCS);
+    available_vcs = (gSim->num_vcs);
     begin_vcs = 0;
   }
 
@@ -728,7 +729,7 @@ void ugal_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
   int dest  = flatfly_transformation(f->dest);
 
   int rID =  r->GetID();
-  int _concentration = gC;
+  int _concentration = gSim->c;
   int out_port;
   int found;
   int debug = 0;
@@ -737,9 +738,9 @@ void ugal_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
   int threshold = 2;
 
   int vcBegin = 0;
-  int vcEnd = gNumVCS - 1;
+  int vcEnd = gSim->num_vcs - 1;
 
-  if ( in_channel < gC ){
+  if ( in_channel < gSim->c ){
     if(gTrace){
       cout<<"New Flit "<<f->src<<endl;
     }
@@ -778,7 +779,7 @@ void ugal_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
     }
     else  {
       found = 1;
-      out_port = dest % gC;
+      out_port = dest % gSim->c;
       if (debug)   cout << "      final routing to destination ";
     }
   }
@@ -790,7 +791,7 @@ void ugal_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
      _ran_intm = find_ran_intm(flatfly_transformation(f->src), dest);
      tmp_out_port =  flatfly_outport(dest, rID);
      if (f->watch){
-       *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+       *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		   << " MIN tmp_out_port: " << tmp_out_port;
      }
 
@@ -800,7 +801,7 @@ void ugal_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
      tmp_out_port =  flatfly_outport(_ran_intm, rID);
      
      if (f->watch){
-       *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+       *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		   << " NONMIN tmp_out_port: " << tmp_out_port << endl;
      }
      if (_ran_intm >= rID*_concentration && _ran_intm < (rID+1)*_concentration) {
@@ -836,7 +837,7 @@ void ugal_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
      do {
        _ran_intm = find_ran_intm(flatfly_transformation(f->src), dest); // Find another intermediate destination.
        tmp_out_port = flatfly_outport(_ran_intm, rID); // Loop until we find one with an output in the same axis.
-     } while ((out_port-gC) / (gK-1) != (tmp_out_port-gC) / (gK-1)); // Now we need to know the distance with the old and new intermediate destination
+     } while ((out_port-gSim->c) / (gSim->k-1) != (tmp_out_port-gSim->c) / (gSim->k-1)); // Now we need to know the distance with the old and new intermediate destination
      _min_hop = find_distance(flatfly_transformation(f->src), f->intm) +    find_distance(f->intm, dest); // Old intermediate destination.
      _nonmin_hop = find_distance(flatfly_transformation(f->src),_ran_intm) +    find_distance(_ran_intm, dest); // New.
      if (r->GetCredit(out_port, vcBegin, vcEnd) * _min_hop > r->GetCredit(tmp_out_port, vcBegin, vcEnd) * _nonmin_hop) { // If the queuecnt for the other nonminimal output is smaller.
@@ -857,10 +858,10 @@ void ugal_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
     cout << *f; exit (-1);
   }
   
-  if (out_port >= gN*(gK-1) + gC)  {
+  if (out_port >= gSim->n*(gSim->k-1) + gSim->c)  {
     cout << " ERROR: output port too big! " << endl;
     cout << " OUTPUT select: " << out_port << endl;
-    cout << " router radix: " <<  gN*(gK-1) + gK << endl;
+    cout << " router radix: " <<  gSim->n*(gSim->k-1) + gSim->k << endl;
     exit (-1);
   }
   
@@ -871,19 +872,19 @@ void ugal_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
     //each class must have ast east 2 vcs assigned or else valiant will deadlock
   int available_vcs = 0;
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    vcBegin = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    vcBegin = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-   available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-   vcBegin = gWriteReqBeginVC;
+   available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+   vcBegin = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-   available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-   vcBegin = gReadReplyBeginVC;
+   available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+   vcBegin = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-   available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;      
-   vcBegin = gWriteReplyBeginVC;
+   available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;      
+   vcBegin = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = gNumVCS;
+    available_vcs = gSim->num_vcs;
     vcBegin = 0;
   }
   assert( available_vcs>=2);
@@ -904,24 +905,24 @@ void ugal_flatfly_onchip( const Router *r, const Flit *f, int in_channel,
 //=============================================================^M
 int find_distance (int src, int dest) {
   int dist = 0;
-  int _dim   = gN;
+  int _dim   = gSim->n;
   int _dim_size;
   
-  int src_tmp= (int) src / gC;
-  int dest_tmp = (int) dest / gC;
+  int src_tmp= (int) src / gSim->c;
+  int dest_tmp = (int) dest / gSim->c;
   int src_id, dest_id;
   
   //  cout << " HOP CNT between  src: " << src << " dest: " << dest;
   for (int d=0;d < _dim; d++) {
-    _dim_size = powi(gK, d )*gC;
+    _dim_size = powi(gSim->k, d )*gSim->c;
     //if ((int)(src / _dim_size) !=  (int)(dest / _dim_size))
     //   dist++;
-    src_id = src_tmp % gK;
-    dest_id = dest_tmp % gK;
+    src_id = src_tmp % gSim->k;
+    dest_id = dest_tmp % gSim->k;
     if (src_id !=  dest_id)
       dist++;
-    src_tmp = (int) (src_tmp / gK);
-    dest_tmp = (int) (dest_tmp / gK);
+    src_tmp = (int) (src_tmp / gSim->k);
+    dest_tmp = (int) (dest_tmp / gSim->k);
   }
   
   //  cout << " : " << dist << endl;
@@ -933,7 +934,7 @@ int find_distance (int src, int dest) {
 // UGAL : find random node for load balancing
 //=============================================================^M
 int find_ran_intm (int src, int dest) {
-  int _dim   = gN;
+  int _dim   = gSim->n;
   int _dim_size;
   int _ran_dest = 0;
   int debug = 0;
@@ -941,27 +942,27 @@ int find_ran_intm (int src, int dest) {
   if (debug) 
     cout << " INTM node for  src: " << src << " dest: " <<dest << endl;
   
-  src = (int) (src / gC);
-  dest = (int) (dest / gC);
+  src = (int) (src / gSim->c);
+  dest = (int) (dest / gSim->c);
   
-  _ran_dest = RandomInt(gC - 1);
+  _ran_dest = RandomInt(gSim->c - 1);
   if (debug) cout << " ............ _ran_dest : " << _ran_dest << endl;
   for (int d=0;d < _dim; d++) {
     
-    _dim_size = powi(gK, d)*gC;
-    if ((src % gK) ==  (dest % gK)) {
-      _ran_dest += (src % gK) * _dim_size;
+    _dim_size = powi(gSim->k, d)*gSim->c;
+    if ((src % gSim->k) ==  (dest % gSim->k)) {
+      _ran_dest += (src % gSim->k) * _dim_size;
       if (debug) 
-	cout << "    share same dimension : " << d << " int node : " << _ran_dest << " src ID : " << src % gK << endl;
+	cout << "    share same dimension : " << d << " int node : " << _ran_dest << " src ID : " << src % gSim->k << endl;
     } else {
       // src and dest are in the same dimension "d" + 1
       // ==> thus generate a random destination within
-      _ran_dest += RandomInt(gK - 1) * _dim_size;
+      _ran_dest += RandomInt(gSim->k - 1) * _dim_size;
       if (debug) 
 	cout << "    different  dimension : " << d << " int node : " << _ran_dest << " _dim_size: " << _dim_size << endl;
     }
-    src = (int) (src / gK);
-    dest = (int) (dest / gK);
+    src = (int) (src / gSim->k);
+    dest = (int) (dest / gSim->k);
   }
   
   if (debug) cout << " intermediate destination NODE: " << _ran_dest << endl;
@@ -977,21 +978,21 @@ int find_ran_intm (int src, int dest) {
 // starting from DIM 0 (x first)
 int flatfly_outport(int dest, int rID) {
   int dest_rID;
-  int _dim   = gN;
+  int _dim   = gSim->n;
   int output = -1, dID, sID;
   
-  dest_rID = (int) (dest / gC);
+  dest_rID = (int) (dest / gSim->c);
   
   if(dest_rID==rID){
-    return dest  - rID*gC;
+    return dest  - rID*gSim->c;
   }
 
 
   for (int d=0;d < _dim; d++) {
-    dID = (dest_rID % gK);
-    sID = (rID % gK);
+    dID = (dest_rID % gSim->k);
+    sID = (rID % gSim->k);
     if ( dID != sID ) {
-      output = gC + ((gK-1)*d) - 1;
+      output = gSim->c + ((gSim->k-1)*d) - 1;
       if (dID > sID) {
 
 	output += dID;
@@ -1001,8 +1002,8 @@ int flatfly_outport(int dest, int rID) {
       
       return output;
     }
-    dest_rID = (int) (dest_rID / gK);
-    rID      = (int) (rID / gK);
+    dest_rID = (int) (dest_rID / gSim->k);
+    rID      = (int) (rID / gSim->k);
   }
   if (output == -1) {
     cout << " ERROR ---- FLATFLY_OUTPORT function : output not found " << endl;
@@ -1021,14 +1022,14 @@ int flatfly_transformation(int dest){
   //cout<<"ORiginal destination "<<dest<<endl;
   //router in the x direction = find which column, and then mod by cY to find 
   //which horizontal router
-  int horizontal = (dest%(xcount*xrouter))/(xrouter);
-  int horizontal_rem = (dest%(xcount*xrouter))%(xrouter);
+  int horizontal = (dest%(gSim->x*gSim->xr))/(gSim->xr);
+  int horizontal_rem = (dest%(gSim->x*gSim->xr))%(gSim->xr);
   //router in the y direction = find which row, and then divided by cX to find 
   //vertical router
-  int vertical = (dest/(xcount*xrouter))/(yrouter);
-  int vertical_rem = (dest/(xcount*xrouter))%(yrouter);
+  int vertical = (dest/(gSim->x*gSim->xr))/(gSim->yr);
+  int vertical_rem = (dest/(gSim->x*gSim->xr))%(gSim->yr);
   //transform the destination to as if node0 was 0,1,2,3 and so forth
-  dest = (vertical*xcount + horizontal)*gC+xrouter*vertical_rem+horizontal_rem;
+  dest = (vertical*gSim->x + horizontal)*gSim->c+gSim->xr*vertical_rem+horizontal_rem;
   //cout<<"Transformed destination "<<dest<<endl<<endl;
   return dest;
 }
@@ -50,7 +50,7 @@ void KNFly::_ComputeSize( const Configuration &config )
   _k = config.GetInt( "k" );
   _n = config.GetInt( "n" );
 
-  gK = _k; gN = _n;
+  gSim->k = _k; gSim->n = _n;
 
   _sources = powi( _k, _n );
   _dests   = powi( _k, _n );
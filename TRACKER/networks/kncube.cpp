@@ -56,9 +56,9 @@ void KNCube::_ComputeSize( const Configuration &config )
 	_k = config.GetInt( "k" );  // geting values of k and n from the config
 	_n = config.GetInt( "n" );
 
-	gK = _k; gN = _n;
-	realgk = _k;
-	realgn = _n;
+	gSim->k = _k; gSim->n = _n;
+	gSim->real_k = _k;
+	gSim->real_n = _n;
 	_size = powi( _k, _n );  // computing total number of nodes.
 	_channels = 2*_n*_size;
 	_sources = _size;
@@ -69,11 +69,11 @@ void MECS::_ComputeSize( const Configuration &config ) {
   _n = config.GetInt( "n" );	// dimension
   _c = config.GetInt( "c" );    //concentration, may be different from k
 
-  xcount = config.GetInt("x");  //how many routers in the x or y direction
-  ycount = config.GetInt("y");
+  gSim->x = config.GetInt("x");  //how many routers in the x or y direction
+  gSim->y = config.GetInt("y");
 
-  xrouter = config.GetInt("xr");  //configuration of hohw many clients in X and Y per router
-  yrouter = config.GetInt("yr");
+  gSim->xr = config.GetInt("xr");  //configuration of hohw many clients in X and Y per router
+  gSim->yr = config.GetInt("yr");
 
 
   //only support this configuration right now
@@ -81,19 +81,19 @@ void MECS::_ComputeSize( const Configuration &config ) {
   assert(_k ==4 && _n ==2 && _c == 4);
 
   _r = _c+4; //, chanenls are combined pior to entering the router
-  gK = _k; 
-  gN = _n;
-  gC = _c;
+  gSim->k = _k; 
+  gSim->n = _n;
+  gSim->c = _c;
 
   //standard traffic pattern shennanigin
   string fn;
   config.GetStr( "traffic", fn, "none" );
   if(fn.compare("neighbor")==0 || fn.compare("tornado")==0){
-    realgk = 8;
-    realgn = 2;
+    gSim->real_k = 8;
+    gSim->real_n = 2;
   } else {
-    realgk = _k;
-    realgn = _n;
+    gSim->real_k = _k;
+    gSim->real_n = _n;
   }
 
   _sources = powi( _k, _n )*_c;   //network size
@@ -134,13 +134,13 @@ void MECS::_BuildNet( const Configuration &config ) {
     // add inject/eject channels connected to the processor nodes
     //******************************************************************
     
-    int y_index = node/(xcount);
-    int x_index = node%(xcount);
+    int y_index = node/(gSim->x);
+    int x_index = node%(gSim->x);
     //assume inject, eject latency of 1
-    for (int y = 0; y < yrouter ; y++) {
-      for (int x = 0; x < xrouter ; x++) {
+    for (int y = 0; y < gSim->yr ; y++) {
+      for (int x = 0; x < gSim->xr ; x++) {
 	//adopted from the CMESH, the first node has 0,1,8,9 (as an example)
-	int link = (xcount * xrouter) * (yrouter * y_index + y) + (xrouter * x_index + x) ;
+	int link = (gSim->x * gSim->xr) * (gSim->yr * y_index + y) + (gSim->xr * x_index + x) ;
 	//	_inject[link]->SetLatency(ileng);
 	//_inject_cred[link]->SetLatency(ileng);
 	//_eject[link] ->SetLatency(ileng);
@@ -194,8 +194,8 @@ void MECS::_BuildNet( const Configuration &config ) {
     int link = -1;
     int x_location = -1; //where the router is ... 0,0 is northwest
     int y_location = -1;
-    x_location = node%gK;
-    y_location = (int)(node/gK);
+    x_location = node%gSim->k;
+    y_location = (int)(node/gSim->k);
 
     //the MECSRouters has many non-standard methods....
     MECSRouter* cur = dynamic_cast<MECSRouter*>(_routers[node]);
@@ -212,10 +212,10 @@ void MECS::_BuildNet( const Configuration &config ) {
 	drops = y_location;
 	break;
       case 1:
-	drops = gK-1-x_location;
+	drops = gSim->k-1-x_location;
 	break;
       case 2:
-	drops = gK-1-y_location;
+	drops = gSim->k-1-y_location;
 	break;
       case 3:
 	drops = x_location;
@@ -271,7 +271,7 @@ void MECS::_BuildNet( const Configuration &config ) {
 #endif
       }
     }
-    assert(output_added == (gK-1)*2);
+    assert(output_added == (gSim->k-1)*2);
     //connec the channels to the underlying iq_router in a MECSRouter
     cur->Finalize();
   }
@@ -293,12 +293,12 @@ void dor_MECS( const Router *r, const Flit *f, int in_channel,
   bool debug = f->watch;
 
   int rID = r->GetID();
-  int r_x_location = (int)(rID%gK);
-  int r_y_location = (int)(rID/gK);
+  int r_x_location = (int)(rID%gSim->k);
+  int r_y_location = (int)(rID/gSim->k);
   int dest = mecs_transformation(f->dest);
-  int dest_router = (int)(dest/gK);
-  int dest_x_location = (int)(dest_router%gK);
-  int dest_y_location = (int)(dest_router/gK);
+  int dest_router = (int)(dest/gSim->k);
+  int dest_x_location = (int)(dest_router%gSim->k);
+  int dest_y_location = (int)(dest_router/gSim->k);
 
 
  int intm = 0;
@@ -306,55 +306,55 @@ void dor_MECS( const Router *r, const Flit *f, int in_channel,
 
   //at destination
   if(rID == dest_router){
-    out_port = dest%gK; 
+    out_port = dest%gSim->k; 
     if(debug)
       {
-	*gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		    <<f->id<<" Routing to final destination outport "<<out_port<<endl;}
     goto dor_done;
   }
   
   //at first injection
-  if(in_channel<gK){
+  if(in_channel<gSim->k){
     f->ph = 0;
     if(debug)
       {
-	*gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		    <<f->id<<" Injected "<<endl;}
     //already in the same X
     if(r_x_location == dest_x_location){
       if(debug)
 	{
-	  *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		      <<f->id<<" Switching to Y"<<endl;}
       f->intm = -1;
       f->ph = 1;
     } else {
-      f->intm = (xcount * xrouter) * (yrouter * r_y_location) + (xrouter * dest_x_location) ;
+      f->intm = (gSim->x * gSim->xr) * (gSim->yr * r_y_location) + (gSim->xr * dest_x_location) ;
     }
   }
 
   intm = mecs_transformation(f->intm);
-  intm_router = (int)(intm/gK);
+  intm_router = (int)(intm/gSim->k);
   if(f->ph == 0){
     //switch over to Y dmension
     if(rID == intm_router){
       if(debug)
 	{
-	  *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		      <<f->id<<" Switching to Y"<<endl;}
       f->intm = -1;
       f->ph = 1;
     } else {
-      assert(in_channel<gK);//should only get here on injection
+      assert(in_channel<gSim->k);//should only get here on injection
       if(dest_x_location>r_x_location){ //east
-	out_port = gK+1;
+	out_port = gSim->k+1;
       } else { //west
-	out_port = gK+3;
+	out_port = gSim->k+3;
       }
       if(debug)
 	{
-	  *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		      <<f->id<<" Routing in X direction"<<out_port<<endl;}
       goto dor_done;
     }
@@ -362,13 +362,13 @@ void dor_MECS( const Router *r, const Flit *f, int in_channel,
 
   if(f->ph== 1){
     if(dest_y_location>r_y_location){ //south
-      out_port = gK+2;
+      out_port = gSim->k+2;
     } else {//north
-      out_port = gK;
+      out_port = gSim->k;
     }
     if(debug)
       {
-	*gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		    <<f->id<<" Routing in Y direction"<<out_port<<endl;}
     goto dor_done;
   }
@@ -376,15 +376,15 @@ void dor_MECS( const Router *r, const Flit *f, int in_channel,
 
  dor_done:
   if (f->type == Flit::READ_REQUEST)
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
+    outputs->AddRange( out_port, gSim->read_req_begin_vc, gSim->read_req_end_vc );
   if (f->type == Flit::WRITE_REQUEST)
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
+    outputs->AddRange( out_port, gSim->write_req_begin_vc, gSim->write_req_end_vc );
   if (f->type ==  Flit::READ_REPLY)
-    outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
+    outputs->AddRange( out_port, gSim->read_reply_begin_vc, gSim->read_reply_end_vc );
   if (f->type ==  Flit::WRITE_REPLY)
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
+    outputs->AddRange( out_port, gSim->write_reply_begin_vc, gSim->write_reply_end_vc );
   if (f->type ==  Flit::ANY_TYPE)
-    outputs->AddRange( out_port, 0, gNumVCS-1 );
+    outputs->AddRange( out_port, 0, gSim->num_vcs-1 );
 }
 
 int mecs_transformation(int dest){
@@ -397,14 +397,14 @@ int mecs_transformation(int dest){
   //cout<<"ORiginal destination "<<dest<<endl;
   //router in the x direction = find which column, and then mod by cY to find 
   //which horizontal router
-  int horizontal = (dest%(xcount*xrouter))/(xrouter);
-  int horizontal_rem = (dest%(xcount*xrouter))%(xrouter);
+  int horizontal = (dest%(gSim->x*gSim->xr))/(gSim->xr);
+  int horizontal_rem = (dest%(gSim->x*gSim->xr))%(gSim->xr);
   //router in the y direction = find which row, and then divided by cX to find 
   //vertical router
-  int vertical = (dest/(xcount*xrouter))/(yrouter);
-  int vertical_rem = (dest/(xcount*xrouter))%(yrouter);
+  int vertical = (dest/(gSim->x*gSim->xr))/(gSim->yr);
+  int vertical_rem = (dest/(gSim->x*gSim->xr))%(gSim->yr);
   //transform the destination to as if node0 was 0,1,2,3 and so forth
-  dest = (vertical*xcount + horizontal)*gC+xrouter*vertical_rem+horizontal_rem;
+  dest = (vertical*gSim->x + horizontal)*gSim->c+gSim->xr*vertical_rem+horizontal_rem;
   //cout<<"Transformed destination "<<dest<<endl<<endl;
   return dest;
 }
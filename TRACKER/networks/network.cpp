@@ -38,7 +38,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "booksim.hpp"
 #include <assert.h>
 #include "network.hpp"
+#include "vc.hpp"
 #include <cmath>
+#include <algorithm>
 
 
 // constructor and destructor....... of Network class
@@ -48,6 +50,12 @@ Network::Network( const Configuration &config, const string & name ) :  Module(
 	  _sources  = -1; 
 	  _dests    = -1;
 	  _channels = -1;
+	  _stepper  = 0;
+	  _skip_idle = false;
+	  _clock.cycles = _clock.steps = _clock.decays = _clock.decays_prev = 0;
+	  _clock.written = -1;
+	  _clock.next = 0;
+	  _asleep_vcs = 0;
 }
 
 Network::~Network( )
@@ -98,6 +106,12 @@ Network::~Network( )
 		//**********************************
 	  	cout<<"LUF= "<<ff<<endl;
 		//**********************************
+	  if ( _stepper ) delete _stepper;
+	  for ( int r = 0; r < _size; ++r )
+	  {
+		    // catch up the activity counters printed by the routers
+		    if ( _routers[r] && _routers[r]->Asleep( ) ) _routers[r]->Wake( );
+	  }
 	  for ( int r = 0; r < _size; ++r )
 	  {
 	    	   
@@ -135,7 +149,7 @@ void Network::_Alloc( )
 	// allocating flit channel and credit channel for each source destination and channel
 	assert( ( _size != -1 ) && ( _sources != -1 ) &&  ( _dests != -1 ) &&  ( _channels != -1 ) ); // abort if result!=0
 	_routers.resize(_size);
-	gNodes = _sources;
+	gSim->nodes = _sources;
 	  /*booksim used arrays of flits as the channels which makes have capacity of 
 	   *one. To simulate channel latency, flitchannel class has been added
 	   *which are fifos with depth = channel latency and each cycle the channel
@@ -164,7 +178,6 @@ void Network::_Alloc( )
 	    	_chan_cred[c] = new CreditChannel;
 	}
 
-	_chan_use.resize(_channels, 0);
 	_chan_use_cycles = 0;
 	//cout<<"end-alloc"<<endl;
 
@@ -180,79 +193,223 @@ int Network::NumDests( ) const
 	return _dests;
 }
 
-void Network::ReadInputs( )
+// router_threads >= 1 steps the routers on a thread pool; neighbours then
+// read each other's metric snapshots, so results do not depend on the
+// thread count (but differ from serial stepping, router_threads = 0)
+void Network::SetRouterThreads( int threads, long seed )
 {
-	 for ( int r = 0; r < _size; ++r )
-	 {
-	    	_routers[r]->ReadInputs( );
-	 }
+	if ( threads <= 0 )
+		return;
+	_stepper = new ParallelStepper( _routers, threads, seed );
+	for ( int r = 0; r < _size; ++r )
+	{
+		_routers[r]->UseMetricSnapshots( true );
+	}
+	UseOwnSelectHistory( );
 }
 
-void Network::InternalStep( )
+// routers stepped on other threads than the rest of the simulation keep
+// their own selection history, so it does not depend on the thread count
+void Network::UseOwnSelectHistory( )
 {
-	 for ( int r = 0; r < _size; ++r )
-	 {
-	    	_routers[r]->InternalStep( );
-	 }
+	for ( int r = 0; r < _size; ++r )
+	{
+		_routers[r]->UseOwnSelectHistory( );
+	}
 }
-void Network::update_wnof_values()
+
+// skip_idle_routers steps only the routers with flits or credits to handle;
+// the others sleep and catch up when they wake, so results are unchanged
+void Network::SetSkipIdle( bool skip )
 {
-	//for wnof
+	_skip_idle = skip;
 	for ( int r = 0; r < _size; ++r )
 	{
-		_routers[r]->update_wnof_values();
+		_routers[r]->UseSleepClock( &_clock, r );
 	}
-	
+	_awake = _routers;
 }
-void Network::update_nop_values()
+
+// event_driven goes further: the channels carry due times instead of a
+// slot per cycle, so sleeping routers are left alone until a timing wheel
+// wakes them for their next flit or credit; results are still unchanged
+void Network::SetEventDriven( )
 {
-	//for nop
-	for ( int r = 0; r < _size; ++r )
+	SetSkipIdle( true );
+	int latency = 0;
+	for ( int s = 0; s < _sources; ++s )
+		latency = max( latency, max( _inject[s]->GetLatency( ), _inject_cred[s]->GetLatency( ) ) );
+	for ( int d = 0; d < _dests; ++d )
+		latency = max( latency, max( _eject[d]->GetLatency( ), _eject_cred[d]->GetLatency( ) ) );
+	for ( int c = 0; c < _channels; ++c )
+		latency = max( latency, max( _chan[c]->GetLatency( ), _chan_cred[c]->GetLatency( ) ) );
+	// wake-ups are at most latency + 1 cycles ahead
+	int slots = 1;
+	while ( slots < latency + 2 )
+		slots <<= 1;
+	_clock.wheel.resize( slots );
+
+	// the traffic manager reads ejected flits and returns their credits
+	// after WriteOutputs has ended the cycle
+	for ( int s = 0; s < _sources; ++s )
 	{
-		_routers[r]->update_nop_values();
+		_inject[s]->SetClock( &_clock.cycles, &_clock.cycles );
+		_inject_cred[s]->SetClock( &_clock.cycles, &_clock.cycles );
+	}
+	for ( int d = 0; d < _dests; ++d )
+	{
+		_eject[d]->SetClock( &_clock.cycles, &_clock.written );
+		_eject_cred[d]->SetClock( &_clock.written, &_clock.cycles );
+	}
+	for ( int c = 0; c < _channels; ++c )
+	{
+		_chan[c]->SetClock( &_clock.cycles, &_clock.cycles );
+		_chan_cred[c]->SetClock( &_clock.cycles, &_clock.cycles );
 	}
-	
 }
 
-void Network::Clear_has_input()	//fluidity
+static bool _BySleepIndex( const Router *a, const Router *b )
 {
+	return a->SleepIndex( ) < b->SleepIndex( );
+}
+
+// starts a cycle: wakes the sleeping routers something was sent to and
+// ticks the channels of the others, or on a timed clock wakes those due
+void Network::WakeRouters( )
+{
+	if ( !_skip_idle )
+		return;
+	if ( _clock.Timed( ) )
+	{
+		vector<int> &due = _clock.wheel[_clock.cycles & ( _clock.wheel.size( ) - 1 )];
+		_clock.next = _clock.cycles + 1;
+		size_t awake = _awake.size( );
+		for ( size_t i = 0; i < due.size( ); ++i )
+		{
+			Router *router = _routers[due[i]];
+			if ( !router->WakeDue( _clock.cycles ) )
+				continue;	// woken earlier
+			router->Wake( );
+			_asleep_vcs -= router->IdleVCs( );
+			_awake.push_back( router );
+		}
+		due.clear( );
+		// keep the serial stepping order
+		if ( _awake.size( ) != awake )
+			sort( _awake.begin( ), _awake.end( ), _BySleepIndex );
+		return;
+	}
+	_awake.clear( );
+	_asleep_vcs = 0;
 	for ( int r = 0; r < _size; ++r )
+	{
+		Router *router = _routers[r];
+		if ( router->Asleep( ) )
 		{
-			_routers[r]->Clear_has_input();
+			if ( !router->Woken( ) )
+			{
+				router->IdleTick( );
+				_asleep_vcs += router->IdleVCs( );
+				continue;
+			}
+			router->Wake( );
 		}
+		_awake.push_back( router );
+	}
+}
+
+void Network::_StepRouters( ParallelStepper::tPhase phase )
+{
+	if ( _stepper )
+	{
+		_stepper->Run( phase );
+		return;
+	}
+	const vector<Router *> &routers = _skip_idle ? _awake : _routers;
+	for ( size_t r = 0; r < routers.size( ); ++r )
+	{
+		( routers[r]->*phase )( );
+	}
+}
+
+void Network::ReadInputs( )
+{
+	_StepRouters( &Router::ReadInputs );
+}
+
+void Network::InternalStep( )
+{
+	_StepRouters( &Router::InternalStep );
+	if ( _skip_idle )
+	{
+		++_clock.steps;
+		VC::CountIdle( _asleep_vcs );
+	}
+}
+void Network::update_wnof_values()
+{
+	//for wnof
+	_StepRouters( &Router::update_wnof_values );
+}
+void Network::update_nop_values()
+{
+	//for nop
+	_StepRouters( &Router::update_nop_values );
+}
+
+void Network::Clear_has_input()	//fluidity
+{
+	_StepRouters( &Router::Clear_has_input );
 }
 
 void Network::Update_cum_time_out()
+{
+	_StepRouters( &Router::Update_cum_time_out );
+}
+
+// sleeping routers apply the decay when they are read or woken
+void Network::Update_cum_flits()
 {
 	for ( int r = 0; r < _size; ++r )
 	{
-		_routers[r]->Update_cum_time_out();
+		if ( !_routers[r]->Asleep( ) )
+			_routers[r]->Update_cum_flits( );
 	}
-	
+	++_clock.decays;
 }
 
 
 void Network::WriteOutputs( )
 {
-	 for ( int r = 0; r < _size; ++r )
-	 {
-	    	_routers[r]->WriteOutputs( );
-	 }
+	_StepRouters( &Router::WriteOutputs );
 
-  	for ( int c = 0; c < _channels; ++c )
-	{
-    		if ( _chan[c]->InUse() )
-		 {
-      			_chan_use[c]++;
-    		 }
-  	}
   	_chan_use_cycles++;
   	
-  	for( int r=0; r< _size; r++)	//fluidity
-  	{
-  		_routers[r]->Update_fluidity();
-  	}
-  		
+  	_StepRouters( &Router::Update_fluidity );	//fluidity
+
+	if ( _skip_idle )
+	{
+		_clock.written = _clock.cycles++;
+		_clock.decays_prev = _clock.decays;
+		for ( size_t r = 0; r < _awake.size( ); ++r )
+		{
+			if ( _awake[r]->Quiescent( ) )
+				_awake[r]->Sleep( );
+		}
+		if ( _clock.Timed( ) )
+		{
+			// nothing ticks the sleepers, drop them until the wheel wakes them
+			size_t kept = 0;
+			for ( size_t r = 0; r < _awake.size( ); ++r )
+			{
+				if ( _awake[r]->Asleep( ) )
+					_asleep_vcs += _awake[r]->IdleVCs( );
+				else
+					_awake[kept++] = _awake[r];
+			}
+			_awake.resize( kept );
+		}
+	}
 }
 void Network::WriteFlit( Flit *f, int source )
 {
@@ -266,6 +423,11 @@ Flit *Network::ReadFlit( int dest )
   return _eject[dest]->Receive();
 }
 
+bool Network::Ejecting( int dest ) const
+{
+	  return _eject[dest]->InFlight( );
+}
+
 /* new functions added for NOC
  */
 Flit* Network::PeekFlit( int dest ) 
@@ -324,9 +486,13 @@ void Network::Display( ) const
 	  double average = 0;
 	  for ( int c = 0; c < _channels; ++c )
 	 {
-	    	cout << "channel " << c << " used " << 100.0 * (double)_chan_use[c] / (double)_chan_use_cycles 
+		int used = 0;	// flits sent, one per cycle at most
+		int *active = _chan[c]->GetActivity( );
+		for ( int t = 0; t < Flit::NUM_FLIT_TYPES; ++t )
+			used += active[t];
+	    	cout << "channel " << c << " used " << 100.0 * (double)used / (double)_chan_use_cycles 
 		 << "% of the time" << endl;
-	   	average += 100.0 * (double)_chan_use[c] / (double)_chan_use_cycles ;
+	   	average += 100.0 * (double)used / (double)_chan_use_cycles ;
 	  }
 	  average = average/_channels;
 	  cout<<"Average channel: "<<average<<endl;
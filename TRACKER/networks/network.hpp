@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "channel.hpp"
 #include "config_utils.hpp"
 #include "globals.hpp"
+#include "parallelstep.hpp"
 
 typedef Channel<Credit> CreditChannel;
 
@@ -65,9 +66,18 @@ protected:
   vector<FlitChannel *> _chan;
   vector<CreditChannel *> _chan_cred;
 
-  vector<int> _chan_use;
   int _chan_use_cycles;
 
+  ParallelStepper *_stepper;   // 0 when routers are stepped serially
+
+  // with _skip_idle only the routers in _awake are stepped
+  bool _skip_idle;
+  SleepClock _clock;
+  vector<Router *> _awake;
+  int _asleep_vcs;              // VCs of the sleeping routers
+
+  void _StepRouters( ParallelStepper::tPhase phase );
+
   virtual void _ComputeSize( const Configuration &config ) = 0;
   virtual void _BuildNet( const Configuration &config ) = 0;
 
@@ -80,6 +90,7 @@ public:
   virtual void WriteFlit( Flit *f, int source );
   virtual Flit *ReadFlit( int dest );
   virtual Flit *PeekFlit( int dest );
+  bool Ejecting( int dest ) const;   // a flit on its way out at dest
 
   virtual void    WriteCredit( Credit *c, int dest );
   virtual Credit *ReadCredit( int source );
@@ -93,6 +104,12 @@ public:
 
   virtual double Capacity( ) const;
 
+  void SetRouterThreads( int threads, long seed );
+  void UseOwnSelectHistory( );
+  void SetSkipIdle( bool skip );
+  void SetEventDriven( );
+  void WakeRouters( );
+
   virtual void ReadInputs( );
   virtual void InternalStep( );
   virtual void WriteOutputs( );
@@ -102,6 +119,7 @@ public:
   void update_nop_values();
  void Clear_has_input();//fluidity
   void Update_cum_time_out();
+  void Update_cum_flits();
   void Display( ) const;
 
   int NumChannels(){return _channels;}
@@ -72,7 +72,7 @@ void Tree4::_ComputeSize( const Configuration& config )
 
   assert( _k == 4 && _n == 3 );
   
-  gK = _k; gN = _n;
+  gSim->k = _k; gSim->n = _n;
   
   _sources = powi( _k, _n );
   _dests   = powi( _k, _n );
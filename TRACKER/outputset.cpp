@@ -41,14 +41,46 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "outputset.hpp"
 
-OutputSet::OutputSet( int num_outputs )
+OutputSet::SetList::SetList( int capacity ) :
+  _elems( _inline ), _size( 0 ), _capacity( SET_INLINE )
+{
+  if ( capacity > SET_INLINE ) {
+    _elems    = new sSetElement [capacity];
+    _capacity = capacity;
+  }
+}
+
+OutputSet::SetList::~SetList( )
+{
+  if ( _elems != _inline ) {
+    delete [] _elems;
+  }
+}
+
+void OutputSet::SetList::push_back( const sSetElement& s )
+{
+  if ( _size == _capacity ) {
+    sSetElement *elems = new sSetElement [2 * _capacity];
+    for ( int i = 0; i < _size; ++i ) {
+      elems[i] = _elems[i];
+    }
+    if ( _elems != _inline ) {
+      delete [] _elems;
+    }
+    _elems     = elems;
+    _capacity *= 2;
+  }
+  _elems[_size++] = s;
+}
+
+// one range per output is the common case
+OutputSet::OutputSet( int num_outputs ) :
+  _outputs( num_outputs )
 {
-  _outputs.clear();
 }
 
 OutputSet::~OutputSet( )
 {
-  _outputs.clear( );
 }
 
 void OutputSet::Clear( )
@@ -77,7 +109,7 @@ void OutputSet::AddRange( int output_port, int vc_start, int vc_end, int pri )//
 int OutputSet::NumVCs( int output_port ) const
 {
   int total = 0;
-  list<sSetElement>::const_iterator i = _outputs.begin( );
+  SetList::const_iterator i = _outputs.begin( );
   while(i!=_outputs.end( )){
     if(i->output_port == output_port){
       total += (i->vc_end - i->vc_start + 1);
@@ -94,7 +126,7 @@ int OutputSet::Size( ) const
 
 bool OutputSet::OutputEmpty( int output_port ) const
 {
-  list<sSetElement>::const_iterator i = _outputs.begin( );
+  SetList::const_iterator i = _outputs.begin( );
   while(i!=_outputs.end( )){
     if(i->output_port == output_port){
       return false;
@@ -105,7 +137,7 @@ bool OutputSet::OutputEmpty( int output_port ) const
 }
 
 
-const list<OutputSet::sSetElement>* OutputSet::GetSetList() const{
+const OutputSet::SetList* OutputSet::GetSetList() const{
   return &_outputs;
 }
 
@@ -119,7 +151,7 @@ int OutputSet::GetVC( int output_port, int vc_index, int *pri ) const
   
   if ( pri ) { *pri = -1; }
 
-  list<sSetElement>::const_iterator i = _outputs.begin( );
+  SetList::const_iterator i = _outputs.begin( );
   while(i!=_outputs.end( )){
     if(i->output_port == output_port){
       range = i->vc_end - i->vc_start + 1;
@@ -146,7 +178,7 @@ bool OutputSet::GetPortVC( int *out_port, int *out_vc ) const
   bool single_output = false;
   int  used_outputs  = 0;
 
-  list<sSetElement>::const_iterator i = _outputs.begin( );
+  SetList::const_iterator i = _outputs.begin( );
   if(i!=_outputs.end( )){
     used_outputs = i->output_port;
   }
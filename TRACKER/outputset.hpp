@@ -32,7 +32,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define _OUTPUTSET_HPP_
 
 #include <queue>
-#include <list>
+
+#define SET_INLINE 8
 
 class OutputSet {
 
@@ -44,6 +45,34 @@ public:
     int pri;
     int output_port;
   };
+
+  // the ranges in the order they were added, held inline for the usual
+  // router radix so routing does not allocate
+  class SetList {
+  public:
+    typedef const sSetElement *const_iterator;
+
+    SetList( int capacity );
+    ~SetList( );
+
+    const_iterator begin( ) const { return _elems; }
+    const_iterator end( ) const { return _elems + _size; }
+    int  size( ) const { return _size; }
+    bool empty( ) const { return _size == 0; }
+
+    void clear( ) { _size = 0; }
+    void push_back( const sSetElement& s );
+
+  private:
+    sSetElement  _inline[SET_INLINE];
+    sSetElement *_elems;
+    int          _size;
+    int          _capacity;
+
+    SetList( const SetList& );
+    SetList& operator=( const SetList& );
+  };
+
   OutputSet( int num_outputs );
   ~OutputSet( );
 
@@ -55,12 +84,12 @@ public:
   bool OutputEmpty( int output_port ) const;
   int NumVCs( int output_port ) const;
   
-  const list<sSetElement>* GetSetList() const;
+  const SetList* GetSetList() const;
 
   int  GetVC( int output_port,  int vc_index, int *pri = 0 ) const;
   bool GetPortVC( int *out_port, int *out_vc ) const;
 private:
-  list<sSetElement> _outputs;
+  SetList _outputs;
 };
 
 #endif
@@ -0,0 +1,177 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*parallelstep.cpp
+ *
+ *Thread pools that step the routers of a network, or the physical
+ *subnetworks of a traffic manager, phase by phase
+ *
+ */
+
+#include "booksim.hpp"
+#include "parallelstep.hpp"
+#include "vc.hpp"
+#include "globals.hpp"
+
+// spins before a waiting thread starts yielding its core
+#define SPIN_LIMIT 4096
+
+PhasePool::PhasePool( ) :
+  _threads( 1 ), _sim( gSim ), _generation( 0 ), _pending( 0 ), _stop( false )
+{
+}
+
+PhasePool::~PhasePool( )
+{
+  _stop.store( true );
+  _generation.fetch_add( 1, memory_order_release );
+  for ( size_t t = 0; t < _workers.size( ); ++t ) {
+    _workers[t].join( );
+  }
+}
+
+void PhasePool::_Start( int threads )
+{
+  _threads = threads;
+  for ( int t = 1; t < _threads; ++t ) {
+    _workers.push_back( thread( &PhasePool::_Worker, this, t ) );
+  }
+}
+
+void PhasePool::_Worker( int t )
+{
+  int seen = 0;
+
+  gSim = _sim;
+
+  while ( true ) {
+    int spins = 0;
+    while ( _generation.load( memory_order_acquire ) == seen ) {
+      if ( ++spins > SPIN_LIMIT ) {
+	this_thread::yield( );
+      }
+    }
+    ++seen;
+    if ( _stop.load( ) ) {
+      break;
+    }
+    _RunBlock( t );
+    _pending.fetch_sub( 1, memory_order_release );
+  }
+}
+
+void PhasePool::_RunPhase( )
+{
+  _pending.store( _threads - 1, memory_order_relaxed );
+  _generation.fetch_add( 1, memory_order_release );
+
+  _RunBlock( 0 );
+
+  int spins = 0;
+  while ( _pending.load( memory_order_acquire ) > 0 ) {
+    if ( ++spins > SPIN_LIMIT ) {
+      this_thread::yield( );
+    }
+  }
+}
+
+// splits size items into threads contiguous blocks, at most one per item
+static int _SplitBlocks( int size, int threads, vector<int> &first )
+{
+  if ( threads > size ) {
+    threads = size;
+  }
+  if ( threads < 1 ) {
+    threads = 1;
+  }
+
+  first.resize( threads + 1 );
+  for ( int t = 0; t <= threads; ++t ) {
+    first[t] = ( t * size ) / threads;
+  }
+  return threads;
+}
+
+ParallelStepper::ParallelStepper( const vector<Router *> &routers, int threads, long seed ) :
+  _routers( routers )
+{
+  int size = _routers.size( );
+
+  threads = _SplitBlocks( size, threads, _first );
+
+  // seeded from (seed, router) and not from the global stream, which
+  // the traffic keeps using as in serial runs
+  for ( int r = 0; r < size; ++r ) {
+    _streams.push_back( RandomStream( ( (unsigned long long)seed << 32 ) ^ r ) );
+  }
+
+  _Start( threads );
+}
+
+void ParallelStepper::_RunBlock( int t )
+{
+  // the caller may be a subnetwork thread with its own stream
+  RandomStream *outer = gRandomStream;
+
+  for ( int r = _first[t]; r < _first[t+1]; ++r ) {
+    gRandomStream = &_streams[r];
+    ( _routers[r]->*_phase )( );
+  }
+  gRandomStream = outer;
+  VC::FlushStats( );
+}
+
+void ParallelStepper::Run( tPhase phase )
+{
+  _phase = phase;
+  _RunPhase( );
+}
+
+SubnetStepper::SubnetStepper( int nets, int threads, long seed, const tStep &step ) :
+  _step( step )
+{
+  threads = _SplitBlocks( nets, threads, _first );
+
+  // complemented seed, so these never coincide with the router streams
+  for ( int n = 0; n < nets; ++n ) {
+    _streams.push_back( RandomStream( ( (unsigned long long)~seed << 32 ) ^ n ) );
+  }
+
+  _Start( threads );
+}
+
+void SubnetStepper::_RunBlock( int t )
+{
+  for ( int n = _first[t]; n < _first[t+1]; ++n ) {
+    gRandomStream = &_streams[n];
+    _step( n );
+  }
+  gRandomStream = 0;
+  VC::FlushStats( );
+}
@@ -0,0 +1,128 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _PARALLELSTEP_HPP_
+#define _PARALLELSTEP_HPP_
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+#include "router.hpp"
+#include "random_utils.hpp"
+
+using namespace std;
+
+class SimContext;
+
+//runs one phase of work on a pool of threads
+//
+//Every call to _RunPhase runs _RunBlock( t ) for each thread t and
+//returns once all blocks are done, so phases are separated by a barrier.
+//The calling thread runs block 0 itself, a pool of threads - 1 workers
+//takes the rest. Workers run with the SimContext of the creating thread.
+class PhasePool {
+  int _threads;
+  SimContext *_sim;               // the creating thread's, used by all
+
+  vector<thread> _workers;
+
+  atomic<int>       _generation;  // bumped to start a phase
+  atomic<int>       _pending;     // workers still running the phase
+  atomic<bool>      _stop;
+
+  void _Worker( int t );
+
+protected:
+  // called at the end of the derived constructor, once _RunBlock is safe
+  void _Start( int threads );
+  void _RunPhase( );
+
+  virtual void _RunBlock( int t ) = 0;
+
+public:
+  PhasePool( );
+  virtual ~PhasePool( );
+
+  int NumThreads( ) const { return _threads; }
+};
+
+//steps the routers of one network on a pool of threads
+//
+//Each thread runs a phase on its own contiguous block of routers.
+//Routers only touch their own state inside a phase, and what they read
+//from their neighbours is a snapshot taken by an earlier phase (see
+//Router::UseMetricSnapshots). Each router also draws from its own random
+//stream, so results are the same for any number of threads.
+class ParallelStepper : public PhasePool {
+public:
+  typedef void (Router::*tPhase)( );
+
+private:
+  const vector<Router *> &_routers;
+
+  vector<int>          _first;    // block t is [_first[t], _first[t+1])
+  vector<RandomStream> _streams;  // one per router
+
+  tPhase _phase;
+
+  void _RunBlock( int t );
+
+public:
+  ParallelStepper( const vector<Router *> &routers, int threads, long seed );
+
+  void Run( tPhase phase );
+};
+
+//steps the physical subnetworks of a traffic manager on a pool of threads
+//
+//Subnetworks share no routers or channels, so each one can be advanced
+//on its own thread; the caller merges injection and ejection afterwards.
+//Each subnetwork draws from its own random stream, so results are the
+//same for any number of threads.
+class SubnetStepper : public PhasePool {
+public:
+  typedef function<void ( int )> tStep;
+
+private:
+  tStep _step;
+
+  vector<int>          _first;    // block t is [_first[t], _first[t+1])
+  vector<RandomStream> _streams;  // one per subnetwork
+
+  void _RunBlock( int t );
+
+public:
+  SubnetStepper( int nets, int threads, long seed, const tStep &step );
+
+  void Run( ) { _RunPhase( ); }
+};
+
+#endif
@@ -0,0 +1,274 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*pathselect.cpp
+ *
+ *Injection-time path selection among the route table's candidate paths.
+ *The cost of a path is the sum of the snapshot cost of every router output
+ *it leaves on, using the same router metrics as the hop-by-hop selection
+ *functions in iq_router_baseline.cpp:
+ *
+ *  nof        weighted number of flits routed on the port (_weighted_NOF)
+ *  nop        free VCs downstream of the port, fewer is worse
+ *  tracker    time flits spend past the port (cum_time_out_router)
+ *  fluidity   fluidity of the downstream input, less is worse
+ *
+ *Only ports leading to another router, within the ports the routers keep
+ *metrics for (Router::METRIC_PORTS), cost anything; ejection ports and the
+ *extra ports of wider routers cost 0.
+ *
+ *The round_robin, flow_hash and weighted policies spread a pair's packets
+ *over its paths. Deadlock freedom comes from the route table, which
+ *rejects candidate sets whose channel dependencies form a cycle.
+ */
+
+#include "booksim.hpp"
+#include <iostream>
+#include <stdlib.h>
+
+#include "pathselect.hpp"
+#include "random_utils.hpp"
+#include "router.hpp"
+#include "globals.hpp"
+
+PathSelector::PathSelector( const Configuration &config, const vector<Network *> &net,
+			    const RouteTable *table )
+  : _table(table), _net(net)
+{
+  string selection, metric;
+
+  config.GetStr( "path_selection", selection );
+  config.GetStr( "path_congestion_metric", metric );
+  _period = config.GetInt( "path_congestion_period" );
+
+  if ( selection == "first" ) {
+    _policy = first;
+  } else if ( selection == "congestion" ) {
+    _policy = congestion;
+  } else if ( selection == "round_robin" ) {
+    _policy = round_robin;
+  } else if ( selection == "flow_hash" ) {
+    _policy = flow_hash;
+  } else if ( selection == "weighted" ) {
+    _policy = weighted;
+  } else {
+    cout << "Error: Unknown path_selection '" << selection << "'." << endl;
+    exit(-1);
+  }
+
+  if ( metric == "nof" ) {
+    _metric = nof;
+  } else if ( metric == "nop" ) {
+    _metric = nop;
+  } else if ( metric == "tracker" ) {
+    _metric = tracker;
+  } else if ( metric == "fluidity" ) {
+    _metric = fluidity;
+  } else {
+    cout << "Error: Unknown path_congestion_metric '" << metric << "'." << endl;
+    exit(-1);
+  }
+
+  if ( _period < 1 ) {
+    cout << "Error: path_congestion_period must be at least 1." << endl;
+    exit(-1);
+  }
+
+  const vector<Router *> &routers = _net[0]->GetRouters( );
+  int num_routers = _net[0]->NumRouters( );
+
+  _ports = 0;
+  for ( int r = 0; r < num_routers; ++r ) {
+    if ( routers[r]->NumOutputs( ) > _ports ) {
+      _ports = routers[r]->NumOutputs( );
+    }
+  }
+
+  _start_router.resize( _table->NumNodes( ) );
+  for ( int n = 0; n < _table->NumNodes( ); ++n ) {
+    _start_router[n] = _net[0]->GetInject( )[n]->GetSink( );
+  }
+
+  _next_router.resize( num_routers * _ports, -1 );
+  _next_input.resize( num_routers * _ports, -1 );
+  for ( int r = 0; r < num_routers; ++r ) {
+    for ( int port = 0; port < routers[r]->NumOutputs( ); ++port ) {
+      int next = routers[r]->GetOutputChannel( port )->GetSink( );
+      if ( next < 0 ) {
+	continue;
+      }
+      _next_router[r * _ports + port] = next;
+      for ( int in = 0; in < routers[next]->NumInputs( ); ++in ) {
+	if ( routers[next]->GetInputChannel( in ) == routers[r]->GetOutputChannel( port ) ) {
+	  _next_input[r * _ports + port] = in;
+	}
+      }
+    }
+  }
+
+  if ( _policy == round_robin ) {
+    _next_path.resize( _table->NumNodes( ) * _table->NumNodes( ), 0 );
+  }
+
+  _cost.resize( _net.size( ) );
+  for ( unsigned int s = 0; s < _net.size( ); ++s ) {
+    _cost[s].resize( num_routers * _ports, 0 );
+  }
+}
+
+int PathSelector::_PortCost( int subnet, Router *router, int port ) const
+{
+  int r    = router->GetID( );
+  int next = _next_router[r * _ports + port];
+  if ( ( next < 0 ) || ( port >= Router::METRIC_PORTS ) ) {
+    return 0;
+  }
+
+  switch ( _metric ) {
+  case nof:
+    return router->get_wnof_old( )[port];
+  case nop:
+    return -router->get_free_vcs_old( )[port];
+  case tracker:
+    return router->get_out_time( )[port];
+  case fluidity:
+    {
+      int in = _next_input[r * _ports + port];
+      if ( in >= Router::FLUIDITY_PORTS ) {
+	return 0;
+      }
+      Router *next_router = _net[subnet]->GetRouters( )[next];
+      int sum = 0;
+      for ( int k = 0; k < 4; ++k ) {
+	sum += next_router->fluidity[in][k];
+      }
+      return -sum;
+    }
+  }
+  return 0;
+}
+
+void PathSelector::Refresh( int time )
+{
+  if ( ( ( _policy != congestion ) && ( _policy != weighted ) ) || ( time % _period ) ) {
+    return;
+  }
+
+  for ( unsigned int s = 0; s < _net.size( ); ++s ) {
+    const vector<Router *> &routers = _net[s]->GetRouters( );
+    for ( int r = 0; r < _net[s]->NumRouters( ); ++r ) {
+      for ( int port = 0; port < routers[r]->NumOutputs( ); ++port ) {
+	_cost[s][r * _ports + port] = _PortCost( s, routers[r], port );
+      }
+    }
+  }
+}
+
+int PathSelector::_PathCost( int subnet, int src, int dest, int path ) const
+{
+  SourceRouteCursor cursor;
+  cursor.Start( _table->Format( ), _table->Words( src, dest, path ),
+		_table->Length( src, dest, path ) );
+
+  int r    = _start_router[src];
+  int cost = 0;
+
+  for ( int hop = 0; ( hop < cursor.length ) && ( r >= 0 ); ++hop ) {
+    int port = cursor.Pop( );
+    cost += _cost[subnet][r * _ports + port];
+    r = _next_router[r * _ports + port];
+  }
+  return cost;
+}
+
+int PathSelector::Select( int subnet, int src, int dest, int cl )
+{
+  int paths = _table->NumPaths( src, dest );
+
+  if ( paths == 1 ) {
+    return 0;
+  }
+
+  switch ( _policy ) {
+  case first:
+    return 0;
+  case round_robin:
+    {
+      int &next = _next_path[src * _table->NumNodes( ) + dest];
+      int path  = next;
+      next = ( next + 1 ) % paths;
+      return path;
+    }
+  case flow_hash:
+    {
+      unsigned int h = ( src * 2654435761u ) ^ ( dest * 2246822519u ) ^ ( cl * 3266489917u );
+      h ^= h >> 15;
+      return h % paths;
+    }
+  case congestion:
+    {
+      // least congested, the first candidate on a tie
+      int best      = 0;
+      int best_cost = _PathCost( subnet, src, dest, 0 );
+      for ( int p = 1; p < paths; ++p ) {
+	int cost = _PathCost( subnet, src, dest, p );
+	if ( cost < best_cost ) {
+	  best      = p;
+	  best_cost = cost;
+	}
+      }
+      return best;
+    }
+  case weighted:
+    {
+      // weight 1 / ( 1 + cost above the least congested path )
+      vector<int> cost( paths );
+      int min_cost = 0;
+      for ( int p = 0; p < paths; ++p ) {
+	cost[p] = _PathCost( subnet, src, dest, p );
+	if ( ( p == 0 ) || ( cost[p] < min_cost ) ) {
+	  min_cost = cost[p];
+	}
+      }
+      float total = 0.0;
+      for ( int p = 0; p < paths; ++p ) {
+	total += 1.0 / ( 1 + cost[p] - min_cost );
+      }
+      float pick = RandomFloat( total );
+      for ( int p = 0; p < paths - 1; ++p ) {
+	pick -= 1.0 / ( 1 + cost[p] - min_cost );
+	if ( pick < 0.0 ) {
+	  return p;
+	}
+      }
+      return paths - 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,88 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _PATHSELECT_HPP_
+#define _PATHSELECT_HPP_
+
+#include <vector>
+
+#include "config_utils.hpp"
+#include "network.hpp"
+#include "routetable.hpp"
+
+using namespace std;
+
+//picks one of the route table's candidate paths when a packet is generated
+//
+//path_selection = first        always path 0
+//                 congestion   least congested path, from a snapshot of the
+//                              router metrics taken every
+//                              path_congestion_period cycles
+//                 round_robin  next path of the pair, packet by packet
+//                 flow_hash    fixed path per (src, dest, class) flow, so
+//                              a flow stays in order
+//                 weighted     random path, weighted towards the less
+//                              congested ones in the snapshot
+class PathSelector {
+public:
+  enum ePolicy { first, congestion, round_robin, flow_hash, weighted };
+  enum eMetric { nof, nop, tracker, fluidity };
+
+private:
+  const RouteTable *_table;
+  const vector<Network *> &_net;
+
+  ePolicy _policy;
+  eMetric _metric;
+  int     _period;
+
+  vector<int> _next_path;          // [src * nodes + dest], round_robin
+
+  int _ports;
+
+  //topology, shared by all subnetworks
+  vector<int> _start_router;       // [node]
+  vector<int> _next_router;        // [router * _ports + port], -1 to eject
+  vector<int> _next_input;         // [router * _ports + port]
+
+  //congestion snapshot per subnetwork, cost of leaving router on port
+  vector<vector<int> > _cost;      // [subnet][router * _ports + port]
+
+  int _PortCost( int subnet, Router *router, int port ) const;
+  int _PathCost( int subnet, int src, int dest, int path ) const;
+
+public:
+  PathSelector( const Configuration &config, const vector<Network *> &net,
+		const RouteTable *table );
+
+  void Refresh( int time );
+  int  Select( int subnet, int src, int dest, int cl );
+};
+
+#endif
@@ -32,15 +32,22 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define _PIPEFIFO_HPP_
 
 #include "module.hpp"
+#include "ring.hpp"
 
+// The last _pipe_len cycles of writes, one row of lanes per cycle, in a
+// power-of-two ring of rows. A write is read _depth cycles later, after
+// that many calls to Advance.
 template<class T> class PipelineFIFO : public Module {
   int _lanes;
   int _depth;
 
   int _pipe_len;
-  int _pipe_ptr;
-  
-  T ***_data;
+  unsigned _pipe_ptr;   // cycle being written, its row is _pipe_ptr & _mask
+  unsigned _mask;
+
+  T **_data;
+
+  T **_Row( unsigned cycle ) const { return _data + ( cycle & _mask ) * _lanes; }
 
 public:
   PipelineFIFO( Module *parent, const string& name, int lanes, int depth );
@@ -52,6 +59,8 @@ public:
   T*   Read( int lane = 0 );
 
   void Advance( );
+
+  bool Empty( ) const;
 };
 
 template<class T> PipelineFIFO<T>::PipelineFIFO( Module *parent, 
@@ -63,44 +72,56 @@ template<class T> PipelineFIFO<T>::PipelineFIFO( Module *parent,
   _pipe_len = depth + 1;
   _pipe_ptr = 0;
 
-  _data = new T ** [_lanes];
-  for ( int l = 0; l < _lanes; ++l ) {
-    _data[l] = new T * [_pipe_len];
+  int rows = RingSize( _pipe_len );
+  _mask = rows - 1;
 
-    for ( int d = 0; d < _pipe_len; ++d ) {
-      _data[l][d] = 0;
-    }
+  _data = new T * [rows * _lanes];
+  for ( int i = 0; i < rows * _lanes; ++i ) {
+    _data[i] = 0;
   }
 }
 
 template<class T> PipelineFIFO<T>::~PipelineFIFO( ) 
 {
-  for ( int l = 0; l < _lanes; ++l ) {
-    delete [] _data[l];
-  }
   delete [] _data;
 }
 
 template<class T> void PipelineFIFO<T>::Write( T* val, int lane )
 {
-  _data[lane][_pipe_ptr] = val;
+  _Row( _pipe_ptr )[lane] = val;
 }
 
 template<class T> void PipelineFIFO<T>::WriteAll( T* val )
 {
+  T **row = _Row( _pipe_ptr );
   for ( int l = 0; l < _lanes; ++l ) {
-    _data[l][_pipe_ptr] = val;
+    row[l] = val;
   }
 }
 
+// the row written _pipe_len cycles ago, that is _depth cycles before the
+// last Advance
 template<class T> T* PipelineFIFO<T>::Read( int lane )
 {
-  return _data[lane][_pipe_ptr];
+  return _Row( _pipe_ptr - _pipe_len )[lane];
 }
 
 template<class T> void PipelineFIFO<T>::Advance( )
 {
-  _pipe_ptr = ( _pipe_ptr + 1 ) % _pipe_len;
+  ++_pipe_ptr;
+}
+
+template<class T> bool PipelineFIFO<T>::Empty( ) const
+{
+  for ( int d = 1; d <= _pipe_len; ++d ) {
+    T **row = _Row( _pipe_ptr - d );
+    for ( int l = 0; l < _lanes; ++l ) {
+      if ( row[l] ) {
+	return false;
+      }
+    }
+  }
+  return true;
 }
 
 #endif 
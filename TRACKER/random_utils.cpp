@@ -37,19 +37,53 @@ void RandomSeed( long seed )
   ranf_start( seed );
 }
 
+thread_local RandomStream *gRandomStream = 0;
+
 int RandomInt( int max ) 
   // Returns a random integer in the range [0,max]
 {
+  if ( gRandomStream ) {
+    return ( gRandomStream->Next( ) % (max+1) );
+  }
   return ( ran_next( ) % (max+1) );
 }
 
 unsigned long RandomIntLong( )
 {  
+  if ( gRandomStream ) {
+    return gRandomStream->Next( );
+  }
   return ran_next( );
 }
 
 float RandomFloat( float max )
   // Returns a random floating-point value in the rage [0,max]
 {
+  if ( gRandomStream ) {
+    return ( (float)gRandomStream->NextFloat( ) * max );
+  }
   return ( (float)ranf_next( ) * max );
 }
+
+RandomStream::RandomStream( unsigned long long seed ) : _state( seed )
+{
+}
+
+unsigned long long RandomStream::_Next( )
+{
+  unsigned long long z = ( _state += 0x9e3779b97f4a7c15ULL );
+  z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+  z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+  return z ^ ( z >> 31 );
+}
+
+long RandomStream::Next( )
+{
+  // ran_next( ) returns 30 bit values
+  return (long)( _Next( ) >> 34 );
+}
+
+double RandomStream::NextFloat( )
+{
+  return (double)( _Next( ) >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
@@ -48,4 +48,21 @@ int RandomInt( int max ) ;
 float RandomFloat( float max = 1.0 );
 unsigned long RandomIntLong( );
 
+// A private random stream (splitmix64). Routers stepped in parallel each
+// draw from their own stream, so results do not depend on the thread
+// count; while gRandomStream is set on a thread the functions above use it.
+class RandomStream {
+  unsigned long long _state;
+
+  unsigned long long _Next( );
+
+public:
+  RandomStream( unsigned long long seed = 0 );
+
+  long   Next( );      // same range as ran_next( )
+  double NextFloat( ); // [0,1)
+};
+
+extern thread_local RandomStream *gRandomStream;
+
 #endif
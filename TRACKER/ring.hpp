@@ -0,0 +1,115 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _RING_HPP_
+#define _RING_HPP_
+
+#include <vector>
+#include <assert.h>
+
+using namespace std;
+
+// smallest power of two holding n entries
+inline int RingSize( int n )
+{
+  int size = 1;
+  while ( size < n ) {
+    size <<= 1;
+  }
+  return size;
+}
+
+// FIFO in a power-of-two array. Sized up front for the expected depth;
+// it only doubles if that is ever exceeded.
+template<class T>
+class Ring {
+  vector<T> _data;
+  unsigned  _mask;
+  unsigned  _head;    // next to pop
+  unsigned  _tail;    // next to push
+
+  void _Grow( )
+  {
+    vector<T> data( 2 * _data.size( ) );
+    unsigned n = _tail - _head;
+    for ( unsigned i = 0; i < n; ++i ) {
+      data[i] = _data[( _head + i ) & _mask];
+    }
+    _data.swap( data );
+    _mask = (unsigned)_data.size( ) - 1;
+    _head = 0;
+    _tail = n;
+  }
+
+public:
+  Ring( int depth = 1 ) : _head( 0 ), _tail( 0 ) { Reserve( depth ); }
+
+  // empties the ring and sizes it for depth entries
+  void Reserve( int depth )
+  {
+    _data.assign( RingSize( depth ), T( ) );
+    _mask = (unsigned)_data.size( ) - 1;
+    _head = _tail = 0;
+  }
+
+  void Clear( ) { _head = _tail = 0; }
+
+  void Push( const T& v )
+  {
+    if ( _tail - _head > _mask ) {
+      _Grow( );
+    }
+    _data[_tail++ & _mask] = v;
+  }
+
+  void Pop( )
+  {
+    assert( !Empty( ) );
+    ++_head;
+  }
+
+  const T& Front( ) const
+  {
+    assert( !Empty( ) );
+    return _data[_head & _mask];
+  }
+
+  // i-th entry from the front
+  const T& operator[]( int i ) const
+  {
+    assert( ( i >= 0 ) && ( i < Size( ) ) );
+    return _data[( _head + i ) & _mask];
+  }
+
+  int  Size( ) const { return (int)( _tail - _head ); }
+  bool Empty( ) const { return _head == _tail; }
+};
+
+#endif
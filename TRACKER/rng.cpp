@@ -53,7 +53,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define MM (1L<<30)                 /* the modulus */
 #define mod_diff(x,y) (((x)-(y))&(MM-1)) /* subtraction mod MM */
 
-long ran_x[KK];                    /* the generator state */
+/* the generator state, gSim->ran_x, gSim->ran_arr_buf and gSim->ran_arr_ptr, lives in the
+   simulation's context (simcontext.hpp) */
 
 #ifdef __STDC__
 void ran_array(long aa[],int n)
@@ -64,19 +65,16 @@ void ran_array(aa,n)    /* put n new random numbers in aa */
 #endif
 {
   register int i,j;
-  for (j=0;j<KK;j++) aa[j]=ran_x[j];
+  for (j=0;j<KK;j++) aa[j]=gSim->ran_x[j];
   for (;j<n;j++) aa[j]=mod_diff(aa[j-KK],aa[j-LL]);
-  for (i=0;i<LL;i++,j++) ran_x[i]=mod_diff(aa[j-KK],aa[j-LL]);
-  for (;i<KK;i++,j++) ran_x[i]=mod_diff(aa[j-KK],ran_x[i-LL]);
+  for (i=0;i<LL;i++,j++) gSim->ran_x[i]=mod_diff(aa[j-KK],aa[j-LL]);
+  for (;i<KK;i++,j++) gSim->ran_x[i]=mod_diff(aa[j-KK],gSim->ran_x[i-LL]);
 }
 
 /* the following routines are from exercise 3.6--15 */
 /* after calling ran_start, get new randoms by, e.g., "x=ran_arr_next()" */
 
 #define QUALITY 1009 /* recommended quality level for high-res use */
-long ran_arr_buf[QUALITY];
-long ran_arr_dummy=-1, ran_arr_started=-1;
-long *ran_arr_ptr=&ran_arr_dummy; /* the next random number, or -1 */
 
 #define TT  70   /* guaranteed separation between streams */
 #define is_odd(x)  ((x)&1)          /* units bit of x */
@@ -108,21 +106,21 @@ void ran_start(seed)    /* do this before using ran_array */
     }
     if (ss) ss>>=1; else t--;
   }
-  for (j=0;j<LL;j++) ran_x[j+KK-LL]=x[j];
-  for (;j<KK;j++) ran_x[j-LL]=x[j];
+  for (j=0;j<LL;j++) gSim->ran_x[j+KK-LL]=x[j];
+  for (;j<KK;j++) gSim->ran_x[j-LL]=x[j];
   for (j=0;j<10;j++) ran_array(x,KK+KK-1); /* warm things up */
-  ran_arr_ptr=&ran_arr_started;
+  gSim->ran_arr_ptr=&gSim->ran_arr_started;
 }
 
-#define ran_arr_next() (*ran_arr_ptr>=0? *ran_arr_ptr++: ran_arr_cycle())
+#define ran_arr_next() (*gSim->ran_arr_ptr>=0? *gSim->ran_arr_ptr++: ran_arr_cycle())
 long ran_arr_cycle()
 {
-  if (ran_arr_ptr==&ran_arr_dummy)
+  if (gSim->ran_arr_ptr==&gSim->ran_arr_dummy)
     ran_start(314159L); /* the user forgot to initialize */
-  ran_array(ran_arr_buf,QUALITY);
-  ran_arr_buf[100]=-1;
-  ran_arr_ptr=ran_arr_buf+1;
-  return ran_arr_buf[0];
+  ran_array(gSim->ran_arr_buf,QUALITY);
+  gSim->ran_arr_buf[100]=-1;
+  gSim->ran_arr_ptr=gSim->ran_arr_buf+1;
+  return gSim->ran_arr_buf[0];
 }
 
 #include <stdio.h>
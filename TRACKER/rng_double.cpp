@@ -52,7 +52,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define LL  37                     /* the short lag */
 #define mod_sum(x,y) (((x)+(y))-(int)((x)+(y)))   /* (x+y) mod 1.0 */
 
-double ran_u[KK];           /* the generator state */
+/* the generator state lives in the simulation's context, as in rng.cpp */
 
 #ifdef __STDC__
 void ranf_array(double aa[], int n)
@@ -63,19 +63,16 @@ void ranf_array(aa,n)    /* put n new random fractions in aa */
 #endif
 {
   register int i,j;
-  for (j=0;j<KK;j++) aa[j]=ran_u[j];
+  for (j=0;j<KK;j++) aa[j]=gSim->ran_u[j];
   for (;j<n;j++) aa[j]=mod_sum(aa[j-KK],aa[j-LL]);
-  for (i=0;i<LL;i++,j++) ran_u[i]=mod_sum(aa[j-KK],aa[j-LL]);
-  for (;i<KK;i++,j++) ran_u[i]=mod_sum(aa[j-KK],ran_u[i-LL]);
+  for (i=0;i<LL;i++,j++) gSim->ran_u[i]=mod_sum(aa[j-KK],aa[j-LL]);
+  for (;i<KK;i++,j++) gSim->ran_u[i]=mod_sum(aa[j-KK],gSim->ran_u[i-LL]);
 }
 
 /* the following routines are adapted from exercise 3.6--15 */
 /* after calling ranf_start, get new randoms by, e.g., "x=ranf_arr_next()" */
 
 #define QUALITY 1009 /* recommended quality level for high-res use */
-double ranf_arr_buf[QUALITY];
-double ranf_arr_dummy=-1.0, ranf_arr_started=-1.0;
-double *ranf_arr_ptr=&ranf_arr_dummy; /* the next random fraction, or -1 */
 
 #define TT  70   /* guaranteed separation between streams */
 #define is_odd(s) ((s)&1)
@@ -111,21 +108,21 @@ void ranf_start(seed)    /* do this before using ranf_array */
     }
     if (s) s>>=1; else t--;
   }
-  for (j=0;j<LL;j++) ran_u[j+KK-LL]=u[j];
-  for (;j<KK;j++) ran_u[j-LL]=u[j];
+  for (j=0;j<LL;j++) gSim->ran_u[j+KK-LL]=u[j];
+  for (;j<KK;j++) gSim->ran_u[j-LL]=u[j];
   for (j=0;j<10;j++) ranf_array(u,KK+KK-1);  /* warm things up */
-  ranf_arr_ptr=&ranf_arr_started;
+  gSim->ranf_arr_ptr=&gSim->ranf_arr_started;
 }
 
-#define ranf_arr_next() (*ranf_arr_ptr>=0? *ranf_arr_ptr++: ranf_arr_cycle())
+#define ranf_arr_next() (*gSim->ranf_arr_ptr>=0? *gSim->ranf_arr_ptr++: ranf_arr_cycle())
 double ranf_arr_cycle()
 {
-  if (ranf_arr_ptr==&ranf_arr_dummy)
+  if (gSim->ranf_arr_ptr==&gSim->ranf_arr_dummy)
     ranf_start(314159L); /* the user forgot to initialize */
-  ranf_array(ranf_arr_buf,QUALITY);
-  ranf_arr_buf[100]=-1;
-  ranf_arr_ptr=ranf_arr_buf+1;
-  return ranf_arr_buf[0];
+  ranf_array(gSim->ranf_arr_buf,QUALITY);
+  gSim->ranf_arr_buf[100]=-1;
+  gSim->ranf_arr_ptr=gSim->ranf_arr_buf+1;
+  return gSim->ranf_arr_buf[0];
 }
 
 #include <stdio.h>
@@ -134,11 +131,11 @@ int main()
   register int m; double a[2009]; /* a rudimentary test */
   ranf_start(310952);
   for (m=0;m<2009;m++) ranf_array(a,1009);
-  printf("%.20f\n", ran_u[0]);            /* 0.36410514377569680455 */
+  printf("%.20f\n", gSim->ran_u[0]);            /* 0.36410514377569680455 */
      /* beware of buggy printf routines that do not give full accuracy here! */
   ranf_start(310952);
   for (m=0;m<1009;m++) ranf_array(a,2009);
-  printf("%.20f\n", ran_u[0]);            /* 0.36410514377569680455 */
+  printf("%.20f\n", gSim->ran_u[0]);            /* 0.36410514377569680455 */
   return 0;
 }
 
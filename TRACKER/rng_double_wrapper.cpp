@@ -29,6 +29,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "rng.hpp"
+#include "simcontext.hpp"
 
 #define main rng_double_main
 #include "rng_double.cpp"
@@ -57,22 +57,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 map<string, tRoutingFunction> gRoutingFunctionMap;
 
-/* Global information used by routing functions */
-
-int gNumVCS;
+/* Global information used by routing functions lives in gSim
+ * (simcontext.hpp): num_vcs and the Balfour-Schultz VC classes
+ */
 
 /* Add more functions here
  *
  */
 
-// ============================================================
-//  Balfour-Schultz
-int gReadReqBeginVC, gReadReqEndVC;
-int gWriteReqBeginVC, gWriteReqEndVC;
-int gReadReplyBeginVC, gReadReplyEndVC;
-int gWriteReplyBeginVC, gWriteReplyEndVC;
-int memo_log2gC = 0 ;
-
 // ----------------------------------------------------------------------
 //
 //   Crossbar Network 
@@ -88,22 +80,22 @@ void dest_tag_crossbar( const Router *r,
 
   // Output port determined by those bits of destination above 
   //  concentration bits
-  int out_port = f->dest >> memo_log2gC ;
+  int out_port = f->dest >> gSim->log2_c ;
   switch(f->type) {
   case Flit::READ_REQUEST:
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
+    outputs->AddRange( out_port, gSim->read_req_begin_vc, gSim->read_req_end_vc );
     break;
   case Flit::WRITE_REQUEST:
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
+    outputs->AddRange( out_port, gSim->write_req_begin_vc, gSim->write_req_end_vc );
     break;
   case Flit::READ_REPLY:
-    outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
+    outputs->AddRange( out_port, gSim->read_reply_begin_vc, gSim->read_reply_end_vc );
     break;
   case Flit::WRITE_REPLY:
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
+    outputs->AddRange( out_port, gSim->write_reply_begin_vc, gSim->write_reply_end_vc );
     break;
   case Flit::ANY_TYPE:
-    outputs->AddRange( out_port, 0, gNumVCS-1 );
+    outputs->AddRange( out_port, 0, gSim->num_vcs-1 );
     break;
   }
   
@@ -123,30 +115,30 @@ void qtree_nca( const Router *r, const Flit *f,
 
   int dest   = f->dest;
 
-  for (int i = height+1; i < gN; i++) 
-    dest /= gK;
-  if ( pos == dest / gK ) 
+  for (int i = height+1; i < gSim->n; i++) 
+    dest /= gSim->k;
+  if ( pos == dest / gSim->k ) 
     // Route down to child
-    out_port = dest % gK ; 
+    out_port = dest % gSim->k ; 
   else
     // Route up to parent
-    out_port = gK;        
+    out_port = gSim->k;        
 
   switch(f->type) {
   case Flit::READ_REQUEST:
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
+    outputs->AddRange( out_port, gSim->read_req_begin_vc, gSim->read_req_end_vc );
     break;
   case Flit::WRITE_REQUEST:
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
+    outputs->AddRange( out_port, gSim->write_req_begin_vc, gSim->write_req_end_vc );
     break;
   case Flit::READ_REPLY:
-    outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
+    outputs->AddRange( out_port, gSim->read_reply_begin_vc, gSim->read_reply_end_vc );
     break;
   case Flit::WRITE_REPLY:
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
+    outputs->AddRange( out_port, gSim->write_reply_begin_vc, gSim->write_reply_end_vc );
     break;
   case Flit::ANY_TYPE:
-    outputs->AddRange( out_port, 0, gNumVCS-1 );
+    outputs->AddRange( out_port, 0, gSim->num_vcs-1 );
     break;
   }
 }
@@ -177,14 +169,14 @@ void tree4_anca( const Router *r, const Flit *f,
     if ( dest / 4 == rP / 2 )
       out_port = dest % 4;
     else {
-      out_port = gK;
-      range = gK;
+      out_port = gSim->k;
+      range = gSim->k;
     }
   } else {
     if ( dest/4 == rP )
       out_port = dest % 4;
     else {
-      out_port = gK;
+      out_port = gSim->k;
       range = 2;
     }
   }
@@ -195,24 +187,24 @@ void tree4_anca( const Router *r, const Flit *f,
   int vcBegin = 0, vcEnd = 0;
   switch(f->type) {
   case Flit::READ_REQUEST:
-    vcBegin = gReadReqBeginVC;
-    vcEnd   = gReadReqEndVC;
+    vcBegin = gSim->read_req_begin_vc;
+    vcEnd   = gSim->read_req_end_vc;
     break;
   case Flit::WRITE_REQUEST:
-    vcBegin = gWriteReqBeginVC;
-    vcEnd   = gWriteReqEndVC;
+    vcBegin = gSim->write_req_begin_vc;
+    vcEnd   = gSim->write_req_end_vc;
     break;
   case Flit::READ_REPLY:
-    vcBegin = gReadReplyBeginVC;
-    vcEnd   = gReadReplyEndVC;
+    vcBegin = gSim->read_reply_begin_vc;
+    vcEnd   = gSim->read_reply_end_vc;
     break;
   case Flit::WRITE_REPLY:
-    vcBegin = gWriteReplyBeginVC;
-    vcEnd   = gWriteReplyEndVC;
+    vcBegin = gSim->write_reply_begin_vc;
+    vcEnd   = gSim->write_reply_end_vc;
     break;
   case Flit::ANY_TYPE:
     vcBegin = 0;
-    vcEnd   = gNumVCS-1;
+    vcEnd   = gSim->num_vcs-1;
   }
   
   for (int i = 0; i < range; ++i) 
@@ -243,12 +235,12 @@ void tree4_nca( const Router *r, const Flit *f,
     if ( dest / 4 == rP / 2 )
       out_port = dest % 4;
     else
-      out_port = gK + RandomInt(gK-1);
+      out_port = gSim->k + RandomInt(gSim->k-1);
   } else {
     if ( dest/4 == rP )
       out_port = dest % 4;
     else
-      out_port = gK + RandomInt(1);
+      out_port = gSim->k + RandomInt(1);
   }
  
   //  cout << "Router("<<rH<<","<<rP<<"): id= " << f->id << " dest= " << f->dest << " out_port = "
@@ -256,19 +248,19 @@ void tree4_nca( const Router *r, const Flit *f,
 
   switch(f->type) {
   case Flit::READ_REQUEST:
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
+    outputs->AddRange( out_port, gSim->read_req_begin_vc, gSim->read_req_end_vc );
     break;
   case Flit::WRITE_REQUEST:
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
+    outputs->AddRange( out_port, gSim->write_req_begin_vc, gSim->write_req_end_vc );
     break;
   case Flit::READ_REPLY:
-    outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
+    outputs->AddRange( out_port, gSim->read_reply_begin_vc, gSim->read_reply_end_vc );
     break;
   case Flit::WRITE_REPLY:
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
+    outputs->AddRange( out_port, gSim->write_reply_begin_vc, gSim->write_reply_end_vc );
     break;
   case Flit::ANY_TYPE:
-    outputs->AddRange( out_port, 0, gNumVCS-1 );
+    outputs->AddRange( out_port, 0, gSim->num_vcs-1 );
     break;
   }
 }
@@ -287,9 +279,9 @@ void fattree_nca( const Router *r, const Flit *f,
 
 
   short routers_so_far = 0, routers;
-  for (short depth = gN - 1; depth >= 0; --depth) // We want to find out where the router is. At which level.
+  for (short depth = gSim->n - 1; depth >= 0; --depth) // We want to find out where the router is. At which level.
   {
-    routers = powi(gK, depth);
+    routers = powi(gSim->k, depth);
     if (router_id - routers_so_far < routers) {
       router_depth = depth;
       router_port = router_id - routers_so_far;
@@ -300,17 +292,17 @@ void fattree_nca( const Router *r, const Flit *f,
 
   outputs->Clear( );
 
-  int fatness_factor = powi(gK, gN - router_depth ); // This is the fatness factor for when going upwards.
-  int destinations = powi(gK, gN); // According to the depth and port of the current router, we know which destinations are reachable by it by going down.
-  int temp = powi(gK, router_depth); // (destinations / (powi(gK, router_depth) ) are the number of destinations below the current router.
+  int fatness_factor = powi(gSim->k, gSim->n - router_depth ); // This is the fatness factor for when going upwards.
+  int destinations = powi(gSim->k, gSim->n); // According to the depth and port of the current router, we know which destinations are reachable by it by going down.
+  int temp = powi(gSim->k, router_depth); // (destinations / (powi(gSim->k, router_depth) ) are the number of destinations below the current router.
   if ((destinations / (temp) ) * router_port <= dest && (destinations / (temp) ) * (router_port + 1) > dest)
   {
-    out_port = (dest - (destinations / (temp) ) * router_port) / (fatness_factor / gK); // This is the direction to go. We multiply this by the fatness factor of that link.
-    out_port *= fatness_factor / gK; // Because we are going downwards. Now we point to the first link that is going downwards, among all the same.
-        if (router_depth != gN - 1 )
-      out_port += RandomInt(fatness_factor / gK - 1); // Choose at random from the possible choices.
+    out_port = (dest - (destinations / (temp) ) * router_port) / (fatness_factor / gSim->k); // This is the direction to go. We multiply this by the fatness factor of that link.
+    out_port *= fatness_factor / gSim->k; // Because we are going downwards. Now we point to the first link that is going downwards, among all the same.
+        if (router_depth != gSim->n - 1 )
+      out_port += RandomInt(fatness_factor / gSim->k - 1); // Choose at random from the possible choices.
         else
-          out_port = dest % gK; // If we are going to a final destination, only one link to choose.
+          out_port = dest % gSim->k; // If we are going to a final destination, only one link to choose.
   }
   else // We need to go up. Choose one of the links at random.
   {
@@ -318,38 +310,38 @@ void fattree_nca( const Router *r, const Flit *f,
   }
 
   /*if (rH == 0) {
-    out_port = dest / (gK*gK);
+    out_port = dest / (gSim->k*gSim->k);
   }
   if (rH == 1) {
-    if ( dest / (gK*gK)  == rP / gK )
-      out_port = (dest/gK) % gK;
+    if ( dest / (gSim->k*gSim->k)  == rP / gSim->k )
+      out_port = (dest/gSim->k) % gSim->k;
     else
-      out_port = gK + RandomInt(gK-1);
+      out_port = gSim->k + RandomInt(gSim->k-1);
   }
   if (rH == 2) {
-    if ( dest / gK == rP )
-      out_port = dest % gK;
+    if ( dest / gSim->k == rP )
+      out_port = dest % gSim->k;
     else
-      out_port =  gK + RandomInt(gK-1);
+      out_port =  gSim->k + RandomInt(gSim->k-1);
   }*/
 //  cout << "Router("<<rH<<","<<rP<<"): id= " << f->id << " dest= " << f->dest << " out_port = "
 //       << out_port << endl;
 
   switch(f->type) {
   case Flit::READ_REQUEST:
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
+    outputs->AddRange( out_port, gSim->read_req_begin_vc, gSim->read_req_end_vc );
     break;
   case Flit::WRITE_REQUEST:
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
+    outputs->AddRange( out_port, gSim->write_req_begin_vc, gSim->write_req_end_vc );
     break;
   case Flit::READ_REPLY:
-    outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
+    outputs->AddRange( out_port, gSim->read_reply_begin_vc, gSim->read_reply_end_vc );
     break;
   case Flit::WRITE_REPLY:
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
+    outputs->AddRange( out_port, gSim->write_reply_begin_vc, gSim->write_reply_end_vc );
     break;
   case Flit::ANY_TYPE:
-    outputs->AddRange( out_port, 0, gNumVCS-1 );
+    outputs->AddRange( out_port, 0, gSim->num_vcs-1 );
     break;
   }
 }
@@ -367,9 +359,9 @@ void fattree_anca( const Router *r, const Flit *f,
   short router_depth, router_port;
 
   short routers_so_far = 0, routers;
-  for (short depth = gN - 1; depth >= 0; --depth) // We want to find out where the router is. At which level.
+  for (short depth = gSim->n - 1; depth >= 0; --depth) // We want to find out where the router is. At which level.
   {
-    routers = powi(gK, depth);
+    routers = powi(gSim->k, depth);
     if (router_id - routers_so_far < routers) {
       router_depth = depth;
       router_port = router_id - routers_so_far;
@@ -380,21 +372,21 @@ void fattree_anca( const Router *r, const Flit *f,
 
   outputs->Clear( );
 
-  int fatness_factor = powi(gK, gN - router_depth ); // This is the fatness factor for when going upwards.
-  int destinations = powi(gK, gN); // According to the depth and port of the current router, we know which destinations are reachable by it by going down.
-  int temp = powi(gK, router_depth);
-  int range; // (destinations / (powi(gK, router_depth) ) are the number of destinations below the current router.
+  int fatness_factor = powi(gSim->k, gSim->n - router_depth ); // This is the fatness factor for when going upwards.
+  int destinations = powi(gSim->k, gSim->n); // According to the depth and port of the current router, we know which destinations are reachable by it by going down.
+  int temp = powi(gSim->k, router_depth);
+  int range; // (destinations / (powi(gSim->k, router_depth) ) are the number of destinations below the current router.
   if ((destinations / (temp) ) * router_port <= dest && (destinations / (temp) ) * (router_port + 1) > dest)
   {
-    out_port = (dest - (destinations / (temp)) * router_port) / (fatness_factor / gK); // This is the direction to go. We multiply this by the fatness factor of that link.
-    out_port *= fatness_factor / gK; // Because we are going downwards. Now we point to the first link that is going downwards, among all the same.
-        if (router_depth != gN - 1 )
+    out_port = (dest - (destinations / (temp)) * router_port) / (fatness_factor / gSim->k); // This is the direction to go. We multiply this by the fatness factor of that link.
+    out_port *= fatness_factor / gSim->k; // Because we are going downwards. Now we point to the first link that is going downwards, among all the same.
+        if (router_depth != gSim->n - 1 )
         {
-          range = fatness_factor / gK;
+          range = fatness_factor / gSim->k;
         }
         else
         {
-          out_port = dest % gK; // If we are going to a final destination, only one link to choose.
+          out_port = dest % gSim->k; // If we are going to a final destination, only one link to choose.
       range = 1;
         }
   }
@@ -407,23 +399,23 @@ void fattree_anca( const Router *r, const Flit *f,
   // r->GetCredit(tmp_out_port, vcBegin, vcEnd);
 
   /*if (rH == 0) {
-    out_port = dest / (gK*gK);
+    out_port = dest / (gSim->k*gSim->k);
   }
   if (rH == 1) {
-    if ( dest / (gK*gK)  == rP / gK )
-      out_port = (dest/gK) % gK;
+    if ( dest / (gSim->k*gSim->k)  == rP / gSim->k )
+      out_port = (dest/gSim->k) % gSim->k;
     else {
-      out_port = gK;
-      range    = gK;
+      out_port = gSim->k;
+      range    = gSim->k;
     }
 
   }
   if (rH == 2) {
-    if ( dest / gK == rP )
-      out_port = dest % gK;
+    if ( dest / gSim->k == rP )
+      out_port = dest % gSim->k;
     else {
-      out_port = gK;
-      range    = gK;
+      out_port = gSim->k;
+      range    = gSim->k;
     }
   }*/
 
@@ -434,24 +426,24 @@ void fattree_anca( const Router *r, const Flit *f,
   int vcBegin = 0, vcEnd = 0;
   switch(f->type) {
   case Flit::READ_REQUEST:
-    vcBegin = gReadReqBeginVC;
-    vcEnd   = gReadReqEndVC;
+    vcBegin = gSim->read_req_begin_vc;
+    vcEnd   = gSim->read_req_end_vc;
     break;
   case Flit::WRITE_REQUEST:
-    vcBegin = gWriteReqBeginVC;
-    vcEnd   = gWriteReqEndVC;
+    vcBegin = gSim->write_req_begin_vc;
+    vcEnd   = gSim->write_req_end_vc;
     break;
   case Flit::READ_REPLY:
-    vcBegin = gReadReplyBeginVC;
-    vcEnd   = gReadReplyEndVC;
+    vcBegin = gSim->read_reply_begin_vc;
+    vcEnd   = gSim->read_reply_end_vc;
     break;
   case Flit::WRITE_REPLY:
-    vcBegin = gWriteReplyBeginVC;
-    vcEnd   = gWriteReplyEndVC;
+    vcBegin = gSim->write_reply_begin_vc;
+    vcEnd   = gSim->write_reply_end_vc;
     break;
   case Flit::ANY_TYPE:
     vcBegin = 0;
-    vcEnd   = gNumVCS-1;
+    vcEnd   = gSim->num_vcs-1;
   }
 
   if (range > 1) {
@@ -481,14 +473,14 @@ int rajagiri_next_mesh( int cur, int dest )//current router, destination router
   int dim_left;
   int out_port;
   //n dim k nodes
-  for ( dim_left = 0; dim_left < gN; ++dim_left ) {
-    if ( ( cur % gK ) != ( dest % gK ) ) { break; }
-    cur /= gK; dest /= gK;
+  for ( dim_left = 0; dim_left < gSim->n; ++dim_left ) {
+    if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) { break; }
+    cur /= gSim->k; dest /= gSim->k;
   }
   
-  if ( dim_left < gN ) //dimensions left to traverse
+  if ( dim_left < gSim->n ) //dimensions left to traverse
   {
-    cur %= gK; dest %= gK;
+    cur %= gSim->k; dest %= gSim->k;
 
     if ( cur < dest ) //in a particular dimension either right or left port can be choosen
     {
@@ -501,53 +493,52 @@ int rajagiri_next_mesh( int cur, int dest )//current router, destination router
   } 
   else //no more dimensions left i.e., reached dest
   {
-    out_port = 2*gN;  // Eject
+    out_port = 2*gSim->n;  // Eject
   }
 
   return out_port;
 }
-void rajagiri_mesh( const Router *r, const Flit *f, 
-	       int in_channel, OutputSet *outputs, bool inject)
+// decodes the next hop of a source routed flit: pops the output port and
+// VC class off the cursor and maps the class onto the flit type's VC range
+void rajagiri_next_hop( const Flit *f, int *out_port, int *vc_start, int *vc_end )
 {
-  int out_port;
-  int vcBegin = 0, vcEnd = 0;int temp[10];
-  for(int i=0;i<7;i++)
-  {
-  	temp[i]=f->test[i];
+  int vc_class;
+  int vcBegin = 0, vcEnd = 0;
   
+  // the route is shared by the whole packet, only the head flit reads it;
+  // every hop pops the next port off the cursor
+  *out_port = f->route.Pop( &vc_class );
+  
+  if (f->type == Flit::READ_REQUEST) {
+    vcBegin = gSim->read_req_begin_vc;
+    vcEnd   = gSim->read_req_end_vc;
+  } else if (f->type == Flit::WRITE_REQUEST) {
+    vcBegin = gSim->write_req_begin_vc;
+    vcEnd   = gSim->write_req_end_vc;
+  } else if (f->type ==  Flit::READ_REPLY) {
+    vcBegin = gSim->read_reply_begin_vc;
+    vcEnd   = gSim->read_reply_end_vc;
+  } else if (f->type ==  Flit::WRITE_REPLY) {
+    vcBegin = gSim->write_reply_begin_vc;
+    vcEnd   = gSim->write_reply_end_vc;
+  } else if (f->type ==  Flit::ANY_TYPE) {
+    vcBegin = 0;
+    vcEnd   = gSim->num_vcs-1;
   }
-  //temp[i]=f->test[i];
+  f->route.format->ClassRange( vc_class, vcBegin, vcEnd, vc_start, vc_end );
+}
+
+// source routed: the output port and VC class of every hop come from the
+// route table, for any topology (see routetable.cpp)
+void rajagiri( const Router *r, const Flit *f, 
+	       int in_channel, OutputSet *outputs, bool inject)
+{
+  int out_port, vcBegin, vcEnd;
   outputs->Clear( );
   
-  //out_port =  dor_next_mesh( r->GetID( ), f->dest );
-  //out_port = f->test[f->itest];
-  //out_port =temp;
-  out_port=temp[f->itest];
+  rajagiri_next_hop( f, &out_port, &vcBegin, &vcEnd );
   
-  //cout<<"\n source:"<<r->GetID()<<"dest:"<<f->dest<<"port"<<out_port;
-  vcBegin = 0;
-  vcEnd   = gNumVCS-1;
-  /*if(f->id==555)//added by KVM
-  {
-  	cout<<(*f);
-  	getchar();
-
-  	
-  }*/
-  if (f->type == Flit::READ_REQUEST)
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
-  else if (f->type == Flit::WRITE_REQUEST)
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
-  else if (f->type ==  Flit::READ_REPLY)
-    outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
-  else if (f->type ==  Flit::WRITE_REPLY)
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
-  else if (f->type ==  Flit::ANY_TYPE)
-  {
-    //cout<<"numvcs"<<gNumVCS<<endl;
-    //cout<<"outport"<<out_port<<endl;
-    outputs->AddRange( out_port, 0, gNumVCS-1 );//present in outputset.cpp
-   }
+  outputs->AddRange( out_port, vcBegin, vcEnd );//present in outputset.cpp
 }
 
 
@@ -566,7 +557,7 @@ void dor_mesh( const Router *r, const Flit *f,
   out_port = dor_next_mesh( r->GetID( ), f->dest );
   
   vcBegin = 0;
-  vcEnd   = gNumVCS-1;
+  vcEnd   = gSim->num_vcs-1;
   /*if(f->id==555)//added by KVM
   {
   	cout<<(*f);
@@ -575,18 +566,18 @@ void dor_mesh( const Router *r, const Flit *f,
   	
   }*/
   if (f->type == Flit::READ_REQUEST)
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
+    outputs->AddRange( out_port, gSim->read_req_begin_vc, gSim->read_req_end_vc );
   else if (f->type == Flit::WRITE_REQUEST)
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
+    outputs->AddRange( out_port, gSim->write_req_begin_vc, gSim->write_req_end_vc );
   else if (f->type ==  Flit::READ_REPLY)
-    outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
+    outputs->AddRange( out_port, gSim->read_reply_begin_vc, gSim->read_reply_end_vc );
   else if (f->type ==  Flit::WRITE_REPLY)
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
+    outputs->AddRange( out_port, gSim->write_reply_begin_vc, gSim->write_reply_end_vc );
   else if (f->type ==  Flit::ANY_TYPE)
   {
-    //cout<<"numvcs"<<gNumVCS<<endl;
+    //cout<<"numvcs"<<gSim->num_vcs<<endl;
     //cout<<"outport"<<out_port<<endl;
-    outputs->AddRange( out_port, 0, gNumVCS-1 );//present in outputset.cpp
+    outputs->AddRange( out_port, 0, gSim->num_vcs-1 );//present in outputset.cpp
    }
 }
 
@@ -607,17 +598,17 @@ void oddeven_modified_mesh( const Router *r, const Flit *f,
   cur=r->GetID( );
   dest=f->dest;
   src=f->src;
-  s0=src%gK;
-  s1=src/gK;
-  d0=dest%gK;
-  d1=dest/gK;
-  c0=cur%gK;
-  c1=cur/gK;
+  s0=src%gSim->k;
+  s1=src/gSim->k;
+  d0=dest%gSim->k;
+  d1=dest/gSim->k;
+  c0=cur%gSim->k;
+  c1=cur/gSim->k;
  if(f->id==176)//added by KVM
   {
   //print_coords=true;
   //cout<<"in dor_mesh"<<endl;
-  fp<<(*f);
+  gSim->Trace( )<<(*f);
   //getchar();
   }
   
@@ -626,19 +617,19 @@ void oddeven_modified_mesh( const Router *r, const Flit *f,
   
   if(e0==0 && e1==0)
   {
-  	outputs->AddRange( 4, 0, gNumVCS-1,1 ); //deliver the packet to the local node and exit
+  	outputs->AddRange( 4, 0, gSim->num_vcs-1,1 ); //deliver the packet to the local node and exit
   }
   else if(e0==0)//currently in the same column as dest
   {
   	if(e1>0)
   	{
   		if(in_channel!=2)
-  			outputs->AddRange( 2, 0, gNumVCS-1,1 );;//add north
+  			outputs->AddRange( 2, 0, gSim->num_vcs-1,1 );;//add north
   	}
   	else
   	{
   		if(in_channel!=3)
-  			outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
+  			outputs->AddRange( 3, 0, gSim->num_vcs-1,1 );//add south
   	}
   }
   else
@@ -648,7 +639,7 @@ void oddeven_modified_mesh( const Router *r, const Flit *f,
   		if(e1==0)//currently in the same row as destination
   		{
   			if(in_channel!=0)
-  				outputs->AddRange( 0, 0, gNumVCS-1,1 );//add east
+  				outputs->AddRange( 0, 0, gSim->num_vcs-1,1 );//add east
   		}
   		else
   		{
@@ -657,36 +648,36 @@ void oddeven_modified_mesh( const Router *r, const Flit *f,
   				if(e1>0)
   				{
   					if(in_channel!=2)
-  						outputs->AddRange( 2, 0, gNumVCS-1,1 );//add north
+  						outputs->AddRange( 2, 0, gSim->num_vcs-1,1 );//add north
   				}
   				else
   				{
   					if(in_channel!=3)
-  						outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
+  						outputs->AddRange( 3, 0, gSim->num_vcs-1,1 );//add south
   				}
   			}
   			if((d0%2==1) || (e0!=1))//odd dest column or >= 2 columns to dest
   			{
   				if(in_channel!=0)
-  					outputs->AddRange( 0, 0, gNumVCS-1,2);//add east
+  					outputs->AddRange( 0, 0, gSim->num_vcs-1,2);//add east
   			}
   		}
   	}
   	else //west-bound messages
   	{
   		if(in_channel!=1)
-  			outputs->AddRange( 1, 0, gNumVCS-1,2);//add west
+  			outputs->AddRange( 1, 0, gSim->num_vcs-1,2);//add west
   		if(c0%2==0)
   		{
   			if(e1>0)
   			{
   				if(in_channel!=2)
-  					outputs->AddRange( 2, 0, gNumVCS-1,1 );//add north
+  					outputs->AddRange( 2, 0, gSim->num_vcs-1,1 );//add north
   			}
   			else if(e1<0)
   			{
   				if(in_channel!=3)
-  					outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
+  					outputs->AddRange( 3, 0, gSim->num_vcs-1,1 );//add south
   			}
   		}
   	}
@@ -708,17 +699,17 @@ void oddeven_mesh( const Router *r, const Flit *f,
   cur=r->GetID( );
   dest=f->dest;
   src=f->src;
-  s0=src%gK;
-  s1=src/gK;
-  d0=dest%gK;
-  d1=dest/gK;
-  c0=cur%gK;
-  c1=cur/gK;
+  s0=src%gSim->k;
+  s1=src/gSim->k;
+  d0=dest%gSim->k;
+  d1=dest/gSim->k;
+  c0=cur%gSim->k;
+  c1=cur/gSim->k;
  if(f->id>=0)//added by KVM
   {
   //print_coords=true;
   //cout<<"in dor_mesh"<<endl;
-  fp<<(*f);
+  gSim->Trace( )<<(*f);
   //getchar();
   }
   
@@ -727,17 +718,17 @@ void oddeven_mesh( const Router *r, const Flit *f,
   
   if(e0==0 && e1==0)
   {
-  	outputs->AddRange( 4, 0, gNumVCS-1,1 ); //deliver the packet to the local node and exit
+  	outputs->AddRange( 4, 0, gSim->num_vcs-1,1 ); //deliver the packet to the local node and exit
   }
   else if(e0==0)//currently in the same column as dest
   {
   	if(e1>0)
   	{
-  		outputs->AddRange( 2, 0, gNumVCS-1,1 );;//add north
+  		outputs->AddRange( 2, 0, gSim->num_vcs-1,1 );;//add north
   	}
   	else
   	{
-  		outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
+  		outputs->AddRange( 3, 0, gSim->num_vcs-1,1 );//add south
   	}
   }
   else
@@ -746,7 +737,7 @@ void oddeven_mesh( const Router *r, const Flit *f,
   	{
   		if(e1==0)//currently in the same row as destination
   		{
-  			outputs->AddRange( 0, 0, gNumVCS-1,1 );//add east
+  			outputs->AddRange( 0, 0, gSim->num_vcs-1,1 );//add east
   		}
   		else
   		{
@@ -754,33 +745,33 @@ void oddeven_mesh( const Router *r, const Flit *f,
   			{
   				if(e1>0)
   				{
-  					outputs->AddRange( 2, 0, gNumVCS-1,1 );//add north
+  					outputs->AddRange( 2, 0, gSim->num_vcs-1,1 );//add north
   				}
   				else
   				{
-  					outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
+  					outputs->AddRange( 3, 0, gSim->num_vcs-1,1 );//add south
   				}
   			}
   			if((d0%2==1) || (e0!=1))//odd dest column or >= 2 columns to dest
   			{
-  				outputs->AddRange( 0, 0, gNumVCS-1,2);//add east
+  				outputs->AddRange( 0, 0, gSim->num_vcs-1,2);//add east
   			}
   		}
   	}
   	else //west-bound messages
   	{
-  		outputs->AddRange( 1, 0, gNumVCS-1,2);//add west
+  		outputs->AddRange( 1, 0, gSim->num_vcs-1,2);//add west
   		if(c0%2==0)
   		{
   			if(e1>0)
   			{
   				
-  				outputs->AddRange( 2, 0, gNumVCS-1,1 );//add north
+  				outputs->AddRange( 2, 0, gSim->num_vcs-1,1 );//add north
   			}
   			else
   			{
-  				if(cur>=gK)
-  				outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
+  				if(cur>=gSim->k)
+  				outputs->AddRange( 3, 0, gSim->num_vcs-1,1 );//add south
   			}
   		}
   	}
@@ -802,12 +793,12 @@ void west_first_mesh( const Router *r, const Flit *f,
   dest=f->dest;
   src=f->src;
   
-  s0=src%gK;
-  s1=src/gK;
-  d0=dest%gK;
-  d1=dest/gK;
-  c0=cur%gK;
-  c1=cur/gK;
+  s0=src%gSim->k;
+  s1=src/gSim->k;
+  d0=dest%gSim->k;
+  d1=dest/gSim->k;
+  c0=cur%gSim->k;
+  c1=cur/gSim->k;
   /*if(print_coords)
   {
   cout<<"in west_first_next_mesh"<<endl;
@@ -828,36 +819,36 @@ void west_first_mesh( const Router *r, const Flit *f,
   
   if(e0==0 && e1==0)
   {
-  	outputs->AddRange( 4, 0, gNumVCS-1,1 ); //deliver the packet to the local node and exit
+  	outputs->AddRange( 4, 0, gSim->num_vcs-1,1 ); //deliver the packet to the local node and exit
   }
   else if(e0==0)//currently in the same column as dest
   {
   	if(e1>0)
   	{
-  		outputs->AddRange( 2, 0, gNumVCS-1,1 );//add north
+  		outputs->AddRange( 2, 0, gSim->num_vcs-1,1 );//add north
   	}
   	else if (e1<0)
   	{
-  		outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
+  		outputs->AddRange( 3, 0, gSim->num_vcs-1,1 );//add south
   	}
   }
   else
   {
   	if(e0>0) //east-bound messages
   	{
-  		outputs->AddRange( 0, 0, gNumVCS-1,2 );//add east
+  		outputs->AddRange( 0, 0, gSim->num_vcs-1,2 );//add east
   		if(e1>0)
   		{
-  			outputs->AddRange( 2, 0, gNumVCS-1,1 );//add north
+  			outputs->AddRange( 2, 0, gSim->num_vcs-1,1 );//add north
  		}
   		else if(e1<0)
   		{
-  			outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
+  			outputs->AddRange( 3, 0, gSim->num_vcs-1,1 );//add south
   		}
   	}
   	else //west-bound messages
   	{
-  		outputs->AddRange( 1, 0, gNumVCS-1,1 );//add west
+  		outputs->AddRange( 1, 0, gSim->num_vcs-1,1 );//add west
   	}
   }
   // select a dimension to forward the packet
@@ -874,18 +865,18 @@ void west_first_mesh( const Router *r, const Flit *f,
 
  /* out_port = west_first_next_mesh( r->GetID( ), f->dest,f->src,print_coords );
   if (f->type == Flit::READ_REQUEST)
-    outputs->AddRange( out_port, gReadReqBeginVC, gReadReqEndVC );
+    outputs->AddRange( out_port, gSim->read_req_begin_vc, gSim->read_req_end_vc );
   else if (f->type == Flit::WRITE_REQUEST)
-    outputs->AddRange( out_port, gWriteReqBeginVC, gWriteReqEndVC );
+    outputs->AddRange( out_port, gSim->write_req_begin_vc, gSim->write_req_end_vc );
   else if (f->type ==  Flit::READ_REPLY)
-    outputs->AddRange( out_port, gReadReplyBeginVC, gReadReplyEndVC );
+    outputs->AddRange( out_port, gSim->read_reply_begin_vc, gSim->read_reply_end_vc );
   else if (f->type ==  Flit::WRITE_REPLY)
-    outputs->AddRange( out_port, gWriteReplyBeginVC, gWriteReplyEndVC );
+    outputs->AddRange( out_port, gSim->write_reply_begin_vc, gSim->write_reply_end_vc );
   else if (f->type ==  Flit::ANY_TYPE)
   {
-    //cout<<"numvcs"<<gNumVCS<<endl;
+    //cout<<"numvcs"<<gSim->num_vcs<<endl;
     //cout<<"outport"<<out_port<<endl;
-    outputs->AddRange( out_port, 0, gNumVCS-1 );//present in outputset.cpp
+    outputs->AddRange( out_port, 0, gSim->num_vcs-1 );//present in outputset.cpp
    }*/
 }
 
@@ -921,24 +912,24 @@ void xy_yx_mesh( const Router *r, const Flit *f,
   }
 
   // ( Traffic Class , Routing Order ) -> Virtual Channel Range
-  int vcBegin = 0, vcEnd = gNumVCS-1;
+  int vcBegin = 0, vcEnd = gSim->num_vcs-1;
   int available_vcs = 0;
   
   //each class must have atleast 2 vcs assigned or else xy_yx will deadlock
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    vcBegin = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    vcBegin = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-    available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-    vcBegin = gWriteReqBeginVC;
+    available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+    vcBegin = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-    available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-    vcBegin = gReadReplyBeginVC;
+    available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+    vcBegin = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-    available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;      
-    vcBegin = gWriteReplyBeginVC;
+    available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;      
+    vcBegin = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = gNumVCS;
+    available_vcs = gSim->num_vcs;
     vcBegin = 0;
   }
   assert( available_vcs>=2);
@@ -955,10 +946,10 @@ void xy_yx_mesh( const Router *r, const Flit *f,
 int route_xy( int router_id, int dest_id ) {
  
   //cout<<"xy"<<endl;
-  int router_x = router_id % gK;
-  int router_y = router_id / gK;
-  int dest_x = dest_id % gK;
-  int dest_y = dest_id / gK;
+  int router_x = router_id % gSim->k;
+  int router_y = router_id / gSim->k;
+  int dest_x = dest_id % gSim->k;
+  int dest_y = dest_id / gSim->k;
   int out_port = 0;
 
   if ( router_x < dest_x ) 
@@ -971,7 +962,7 @@ int route_xy( int router_id, int dest_id ) {
     else if ( router_y > dest_y )
       out_port = 3;
     else
-      out_port = 2*gN;
+      out_port = 2*gSim->n;
   }
   return out_port;
 }
@@ -979,10 +970,10 @@ int route_xy( int router_id, int dest_id ) {
 int route_yx( int router_id, int dest_id ) {
 
   //cout<<"yx"<<endl;
-  int router_x = router_id % gK;
-  int router_y = router_id / gK;
-  int dest_x = dest_id % gK;
-  int dest_y = dest_id / gK;
+  int router_x = router_id % gSim->k;
+  int router_y = router_id / gSim->k;
+  int dest_x = dest_id % gSim->k;
+  int dest_y = dest_id / gSim->k;
   int out_port = 0;
 
   if ( router_y < dest_y )
@@ -995,7 +986,7 @@ int route_yx( int router_id, int dest_id ) {
     else if ( router_x > dest_x )
       out_port = 1;
     else 
-      out_port = 2*gN;
+      out_port = 2*gSim->n;
   }
   return out_port;
 }
@@ -1012,7 +1003,7 @@ int route_yx( int router_id, int dest_id ) {
 void singlerf( const Router *, const Flit *f, int, OutputSet *outputs, bool inject )
 {
   outputs->Clear( );
-  outputs->Add( f->dest, f->dest % gNumVCS ); // VOQing
+  outputs->Add( f->dest, f->dest % gSim->num_vcs ); // VOQing
 }
 
 //=============================================================
@@ -1022,14 +1013,14 @@ int dor_next_mesh( int cur, int dest )//current router, destination router
   int dim_left;
   int out_port;
   //n dim k nodes
-  for ( dim_left = 0; dim_left < gN; ++dim_left ) {
-    if ( ( cur % gK ) != ( dest % gK ) ) { break; }
-    cur /= gK; dest /= gK;
+  for ( dim_left = 0; dim_left < gSim->n; ++dim_left ) {
+    if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) { break; }
+    cur /= gSim->k; dest /= gSim->k;
   }
   
-  if ( dim_left < gN ) //dimensions left to traverse
+  if ( dim_left < gSim->n ) //dimensions left to traverse
   {
-    cur %= gK; dest %= gK;
+    cur %= gSim->k; dest %= gSim->k;
 
     if ( cur < dest ) //in a particular dimension either right or left port can be choosen
     {
@@ -1042,7 +1033,7 @@ int dor_next_mesh( int cur, int dest )//current router, destination router
   } 
   else //no more dimensions left i.e., reached dest
   {
-    out_port = 2*gN;  // Eject
+    out_port = 2*gSim->n;  // Eject
   }
 
   return out_port;
@@ -1055,12 +1046,12 @@ int oddeven_next_mesh( int cur, int dest,int src,bool print_coords)//current rou
   int s0,s1,d0,d1,c0,c1,e0,e1;
   int out_port,size=0,index=0;
   vector<int> avail_dimension_set;
-  s0=src%gK;
-  s1=src/gK;
-  d0=dest%gK;
-  d1=dest/gK;
-  c0=cur%gK;
-  c1=cur/gK;
+  s0=src%gSim->k;
+  s1=src/gSim->k;
+  d0=dest%gSim->k;
+  d1=dest/gSim->k;
+  c0=cur%gSim->k;
+  c1=cur/gSim->k;
   if(print_coords)
   {
   cout<<"in oddeven_next_mesh"<<endl;
@@ -1154,12 +1145,12 @@ int west_first_next_mesh( int cur, int dest,int src,bool print_coords)//current
   int s0,s1,d0,d1,c0,c1,e0,e1;
   int out_port,size=0,index=0;
   vector<int> avail_dimension_set;
-  s0=src%gK;
-  s1=src/gK;
-  d0=dest%gK;
-  d1=dest/gK;
-  c0=cur%gK;
-  c1=cur/gK;
+  s0=src%gSim->k;
+  s1=src/gSim->k;
+  d0=dest%gSim->k;
+  d1=dest/gSim->k;
+  c0=cur%gSim->k;
+  c1=cur/gSim->k;
   if(print_coords)
   {
   cout<<"in west_first_next_mesh"<<endl;
@@ -1232,18 +1223,18 @@ void dor_next_torus( int cur, int dest, int in_port,
   int dir;
   int dist2;
 
-  for ( dim_left = 0; dim_left < gN; ++dim_left ) {
-    if ( ( cur % gK ) != ( dest % gK ) ) { break; }
-    cur /= gK; dest /= gK;
+  for ( dim_left = 0; dim_left < gSim->n; ++dim_left ) {
+    if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) { break; }
+    cur /= gSim->k; dest /= gSim->k;
   }
   
-  if ( dim_left < gN ) {
+  if ( dim_left < gSim->n ) {
 
     if ( (in_port/2) != dim_left ) {
       // Turning into a new dimension
 
-      cur %= gK; dest %= gK;
-      dist2 = gK - 2 * ( ( dest - cur + gK ) % gK );
+      cur %= gSim->k; dest %= gSim->k;
+      dist2 = gSim->k - 2 * ( ( dest - cur + gSim->k ) % gSim->k );
       
       if ( ( dist2 > 0 ) || 
 	   ( ( dist2 == 0 ) && ( RandomInt( 1 ) ) ) ) {
@@ -1263,8 +1254,8 @@ void dor_next_torus( int cur, int dest, int in_port,
 	if ( ( ( dir == 0 ) && ( cur > dest ) ) ||
 	     ( ( dir == 1 ) && ( cur < dest ) ) ) {
 	  *partition = 1;
-	} else if ( ( ( dir == 0 ) && ( cur <= (gK-1)/2 ) && ( dest >  (gK-1)/2 ) ) ||
-	       ( ( dir == 1 ) && ( cur >  (gK-1)/2 ) && ( dest <= (gK-1)/2 ) ) ) {
+	} else if ( ( ( dir == 0 ) && ( cur <= (gSim->k-1)/2 ) && ( dest >  (gSim->k-1)/2 ) ) ||
+	       ( ( dir == 1 ) && ( cur >  (gSim->k-1)/2 ) && ( dest <= (gSim->k-1)/2 ) ) ) {
 	  *partition = 0;
 	} else {
 	  *partition = RandomInt( 1 ); // use either VC set
@@ -1286,7 +1277,7 @@ void dor_next_torus( int cur, int dest, int in_port,
     }    
 
   } else {
-    *out_port = 2*gN;  // Eject
+    *out_port = 2*gSim->n;  // Eject
   }
 }
 
@@ -1299,15 +1290,15 @@ void dim_order_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *
   outputs->Clear( );
 
   if ( inject ) { // use any VC for injection
-    outputs->AddRange( 0, 0, gNumVCS - 1 );
+    outputs->AddRange( 0, 0, gSim->num_vcs - 1 );
   } else {
     out_port = dor_next_mesh( r->GetID( ), f->dest );
     
     if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "Adding VC range [" 
 		  << 0 << "," 
-		  << gNumVCS - 1 << "]"
+		  << gSim->num_vcs - 1 << "]"
 		  << " at output port " << out_port
 		  << " for flit " << f->id
 		  << " (input port " << in_channel
@@ -1315,7 +1306,7 @@ void dim_order_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *
 		  << "." << endl;
     }
     
-    outputs->AddRange( out_port, 0, gNumVCS - 1 );
+    outputs->AddRange( out_port, 0, gSim->num_vcs - 1 );
   }
 }
 
@@ -1324,13 +1315,13 @@ void dim_order_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *
 void dim_order_ni_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *outputs, bool inject )
 {
   int out_port;
-  int vcs_per_dest = gNumVCS / gNodes;
+  int vcs_per_dest = gSim->num_vcs / gSim->nodes;
 
   outputs->Clear( );
   out_port = dor_next_mesh( r->GetID( ), f->dest );
 
   if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "Adding VC range [" 
 		  << f->dest*vcs_per_dest << "," 
 		  << (f->dest+1)*vcs_per_dest - 1 << "]"
@@ -1355,17 +1346,17 @@ int rand_min_intr_mesh( int src, int dest )
   int intm = 0;
   int offset = 1;
 
-  for ( int n = 0; n < gN; ++n ) {
-    dist = ( dest % gK ) - ( src % gK );
+  for ( int n = 0; n < gSim->n; ++n ) {
+    dist = ( dest % gSim->k ) - ( src % gSim->k );
 
     if ( dist > 0 ) {
-      intm += offset * ( ( src % gK ) + RandomInt( dist ) );
+      intm += offset * ( ( src % gSim->k ) + RandomInt( dist ) );
     } else {
-      intm += offset * ( ( dest % gK ) + RandomInt( -dist ) );
+      intm += offset * ( ( dest % gSim->k ) + RandomInt( -dist ) );
     }
 
-    offset *= gK;
-    dest /= gK; src /= gK;
+    offset *= gSim->k;
+    dest /= gSim->k; src /= gSim->k;
   }
 
   return intm;
@@ -1380,7 +1371,7 @@ void romm_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *outpu
 
   outputs->Clear( );
 
-  if ( in_channel == 2*gN ) {
+  if ( in_channel == 2*gSim->n ) {
     f->ph   = 1;  // Phase 1
     f->intm = rand_min_intr_mesh( f->src, f->dest );
   } 
@@ -1399,19 +1390,19 @@ void romm_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *outpu
     //each class must have ast east 2 vcs assigned or else valiant valiant will deadlock
   int available_vcs = 0;
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    vc_min = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    vc_min = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-   available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-   vc_min = gWriteReqBeginVC;
+   available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+   vc_min = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-   available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-   vc_min = gReadReplyBeginVC;
+   available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+   vc_min = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-   available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;      
-   vc_min = gWriteReplyBeginVC;
+   available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;      
+   vc_min = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = gNumVCS;
+    available_vcs = gSim->num_vcs;
     vc_min = 0;
   }
   assert( available_vcs>=2);
@@ -1431,11 +1422,11 @@ void romm_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *outpu
 void romm_ni_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *outputs, bool inject )
 {
   int out_port;
-  int vcs_per_dest = gNumVCS / gNodes;
+  int vcs_per_dest = gSim->num_vcs / gSim->nodes;
 
   outputs->Clear( );
 
-  if ( in_channel == 2*gN ) {
+  if ( in_channel == 2*gSim->n ) {
     f->ph   = 1;  // Phase 1
     f->intm = rand_min_intr_mesh( f->src, f->dest );
   } 
@@ -1463,8 +1454,8 @@ void min_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *
 
   outputs->Clear( );
   
-  if ( in_channel == 2*gN ) {
-    in_vc = gNumVCS - 1; // ignore the injection VC
+  if ( in_channel == 2*gSim->n ) {
+    in_vc = gSim->num_vcs - 1; // ignore the injection VC
   } else {
     in_vc = f->vc;
   }
@@ -1474,7 +1465,7 @@ void min_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *
   outputs->AddRange( out_port, 0, 0, 0 );
   
   if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "Adding VC range [" 
 		  << 0 << "," 
 		  << 0 << "]"
@@ -1489,15 +1480,15 @@ void min_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *
     // Minimal adaptive for all other channels
     cur = r->GetID( ); dest = f->dest;
     
-    for ( int n = 0; n < gN; ++n ) {
-      if ( ( cur % gK ) != ( dest % gK ) ) { 
+    for ( int n = 0; n < gSim->n; ++n ) {
+      if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) { 
 	// Add minimal direction in dimension 'n'
-	if ( ( cur % gK ) < ( dest % gK ) ) { // Right
+	if ( ( cur % gSim->k ) < ( dest % gSim->k ) ) { // Right
 	  if ( f->watch ) {
-	    *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 			<< "Adding VC range [" 
 			<< 1 << "," 
-			<< gNumVCS - 1 << "]"
+			<< gSim->num_vcs - 1 << "]"
 			<< " at output port " << 2*n
 			<< " with priority " << 1
 			<< " for flit " << f->id
@@ -1505,13 +1496,13 @@ void min_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *
 			<< ", destination " << f->dest << ")"
 			<< "." << endl;
 	  }
-	  outputs->AddRange( 2*n, 1, gNumVCS - 1, 1 ); 
+	  outputs->AddRange( 2*n, 1, gSim->num_vcs - 1, 1 ); 
 	} else { // Left
 	  if ( f->watch ) {
-	    *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 			<< "Adding VC range [" 
 			<< 1 << "," 
-			<< gNumVCS - 1 << "]"
+			<< gSim->num_vcs - 1 << "]"
 			<< " at output port " << 2*n+1
 			<< " with priority " << 1
 			<< " for flit " << f->id
@@ -1519,11 +1510,11 @@ void min_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *
 			<< ", destination " << f->dest << ")"
 			<< "." << endl;
 	  }
-	  outputs->AddRange( 2*n + 1, 1, gNumVCS - 1, 1 ); 
+	  outputs->AddRange( 2*n + 1, 1, gSim->num_vcs - 1, 1 ); 
 	}
       }
-      cur  /= gK;
-      dest /= gK;
+      cur  /= gSim->k;
+      dest /= gSim->k;
     }
   } 
 }
@@ -1548,7 +1539,7 @@ void planar_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSe
   cur     = r->GetID( ); 
   dest    = f->dest;
   in_vc   = f->vc;
-  vc_mult = gNumVCS / 3;
+  vc_mult = gSim->num_vcs / 3;
 
   if ( cur != dest ) {
    
@@ -1557,22 +1548,22 @@ void planar_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSe
     // of misrouting in the last adaptive plane.
     // In this case, go to the last dimension instead.
 
-    for ( n = 0; n < gN; ++n ) {
-      if ( ( ( cur % gK ) != ( dest % gK ) ) &&
+    for ( n = 0; n < gSim->n; ++n ) {
+      if ( ( ( cur % gSim->k ) != ( dest % gSim->k ) ) &&
 	   !( ( in_channel/2 == 0 ) &&
 	      ( n == 0 ) &&
 	      ( in_vc < 2*vc_mult ) ) ) {
 	break;
       }
 
-      cur  /= gK;
-      dest /= gK;
+      cur  /= gSim->k;
+      dest /= gSim->k;
     }
 
-    assert( n < gN );
+    assert( n < gSim->n );
 
     if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "PLANAR ADAPTIVE: flit " << f->id 
 		  << " in adaptive plane " << n << "." << endl;
     }
@@ -1580,14 +1571,14 @@ void planar_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSe
     // We're in adaptive plane n
 
     // Can route productively in d_{i,2}
-    if ( ( cur % gK ) < ( dest % gK ) ) { // Increasing
+    if ( ( cur % gSim->k ) < ( dest % gSim->k ) ) { // Increasing
       increase = true;
       if ( !r->IsFaultyOutput( 2*n ) ) {
-	outputs->AddRange( 2*n, 2*vc_mult, gNumVCS - 1 );
+	outputs->AddRange( 2*n, 2*vc_mult, gSim->num_vcs - 1 );
 	fault = false;
 
 	if ( f->watch ) {
-	  *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		      << "PLANAR ADAPTIVE: increasing in dimension " << n
 		      << "." << endl;
 	}
@@ -1597,11 +1588,11 @@ void planar_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSe
     } else { // Decreasing
       increase = false;
       if ( !r->IsFaultyOutput( 2*n + 1 ) ) {
-	outputs->AddRange( 2*n + 1, 2*vc_mult, gNumVCS - 1 ); 
+	outputs->AddRange( 2*n + 1, 2*vc_mult, gSim->num_vcs - 1 ); 
 	fault = false;
 
 	if ( f->watch ) {
-	  *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		      << "PLANAR ADAPTIVE: decreasing in dimension " << n
 		      << "." << endl;
 	}
@@ -1610,9 +1601,9 @@ void planar_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSe
       }
     }
       
-    n = ( n + 1 ) % gN;
-    cur  /= gK;
-    dest /= gK;
+    n = ( n + 1 ) % gSim->n;
+    cur  /= gSim->k;
+    dest /= gSim->k;
       
     if ( increase ) {
       vc_min = 0;
@@ -1622,9 +1613,9 @@ void planar_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSe
       vc_max = 2*vc_mult - 1;
     }
       
-    if ( ( cur % gK ) < ( dest % gK ) ) { // Increasing in d_{i+1}
+    if ( ( cur % gSim->k ) < ( dest % gSim->k ) ) { // Increasing in d_{i+1}
       d1_min_c = 2*n;
-    } else if ( ( cur % gK ) != ( dest % gK ) ) {  // Decreasing in d_{i+1}
+    } else if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) {  // Decreasing in d_{i+1}
       d1_min_c = 2*n + 1;
     } else {
       d1_min_c = -1;
@@ -1642,7 +1633,7 @@ void planar_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSe
       }
 
       if ( f->watch ) {
-	*gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		    << "PLANAR ADAPTIVE: avoiding 180 in dimension " << n
 		    << "." << endl;
       }
@@ -1656,10 +1647,10 @@ void planar_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSe
 	r->Error( "There seem to be faults in d_i and d_{i+1}" );
       }
     } else if ( fault ) { // need to misroute!
-      if ( cur % gK == 0 ) {
+      if ( cur % gSim->k == 0 ) {
 	d1_min_c = 2*n;
 	atedge = true;
-      } else if ( cur % gK == gK - 1 ) {
+      } else if ( cur % gSim->k == gSim->k - 1 ) {
 	d1_min_c = 2*n + 1;
 	atedge = true;
       } else {
@@ -1681,7 +1672,7 @@ void planar_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputSe
       }
     }
   } else {
-    outputs->AddRange( 2*gN, 0, gNumVCS - 1 ); 
+    outputs->AddRange( 2*gSim->n, 0, gSim->num_vcs - 1 ); 
   }
 }
 
@@ -1702,7 +1693,7 @@ void limited_adapt_mesh_old( const Router *r, const Flit *f, int in_channel, Out
   outputs->Clear( );
 
   if ( inject ) {
-    outputs->AddRange( 0, 0, gNumVCS - 1 );
+    outputs->AddRange( 0, 0, gSim->num_vcs - 1 );
     f->ph = 0; // zero dimension reversals
   } else {
 
@@ -1722,9 +1713,9 @@ void limited_adapt_mesh_old( const Router *r, const Flit *f, int in_channel, Out
       // The first remaining is the DOR escape path
       dor_dim = true;
 
-      for ( int n = 0; n < gN; ++n ) {
-	if ( ( cur % gK ) != ( dest % gK ) ) { 
-	  if ( ( cur % gK ) < ( dest % gK ) ) { 
+      for ( int n = 0; n < gSim->n; ++n ) {
+	if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) { 
+	  if ( ( cur % gSim->k ) < ( dest % gSim->k ) ) { 
 	    min_port = 2*n; // Right
 	  } else {
 	    min_port = 2*n + 1; // Left
@@ -1732,7 +1723,7 @@ void limited_adapt_mesh_old( const Router *r, const Flit *f, int in_channel, Out
 	  
 	  if ( dor_dim ) {
 	    // Low priority escape path
-	    outputs->AddRange( min_port, gNumVCS - 1, gNumVCS - 1, 0 ); 
+	    outputs->AddRange( min_port, gSim->num_vcs - 1, gSim->num_vcs - 1, 0 ); 
 	    dor_dim = false;
 	  }
 	  
@@ -1742,43 +1733,43 @@ void limited_adapt_mesh_old( const Router *r, const Flit *f, int in_channel, Out
 	  min_port = 2*n;
 	}
 	
-	if ( in_vc < gNumVCS - 1 ) {  // adaptive VC's left?
+	if ( in_vc < gSim->num_vcs - 1 ) {  // adaptive VC's left?
 	  if ( n < in_dim ) {
 	    // Productive (minimal) direction, with reversal
-	    if ( in_vc == gNumVCS - 2 ) {
+	    if ( in_vc == gSim->num_vcs - 2 ) {
 	      outputs->AddRange( min_port, in_vc + 1, in_vc + 1, equal ? 1 : 2 ); 
 	    } else {
-	      outputs->AddRange( min_port, in_vc + 1, gNumVCS - 2, equal ? 1 : 2 ); 
+	      outputs->AddRange( min_port, in_vc + 1, gSim->num_vcs - 2, equal ? 1 : 2 ); 
 	    }
 
 	    // Unproductive (non-minimal) direction, with reversal
-	    if ( in_vc <  gNumVCS - 2 ) {
-	      if ( in_vc == gNumVCS - 3 ) {
+	    if ( in_vc <  gSim->num_vcs - 2 ) {
+	      if ( in_vc == gSim->num_vcs - 3 ) {
 		outputs->AddRange( min_port ^ 0x1, in_vc + 1, in_vc + 1, 1 );
 	      } else {
-		outputs->AddRange( min_port ^ 0x1, in_vc + 1, gNumVCS - 3, 1 );
+		outputs->AddRange( min_port ^ 0x1, in_vc + 1, gSim->num_vcs - 3, 1 );
 	      }
 	    }
 	  } else if ( n == in_dim ) {
 	    if ( !equal ) {
 	      // Productive (minimal) direction, no reversal
-	      outputs->AddRange( min_port, in_vc, gNumVCS - 2, 4 ); 
+	      outputs->AddRange( min_port, in_vc, gSim->num_vcs - 2, 4 ); 
 	    }
 	  } else {
 	    // Productive (minimal) direction, no reversal
-	    outputs->AddRange( min_port, in_vc, gNumVCS - 2, equal ? 1 : 3 ); 
+	    outputs->AddRange( min_port, in_vc, gSim->num_vcs - 2, equal ? 1 : 3 ); 
 	    // Unproductive (non-minimal) direction, no reversal
-	    if ( in_vc <  gNumVCS - 2 ) {
-	      outputs->AddRange( min_port ^ 0x1, in_vc, gNumVCS - 2, 1 );
+	    if ( in_vc <  gSim->num_vcs - 2 ) {
+	      outputs->AddRange( min_port ^ 0x1, in_vc, gSim->num_vcs - 2, 1 );
 	    }
 	  }
 	}
 	
-	cur  /= gK;
-	dest /= gK;
+	cur  /= gSim->k;
+	dest /= gSim->k;
       }
     } else { // at destination
-      outputs->AddRange( 2*gN, 0, gNumVCS - 1 ); 
+      outputs->AddRange( 2*gSim->n, 0, gSim->num_vcs - 1 ); 
     }
   } 
 }
@@ -1792,45 +1783,45 @@ void limited_adapt_mesh( const Router *r, const Flit *f, int in_channel, OutputS
   outputs->Clear( );
 
   if ( inject ) {
-    outputs->AddRange( 0, 0, gNumVCS - 2 );
+    outputs->AddRange( 0, 0, gSim->num_vcs - 2 );
     f->dr = 0; // zero dimension reversals
   } else {
     cur = r->GetID( ); dest = f->dest;
 
     if ( cur != dest ) {
-      if ( ( f->vc != gNumVCS - 1 ) && 
-	   ( f->dr != gNumVCS - 2 ) ) {
+      if ( ( f->vc != gSim->num_vcs - 1 ) && 
+	   ( f->dr != gSim->num_vcs - 2 ) ) {
 	
-	for ( int n = 0; n < gN; ++n ) {
-	  if ( ( cur % gK ) != ( dest % gK ) ) { 
-	    if ( ( cur % gK ) < ( dest % gK ) ) { 
+	for ( int n = 0; n < gSim->n; ++n ) {
+	  if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) { 
+	    if ( ( cur % gSim->k ) < ( dest % gSim->k ) ) { 
 	      min_port = 2*n; // Right
 	    } else {
 	      min_port = 2*n + 1; // Left
 	    }
 	    
 	    // Go in a productive direction with high priority
-	    outputs->AddRange( min_port, 0, gNumVCS - 2, 2 );
+	    outputs->AddRange( min_port, 0, gSim->num_vcs - 2, 2 );
 	  
 	    // Go in the non-productive direction with low priority
-	    outputs->AddRange( min_port ^ 0x1, 0, gNumVCS - 2, 1 );
+	    outputs->AddRange( min_port ^ 0x1, 0, gSim->num_vcs - 2, 1 );
 	  } else {
 	    // Both directions are non-productive
-	    outputs->AddRange( 2*n, 0, gNumVCS - 2, 1 );
-	    outputs->AddRange( 2*n+1, 0, gNumVCS - 2, 1 );
+	    outputs->AddRange( 2*n, 0, gSim->num_vcs - 2, 1 );
+	    outputs->AddRange( 2*n+1, 0, gSim->num_vcs - 2, 1 );
 	  }
 	  
-	  cur  /= gK;
-	  dest /= gK;
+	  cur  /= gSim->k;
+	  dest /= gSim->k;
 	}
 	
       } else {
 	outputs->AddRange( dor_next_mesh( cur, dest ),
-			   gNumVCS - 1, gNumVCS - 1, 0 );
+			   gSim->num_vcs - 1, gSim->num_vcs - 1, 0 );
       }
       
     } else { // at destination
-      outputs->AddRange( 2*gN, 0, gNumVCS - 1 ); 
+      outputs->AddRange( 2*gSim->n, 0, gSim->num_vcs - 1 ); 
     }
   } 
 }
@@ -1845,9 +1836,9 @@ void valiant_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *ou
   outputs->Clear( );
 
 
-  if ( in_channel == 2*gN ) {
+  if ( in_channel == 2*gSim->n ) {
     f->ph   = 1;  // Phase 1
-    f->intm = RandomInt( gNodes - 1 );
+    f->intm = RandomInt( gSim->nodes - 1 );
   }
 
   if ( ( f->ph == 1 ) && ( r->GetID( ) == f->intm ) ) {
@@ -1862,19 +1853,19 @@ void valiant_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *ou
     //each class must have ast east 2 vcs assigned or else valiant valiant will deadlock
   int available_vcs = 0;
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    vc_min = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    vc_min = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-   available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-   vc_min = gWriteReqBeginVC;
+   available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+   vc_min = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-   available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-   vc_min = gReadReplyBeginVC;
+   available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+   vc_min = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-   available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;      
-   vc_min = gWriteReplyBeginVC;
+   available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;      
+   vc_min = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = gNumVCS;
+    available_vcs = gSim->num_vcs;
     vc_min = 0;
   }
   assert( available_vcs>=2);
@@ -1897,14 +1888,14 @@ void valiant_torus( const Router *r, const Flit *f, int in_channel, OutputSet *o
 
   outputs->Clear( );
 
-  if ( in_channel == 2*gN ) {
+  if ( in_channel == 2*gSim->n ) {
     f->ph   = 1;  // Phase 1
-    f->intm = RandomInt( gNodes - 1 );
+    f->intm = RandomInt( gSim->nodes - 1 );
   }
 
   if ( ( f->ph == 1 ) && ( r->GetID( ) == f->intm ) ) {
     f->ph = 2; // Go to phase 2
-    in_channel = 2*gN; // ensures correct vc selection at the beginning of phase 2
+    in_channel = 2*gSim->n; // ensures correct vc selection at the beginning of phase 2
   }
   
   if ( f->ph == 1 ) { // In phase 1
@@ -1919,19 +1910,19 @@ void valiant_torus( const Router *r, const Flit *f, int in_channel, OutputSet *o
   int begin_vcs = -1;
   int available_vcs = 0;
   if ( f->type == Flit::READ_REQUEST ) {
-    available_vcs = (gReadReqEndVC-gReadReqBeginVC)+1;
-    begin_vcs = gReadReqBeginVC;
+    available_vcs = (gSim->read_req_end_vc-gSim->read_req_begin_vc)+1;
+    begin_vcs = gSim->read_req_begin_vc;
   } else if ( f->type == Flit::WRITE_REQUEST ) {
-    available_vcs = (gWriteReqEndVC-gWriteReqBeginVC)+1;
-    begin_vcs = gWriteReqBeginVC;
+    available_vcs = (gSim->write_req_end_vc-gSim->write_req_begin_vc)+1;
+    begin_vcs = gSim->write_req_begin_vc;
   } else if ( f->type ==  Flit::READ_REPLY ) {
-    available_vcs = (gReadReplyEndVC-gReadReplyBeginVC)+1;
-    begin_vcs = gReadReplyBeginVC;
+    available_vcs = (gSim->read_reply_end_vc-gSim->read_reply_begin_vc)+1;
+    begin_vcs = gSim->read_reply_begin_vc;
   } else if ( f->type ==  Flit::WRITE_REPLY ) {
-    available_vcs = (gWriteReplyEndVC-gWriteReplyBeginVC)+1;
-    begin_vcs = gWriteReplyBeginVC;
+    available_vcs = (gSim->write_reply_end_vc-gSim->write_reply_begin_vc)+1;
+    begin_vcs = gSim->write_reply_begin_vc;
   } else if ( f->type ==  Flit::ANY_TYPE ) {
-    available_vcs = (gNumVCS);
+    available_vcs = (gSim->num_vcs);
     begin_vcs = 0;
   }
 
@@ -1962,14 +1953,14 @@ void valiant_ni_torus( const Router *r, const Flit *f, int in_channel,
 
   outputs->Clear( );
 
-  if ( in_channel == 2*gN ) {
+  if ( in_channel == 2*gSim->n ) {
     f->ph   = 1;  // Phase 1
-    f->intm = RandomInt( gNodes - 1 );
+    f->intm = RandomInt( gSim->nodes - 1 );
   }
 
   if ( ( f->ph == 1 ) && ( r->GetID( ) == f->intm ) ) {
     f->ph = 2; // Go to phase 2
-    in_channel = 2*gN; // ensures correct vc selection at the beginning of phase 2
+    in_channel = 2*gSim->n; // ensures correct vc selection at the beginning of phase 2
   }
   
   if ( f->ph == 1 ) { // In phase 1
@@ -1980,8 +1971,8 @@ void valiant_ni_torus( const Router *r, const Flit *f, int in_channel,
 	vc_min = f->dest;
 	vc_max = f->dest;
       } else {
-	vc_min = f->dest + gNodes;
-	vc_max = f->dest + gNodes;
+	vc_min = f->dest + gSim->nodes;
+	vc_max = f->dest + gSim->nodes;
       }
 
   } else { // In phase 2
@@ -1989,16 +1980,16 @@ void valiant_ni_torus( const Router *r, const Flit *f, int in_channel,
 		     &out_port, &f->ring_par, false );
     
     if ( f->ring_par == 0 ) {
-      vc_min = f->dest + 2*gNodes;
-      vc_max = f->dest + 2*gNodes;
+      vc_min = f->dest + 2*gSim->nodes;
+      vc_max = f->dest + 2*gSim->nodes;
     } else {
-      vc_min = f->dest + 3*gNodes;
-      vc_max = f->dest + 3*gNodes;
+      vc_min = f->dest + 3*gSim->nodes;
+      vc_max = f->dest + 3*gSim->nodes;
     }
   }
 
   if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "Adding VC range [" 
 		  << vc_min << "," 
 		  << vc_max << "]"
@@ -2034,24 +2025,24 @@ void dim_order_torus( const Router *r, const Flit *f, int in_channel,
   int vc_class_min, vc_class_max ;
   switch(f->type) {
   case Flit::READ_REQUEST:
-    vc_class_min = gReadReqBeginVC;
-    vc_class_max = gReadReqEndVC;
+    vc_class_min = gSim->read_req_begin_vc;
+    vc_class_max = gSim->read_req_end_vc;
     break;
   case Flit::WRITE_REQUEST:
-    vc_class_min = gWriteReqBeginVC;
-    vc_class_max = gWriteReqEndVC;
+    vc_class_min = gSim->write_req_begin_vc;
+    vc_class_max = gSim->write_req_end_vc;
     break;
   case Flit::READ_REPLY:
-    vc_class_min = gReadReplyBeginVC;
-    vc_class_max = gReadReplyEndVC;
+    vc_class_min = gSim->read_reply_begin_vc;
+    vc_class_max = gSim->read_reply_end_vc;
     break;
   case Flit::WRITE_REPLY:
-    vc_class_min = gWriteReplyBeginVC;
-    vc_class_max = gWriteReplyEndVC;
+    vc_class_min = gSim->write_reply_begin_vc;
+    vc_class_max = gSim->write_reply_end_vc;
     break;
   case Flit::ANY_TYPE:
     vc_class_min = 0;
-    vc_class_max = gNumVCS-1;
+    vc_class_max = gSim->num_vcs-1;
   }
   
   int vc_class_size = vc_class_max - vc_class_min ;
@@ -2064,7 +2055,7 @@ void dim_order_torus( const Router *r, const Flit *f, int in_channel,
   } 
   
   if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "Adding VC range [" 
 		  << vc_min << "," 
 		  << vc_max << "]"
@@ -2087,7 +2078,7 @@ void dim_order_ni_torus( const Router *r, const Flit *f, int in_channel,
   int dest;
 
   int out_port;
-  int vcs_per_dest = gNumVCS / gNodes;
+  int vcs_per_dest = gSim->num_vcs / gSim->nodes;
 
   outputs->Clear( );
 
@@ -2099,7 +2090,7 @@ void dim_order_ni_torus( const Router *r, const Flit *f, int in_channel,
 		  &out_port, &f->ring_par, false );
 
   if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "Adding VC range [" 
 		  << f->dest*vcs_per_dest << "," 
 		  << (f->dest+1)*vcs_per_dest << "]"
@@ -2137,24 +2128,24 @@ void dim_order_bal_torus( const Router *r, const Flit *f, int in_channel,
   // ( Traffic Class ) -> Virtual Channel Range
   switch(f->type) {
   case Flit::READ_REQUEST:
-    vc_class_min = gReadReqBeginVC ;
-    vc_class_max = gReadReqEndVC ;
+    vc_class_min = gSim->read_req_begin_vc ;
+    vc_class_max = gSim->read_req_end_vc ;
     break;
   case Flit::WRITE_REQUEST:
-    vc_class_min = gWriteReqBeginVC ;
-    vc_class_max = gWriteReqEndVC ;
+    vc_class_min = gSim->write_req_begin_vc ;
+    vc_class_max = gSim->write_req_end_vc ;
     break;
   case Flit::READ_REPLY:
-    vc_class_min = gReadReplyBeginVC ;
-    vc_class_max = gReadReplyEndVC ;
+    vc_class_min = gSim->read_reply_begin_vc ;
+    vc_class_max = gSim->read_reply_end_vc ;
     break;
   case Flit::WRITE_REPLY:
-    vc_class_min = gWriteReplyBeginVC ;
-    vc_class_max = gWriteReplyEndVC ;
+    vc_class_min = gSim->write_reply_begin_vc ;
+    vc_class_max = gSim->write_reply_end_vc ;
     break;
   case Flit::ANY_TYPE:
     vc_class_min = 0;
-    vc_class_max = gNumVCS-1;
+    vc_class_max = gSim->num_vcs-1;
   }
 
   int vc_class_size = vc_class_max - vc_class_min ;
@@ -2167,7 +2158,7 @@ void dim_order_bal_torus( const Router *r, const Flit *f, int in_channel,
   } 
   
   if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "Adding VC range [" 
 		  << vc_min << "," 
 		  << vc_max << "]"
@@ -2191,8 +2182,8 @@ void min_adapt_torus( const Router *r, const Flit *f, int in_channel, OutputSet
 
   outputs->Clear( );
   
-  if ( in_channel == 2*gN ) {
-    in_vc = gNumVCS - 1; // ignore the injection VC
+  if ( in_channel == 2*gSim->n ) {
+    in_vc = gSim->num_vcs - 1; // ignore the injection VC
   } else {
     in_vc = f->vc;
   }
@@ -2201,9 +2192,9 @@ void min_adapt_torus( const Router *r, const Flit *f, int in_channel, OutputSet
     // Minimal adaptive for all other channels
     cur = r->GetID( ); dest = f->dest;
     
-    for ( int n = 0; n < gN; ++n ) {
-      if ( ( cur % gK ) != ( dest % gK ) ) {
-	dist2 = gK - 2 * ( ( ( dest % gK ) - ( cur % gK ) + gK ) % gK );
+    for ( int n = 0; n < gSim->n; ++n ) {
+      if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) {
+	dist2 = gSim->k - 2 * ( ( ( dest % gSim->k ) - ( cur % gSim->k ) + gSim->k ) % gSim->k );
 	
 	if ( dist2 > 0 ) { /*) || 
 			     ( ( dist2 == 0 ) && ( RandomInt( 1 ) ) ) ) {*/
@@ -2213,14 +2204,14 @@ void min_adapt_torus( const Router *r, const Flit *f, int in_channel, OutputSet
 	}
       }
 
-      cur  /= gK;
-      dest /= gK;
+      cur  /= gSim->k;
+      dest /= gSim->k;
     }
     
     // DOR for the escape channel (VCs 0-1), low priority --- 
     // trick the algorithm with the in channel.  want VC assignment
     // as if we had injected at this node
-    dor_next_torus( r->GetID( ), f->dest, 2*gN,
+    dor_next_torus( r->GetID( ), f->dest, 2*gSim->n,
 		    &out_port, &f->ring_par, false );
   } else {
     // DOR for the escape channel (VCs 0-1), low priority 
@@ -2235,10 +2226,10 @@ void min_adapt_torus( const Router *r, const Flit *f, int in_channel, OutputSet
   } 
   
   if ( f->watch ) {
-      *gWatchOut << GetSimTime() << " | " << r->FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << r->FullName() << " | "
 		  << "Adding VC range [" 
 		  << 0 << "," 
-		  << gNumVCS - 1 << "]"
+		  << gSim->num_vcs - 1 << "]"
 		  << " at output port " << out_port
 		  << " for flit " << f->id
 		  << " (input port " << in_channel
@@ -2256,17 +2247,17 @@ void dest_tag( const Router *r, const Flit *f, int in_channel,
 {
   outputs->Clear( );
 
-  int stage = ( r->GetID( ) * gK ) / gNodes;
+  int stage = ( r->GetID( ) * gSim->k ) / gSim->nodes;
   int dest  = f->dest;
 
-  while( stage < ( gN - 1 ) ) {
-    dest /= gK;
+  while( stage < ( gSim->n - 1 ) ) {
+    dest /= gSim->k;
     ++stage;
   }
 
-  int out_port = dest % gK;
+  int out_port = dest % gSim->k;
 
-  outputs->AddRange( out_port, 0, gNumVCS - 1 );
+  outputs->AddRange( out_port, 0, gSim->num_vcs - 1 );
 }
 
 
@@ -2284,10 +2275,10 @@ void chaos_torus( const Router *r, const Flit *f,
   cur = r->GetID( ); dest = f->dest;
   
   if ( cur != dest ) {
-    for ( int n = 0; n < gN; ++n ) {
+    for ( int n = 0; n < gSim->n; ++n ) {
 
-      if ( ( cur % gK ) != ( dest % gK ) ) { 
-	dist2 = gK - 2 * ( ( ( dest % gK ) - ( cur % gK ) + gK ) % gK );
+      if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) { 
+	dist2 = gSim->k - 2 * ( ( ( dest % gSim->k ) - ( cur % gSim->k ) + gSim->k ) % gSim->k );
       
 	if ( dist2 >= 0 ) {
 	  outputs->AddRange( 2*n, 0, 0 ); // Right
@@ -2298,11 +2289,11 @@ void chaos_torus( const Router *r, const Flit *f,
 	}
       }
 
-      cur  /= gK;
-      dest /= gK;
+      cur  /= gSim->k;
+      dest /= gSim->k;
     }
   } else {
-    outputs->AddRange( 2*gN, 0, 0 ); 
+    outputs->AddRange( 2*gSim->n, 0, 0 ); 
   }
 }
 
@@ -2319,20 +2310,20 @@ void chaos_mesh( const Router *r, const Flit *f,
   cur = r->GetID( ); dest = f->dest;
   
   if ( cur != dest ) {
-    for ( int n = 0; n < gN; ++n ) {
-      if ( ( cur % gK ) != ( dest % gK ) ) { 
+    for ( int n = 0; n < gSim->n; ++n ) {
+      if ( ( cur % gSim->k ) != ( dest % gSim->k ) ) { 
 	// Add minimal direction in dimension 'n'
-	if ( ( cur % gK ) < ( dest % gK ) ) { // Right
+	if ( ( cur % gSim->k ) < ( dest % gSim->k ) ) { // Right
 	  outputs->AddRange( 2*n, 0, 0 ); 
 	} else { // Left
 	  outputs->AddRange( 2*n + 1, 0, 0 ); 
 	}
       }
-      cur  /= gK;
-      dest /= gK;
+      cur  /= gSim->k;
+      dest /= gSim->k;
     }
   } else {
-    outputs->AddRange( 2*gN, 0, 0 ); 
+    outputs->AddRange( 2*gSim->n, 0, 0 ); 
   }
 }
 
@@ -2350,7 +2341,8 @@ void InitializeRoutingMap( )
   gRoutingFunctionMap["nca_tree4"]           = &tree4_nca;
   gRoutingFunctionMap["anca_tree4"]          = &tree4_anca;
   gRoutingFunctionMap["dor_mesh"]            = &dor_mesh;
-  gRoutingFunctionMap["rajagiri_mesh"]            = &rajagiri_mesh;
+  gRoutingFunctionMap["rajagiri_mesh"]            = &rajagiri;
+  gRoutingFunctionMap["rajagiri_torus"]           = &rajagiri;
   gRoutingFunctionMap["oddeven_mesh"]        = &oddeven_mesh;//added by KVM
   gRoutingFunctionMap["oddeven_modified_mesh"]        = &oddeven_modified_mesh;//added by KVM
   gRoutingFunctionMap["west_first_mesh"]     = &west_first_mesh;//added by KVM
@@ -2398,25 +2390,25 @@ tRoutingFunction GetRoutingFunction( const Configuration& config )
 
   string fn, topo, fn_topo;
 
-  gNumVCS = config.GetInt( "num_vcs" );
+  gSim->num_vcs = config.GetInt( "num_vcs" );
 
   // memoize 
-  memo_log2gC = log_two( gC ) ;
+  gSim->log2_c = log_two( gSim->c ) ;
   
   //
   // traffic class partitions
   //
-  gReadReqBeginVC    = config.GetInt("read_request_begin_vc");
-  gReadReqEndVC      = config.GetInt("read_request_end_vc");
+  gSim->read_req_begin_vc    = config.GetInt("read_request_begin_vc");
+  gSim->read_req_end_vc      = config.GetInt("read_request_end_vc");
 
-  gWriteReqBeginVC   = config.GetInt("write_request_begin_vc");
-  gWriteReqEndVC     = config.GetInt("write_request_end_vc");
+  gSim->write_req_begin_vc   = config.GetInt("write_request_begin_vc");
+  gSim->write_req_end_vc     = config.GetInt("write_request_end_vc");
 
-  gReadReplyBeginVC  = config.GetInt("read_reply_begin_vc");
-  gReadReplyEndVC    = config.GetInt("read_reply_end_vc");
+  gSim->read_reply_begin_vc  = config.GetInt("read_reply_begin_vc");
+  gSim->read_reply_end_vc    = config.GetInt("read_reply_end_vc");
 
-  gWriteReplyBeginVC = config.GetInt("write_reply_begin_vc");
-  gWriteReplyEndVC   = config.GetInt("write_reply_end_vc");
+  gSim->write_reply_begin_vc = config.GetInt("write_reply_begin_vc");
+  gSim->write_reply_end_vc   = config.GetInt("write_reply_end_vc");
 
   config.GetStr( "topology", topo );
 
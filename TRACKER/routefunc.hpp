@@ -35,19 +35,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "router.hpp"
 #include "outputset.hpp"
 #include "config_utils.hpp"
+#include "globals.hpp"
 
 typedef void (*tRoutingFunction)( const Router *, const Flit *, int in_channel, OutputSet *, bool );
 
 void InitializeRoutingMap( );
+void rajagiri( const Router *r, const Flit *f, int in_channel, OutputSet *outputs, bool inject );
+void rajagiri_next_hop( const Flit *f, int *out_port, int *vc_start, int *vc_end );
 int fattree_transformation(int dest);
 tRoutingFunction GetRoutingFunction( const Configuration& config );
 
 extern map<string, tRoutingFunction> gRoutingFunctionMap;
-extern int gNumVCS;
-extern int gReadReqBeginVC, gReadReqEndVC;
-extern int gWriteReqBeginVC, gWriteReqEndVC;
-extern int gReadReplyBeginVC, gReadReplyEndVC;
-extern int gWriteReplyBeginVC, gWriteReplyEndVC;
-extern int memo_log2gC ;
 
 #endif
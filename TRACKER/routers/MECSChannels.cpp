@@ -49,13 +49,13 @@ MECSChannels::MECSChannels(Module* parent, string name, int source, int directio
     int router = source_router;
     switch(direction){
     case 0:
-      router = source_router-i*gK;
+      router = source_router-i*gSim->k;
       break;
     case 1:
       router = source_router+i;
       break;
     case 2:
-      router = source_router+i*gK;
+      router = source_router+i*gSim->k;
       break;
     case 3:
       router = source_router-i;
@@ -67,7 +67,7 @@ void MECSCombiner::ReadInputs(){
     f = inputs.at(location)->ReceiveFlit();
     assert(f);
     if(f->watch){
-      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		  <<f->id<<" load into router "<<router<<endl;
     }
   }
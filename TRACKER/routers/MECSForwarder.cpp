@@ -62,22 +62,22 @@ void MECSForwarder::ReadInputs(){
   Flit *f = chan_in->Receive();
   if(f){
     if(f->watch){
-      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		  <<f->id<<" at Forwarder "<<location<<endl;
     }
     //shoudl the flit be dropped off here?
-    if((int)(mecs_transformation(f->intm)/gK) == location ||(int)(mecs_transformation(f->dest)/gK) == location){
+    if((int)(mecs_transformation(f->intm)/gSim->k) == location ||(int)(mecs_transformation(f->dest)/gSim->k) == location){
       flit_queue.push(f);
       assert(flit_queue.size()<100); //if this trips, soemthign is wrong
       ff = 0; //terminate if reached the destination
       if(f->watch){
-	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		    <<f->id<<" halted at Forwarder "<<location<<endl;
       }
     } else {
       ff = f;
       if(f->watch){
-	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		    <<f->id<<" moved at Forwarder "<<location<<endl;
       }
     }
@@ -274,12 +274,12 @@ void MECSRouter::WriteOutputs( ) {
 }
 
 //the credit channels are "reversed"
-//injection ejection ports stays the same (i<gK)
+//injection ejection ports stays the same (i<gSim->k)
 //other wise, what use to be called "input credit channel" 
 //is now actually output credit chcannels
 void MECSRouter::Finalize(){
   for( int i = 0; i<_inputs; i++){
-    if(i<gK){
+    if(i<gSim->k){
       sub_router->AddInputChannel(_input_channels->at(i), _input_credits->at(i));
     } else {
 
@@ -288,7 +288,7 @@ void MECSRouter::Finalize(){
   }
 
   for(int i = 0; i<_outputs; i++){
-    if(i<gK){
+    if(i<gSim->k){
       sub_router->AddOutputChannel(_output_channels->at(i), _output_credits->at(i));
     } else {
       sub_router->AddOutputChannel(_output_channels->at(i), _input_credits->at(i));
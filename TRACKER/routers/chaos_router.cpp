@@ -159,7 +159,7 @@ ChaosRouter::~ChaosRouter( )
       _input_frame[input].push( f );
 
       if ( f->watch ) {
-	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		    << "Flit arriving at " << FullName() 
 		    << " on channel " << input << endl
 		    << *f;
@@ -240,7 +240,7 @@ ChaosRouter::~ChaosRouter( )
 	Error( "Next queue count fell below zero!" );
       }
 
-      delete c;
+      _RetireCredit( c );
     }
   }
 }
@@ -533,7 +533,7 @@ void ChaosRouter::_OutputAdvance( )
 	_crossbar_pipe->Write( f, _input_output_match[i] );
 	
 	if ( f->watch ) {
-	  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		      << "Flit traversing crossbar from input queue " 
 		      << i << " at " 
 		      << FullName() << endl
@@ -574,7 +574,7 @@ void ChaosRouter::_OutputAdvance( )
 	_multi_queue[mq].push( f );
 	
 	if ( f->watch ) {
-	  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		      << "Flit stored in multiqueue at " 
 		      << FullName() << endl
 		      << "State = " << _multi_state[mq] << endl
@@ -622,7 +622,7 @@ void ChaosRouter::_OutputAdvance( )
       _crossbar_pipe->Write( f, _multi_match[m] );
 
       if ( f->watch ) {
-	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		    << "Flit traversing crossbar from multiqueue slot "
 		    << m << " at " 
 		    << FullName() << endl
@@ -54,6 +54,7 @@ IQRouterBase::IQRouterBase( const Configuration& config,
   _vc_size     = config.GetInt( "vc_buf_size" );
 
   _routing_delay    = config.GetInt( "routing_delay" );
+  _lookahead_routing = ( config.GetInt( "lookahead_routing" ) != 0 );
   _vc_alloc_delay   = config.GetInt( "vc_alloc_delay" );
   _sw_alloc_delay   = config.GetInt( "sw_alloc_delay" );
   
@@ -63,6 +64,8 @@ IQRouterBase::IQRouterBase( const Configuration& config,
 //cout<<"after routing"<<endl;
   // Alloc VC's
   _vc.resize(_inputs);
+  _routing_vcs.Reserve(_inputs*_vcs);
+  _vcalloc_vcs.Resize(_inputs*_vcs);
   for ( int i = 0; i < _inputs; ++i ) {
     _vc[i].resize(_vcs);
     for (int j = 0; j < _vcs; ++j ) {
@@ -177,57 +180,63 @@ void IQRouterBase::_ReceiveFlits( )
     // **********
         f->time_in_router=GetSimTime();    //shankar
       f->in_port=input;					//shankar
-      has_input[input]=1;
-      has_input_vc[input][f->vc]=1;
+      if ( input < METRIC_PORTS ) {
+        has_input[input]=1;
+        has_input_vc[input][f->vc]=1;
+      }
 // **************
       if ( cur_vc->GetState( ) == VC::idle ) {
 	  if ( !f->head ) {
 	    Error( "Received non-head flit at idle VC" );
 	  }
-	  cur_vc->SetState( VC::routing );
-	  _routing_vcs.push(input*_vcs+f->vc);
+	  if ( _LookAheadRoute( cur_vc, f ) ) {
+	    _vcalloc_vcs.Set(input*_vcs+f->vc);
+	  } else {
+	    cur_vc->SetState( VC::routing );
+	    _routing_vcs.Push(input*_vcs+f->vc);
+	  }
       }
 //added by KVM
   if(f->id==28760)
   {
-      fp<<GetSimTime() << " | " << FullName() << " | "
+      gSim->Trace( )<<GetSimTime() << " | " << FullName() << " | "
 		   << "Adding flit " << f->id
 		   << " to VC " << f->vc
 		   << " at input " << input
 		   << " (state: " << VC::VCSTATE[cur_vc->GetState()];
 	if(cur_vc->Empty())
 		 {
-	  		fp << ", empty";
+	  		gSim->Trace( ) << ", empty";
 		}
 		 else 
 		 {
 	  		assert(cur_vc->FrontFlit());
-	  		fp << ", front: " << cur_vc->FrontFlit()->id;
+	  		gSim->Trace( ) << ", front: " << cur_vc->FrontFlit()->id;
 		}
-		fp << ")." << endl;
-		fp << GetSimTime() << " | " << FullName() << " | "
+		gSim->Trace( ) << ")." << endl;
+		gSim->Trace( ) << GetSimTime() << " | " << FullName() << " | "
 		   << "Received flit " << f->id
 		   << " from channel at input " << input
 		   << "." << endl;
  }
       if(f->watch) 
       {
-		*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+		*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		   << "Adding flit " << f->id
 		   << " to VC " << f->vc
 		   << " at input " << input
 		   << " (state: " << VC::VCSTATE[cur_vc->GetState()];
 		if(cur_vc->Empty())
 		 {
-	  		*gWatchOut << ", empty";
+	  		*gSim->watch_out << ", empty";
 		}
 		 else 
 		 {
 	  		assert(cur_vc->FrontFlit());
-	  		*gWatchOut << ", front: " << cur_vc->FrontFlit()->id;
+	  		*gSim->watch_out << ", front: " << cur_vc->FrontFlit()->id;
 		}
-		*gWatchOut << ")." << endl;
-		*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+		*gSim->watch_out << ")." << endl;
+		*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		   << "Received flit " << f->id
 		   << " from channel at input " << input
 		   << "." << endl;
@@ -251,9 +260,9 @@ void IQRouterBase::_ReceiveCredits( )
     if ( c ) 
     {
       /*if(c->id==28760)
-      fp<<"credit received.processed at"<<c->dest_router<<endl;*/
+      gSim->Trace( )<<"credit received.processed at"<<c->dest_router<<endl;*/
       _next_vcs[output]->ProcessCredit( c );
-      delete c;
+      _RetireCredit( c );
     }
   }
 }
@@ -287,20 +296,16 @@ void IQRouterBase::_InputQueuing( )
 //will be <routing delay
 void IQRouterBase::_Route( )
 {
-  int size = _routing_vcs.size();
+  int size = _routing_vcs.Size();
   for(int i = 0; i<size; i++){
-    int vc_encode = _routing_vcs.front();
+    int vc_encode = _routing_vcs.Front();
     VC * cur_vc = _vc[vc_encode/_vcs][vc_encode%_vcs];
     if(cur_vc->GetStateTime( ) >= _routing_delay){
       Flit * f = cur_vc->FrontFlit( );
-      if(f->itest<10)
-      f->itest++;
-      
-      
       cur_vc->Route( _rf, this, f,  vc_encode/_vcs);
       cur_vc->SetState( VC::vc_alloc ) ;
-      _vcalloc_vcs.insert(vc_encode);
-      _routing_vcs.pop();
+      _vcalloc_vcs.Set(vc_encode);
+      _routing_vcs.Pop();
     } else {
       break;
     }
@@ -308,6 +313,20 @@ void IQRouterBase::_Route( )
 
 }
 
+// look-ahead routing: a source routed head flit already carries its output
+// port, so it is decoded here and the VC goes straight to VC allocation
+bool IQRouterBase::_LookAheadRoute( VC *cur_vc, const Flit *f )
+{
+  if ( !_lookahead_routing || !f->route.words ) {
+    return false;
+  }
+  int out_port, vc_start, vc_end;
+  rajagiri_next_hop( f, &out_port, &vc_start, &vc_end );
+  cur_vc->SetRoute( out_port, vc_start, vc_end );
+  cur_vc->SetState( VC::vc_alloc );
+  return true;
+}
+
 void IQRouterBase::_OutputQueuing( )
 {
 
@@ -319,12 +338,12 @@ void IQRouterBase::_OutputQueuing( )
       if ( f ) {
 	_output_buffer[output].push( f );
 	if(f->id==28760)
-	  fp << GetSimTime() << " | " << FullName() << " | "
+	  gSim->Trace( ) << GetSimTime() << " | " << FullName() << " | "
 		      << "Buffering flit " << f->id
 		      << " at output " << output
 		      << "." << endl;
 	if(f->watch)
-	  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		      << "Buffering flit " << f->id
 		      << " at output " << output
 		      << "." << endl;
@@ -353,12 +372,12 @@ void IQRouterBase::_OutputQueuing( )
      _output_buffer[output].pop( );
       ++_sent_flits[output];
       if(f->id==28760)
-	fp << GetSimTime() << " | " << FullName() << " | "
+	gSim->Trace( ) << GetSimTime() << " | " << FullName() << " | "
 		    << "Sending flit " << f->id
 		    << " to channel at output " << output
 		    << "." << endl;
       if(f->watch)
-	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		    << "Sending flit " << f->id
 		    << " to channel at output " << output
 		    << "." << endl;
@@ -387,6 +406,7 @@ void IQRouterBase::_SendFlits( )
       f = _output_buffer[output].front( );
       f->from_router = this->GetID();
   	 //   if((GetSimTime()-f->time_in_router)>2)
+      if ( ( f->in_port < METRIC_PORTS ) && ( output < METRIC_PORTS ) )
       {
         this->cum_time_in_router[f->in_port]=this->cum_time_in_router[f->in_port]+(GetSimTime()-f->time_in_router)-1; // inport updation
 
@@ -402,7 +422,8 @@ void IQRouterBase::_SendFlits( )
                  
       }
     
-      this->flits_per_outport[output]++; //  shankar
+      if ( output < METRIC_PORTS )
+        this->flits_per_outport[output]++; //  shankar
       time_in=GetSimTime()-f->time_in_router;
       if(time_in<3)
       		bit_val=1;
@@ -415,6 +436,8 @@ void IQRouterBase::_SendFlits( )
       ++_sent_flits[output];
 	//if(has_input[f->in_port]);
 	//fluidity[f->in_port][f->vc]=1;
+	if ( f->in_port < METRIC_PORTS )
+	{
 	update_fluidity[f->in_port][f->vc]=1;
 	
 	for(int k=0;k<_vcs;k++)  // 4
@@ -431,13 +454,14 @@ void IQRouterBase::_SendFlits( )
 	}
        //    fluidity[f->in_port].x=fluidity[f->in_port].x & (int)pow(2,f->vc);
            flag[f->in_port]=0;
+	}
       if(f->id==28760)
-	fp << GetSimTime() << " | " << FullName() << " | "
+	gSim->Trace( ) << GetSimTime() << " | " << FullName() << " | "
 		    << "Sending flit " << f->id
 		    << " to channel at output " << output
 		    << "." << endl;
       if(f->watch)
-	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		    << "Sending flit " << f->id
 		    << " to channel at output " << output
 		    << "." << endl;
@@ -516,6 +540,46 @@ void IQRouterBase::_SendCredits( )
 
 
 
+// no flit or credit anywhere inside the router
+bool IQRouterBase::_Drained( ) const
+{
+  if ( !_routing_vcs.Empty( ) || !_vcalloc_vcs.Empty( ) ) {
+    return false;
+  }
+  for ( int input = 0; input < _inputs; ++input ) {
+    if ( !_in_cred_buffer[input].empty( ) ) {
+      return false;
+    }
+    for ( int vc = 0; vc < _vcs; ++vc ) {
+      if ( !_vc[input][vc]->Empty( ) || ( _vc[input][vc]->GetState( ) != VC::idle ) ) {
+	return false;
+      }
+    }
+  }
+  for ( int output = 0; output < _outputs; ++output ) {
+    if ( !_output_buffer[output].empty( ) ) {
+      return false;
+    }
+  }
+  for ( size_t s = 0; s < _switch_hold_in.size( ); ++s ) {
+    if ( _switch_hold_in[s] != -1 ) {
+      return false;
+    }
+  }
+  return _crossbar_pipe->Empty( ) && _credit_pipe->Empty( );
+}
+
+void IQRouterBase::_CatchUp( int cycles, int steps )
+{
+  bufferMonitor.skip( cycles );
+  switchMonitor.skip( steps );
+  for ( int input = 0; input < _inputs; ++input ) {
+    for ( int vc = 0; vc < _vcs; ++vc ) {
+      _vc[input][vc]->SkipIdle( steps );
+    }
+  }
+}
+
 void IQRouterBase::Display( ) const
 {
   for ( int input = 0; input < _inputs; ++input ) {
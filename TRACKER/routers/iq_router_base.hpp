@@ -39,6 +39,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "router.hpp"
 #include "routefunc.hpp"
 #include "pipefifo.hpp"
+#include "ring.hpp"
+#include "bitset.hpp"
 #include "trafficmanager.hpp"
 
 using namespace std;
@@ -57,6 +59,7 @@ class SwitchMonitor {
 public:
   SwitchMonitor( int inputs, int outputs ) ;
   void cycle() ;
+  void skip( int cycles ) { _cycles += cycles ; }
   int* GetActivity(){return _event;}
   int NumInputs(){return _inputs;}
   int NumOutputs(){return _outputs;}
@@ -74,6 +77,7 @@ class BufferMonitor {
 public:
   BufferMonitor( int inputs ) ;
   void cycle() ;
+  void skip( int cycles ) { _cycles += cycles ; }
   void write( int input, Flit* flit ) ;
   void read( int input, Flit* flit ) ;
   int* GetReads(){return _reads;}
@@ -89,8 +93,9 @@ protected:
   int  _vc_size ;
 
   //if a vc is in the vc::routing state, it is inserted here until routing_delay is up
-  queue<int> _routing_vcs;
-  set<int> _vcalloc_vcs;  
+  Ring<int> _routing_vcs;
+  // input*_vcs+vc of the VCs waiting for VC allocation
+  BitSet _vcalloc_vcs;
 
   vector<vector<VC *> > _vc;
   vector<BufferState *> _next_vcs;
@@ -101,6 +106,7 @@ protected:
   PipelineFIFO<Credit> * _credit_pipe;
   
   int _routing_delay;
+  bool _lookahead_routing;
   int _vc_alloc_delay;
   int _sw_alloc_delay;
   
@@ -123,11 +129,15 @@ protected:
 
   virtual void _InputQueuing( );
   virtual void _Route( );
+  bool _LookAheadRoute( VC *cur_vc, const Flit *f );
   virtual void _Alloc( ) = 0;
   virtual void _OutputQueuing( );
 
   void _SendFlits( );
   void _SendCredits( );
+
+  bool _Drained( ) const;
+  virtual void _CatchUp( int cycles, int steps );
   
   // ----------------------------------------
   //
@@ -150,6 +160,8 @@ public:
   virtual void WriteOutputs( );
   
   void Display( ) const;
+
+  int IdleVCs( ) const { return _inputs * _vcs; }
   
    
   virtual int GetCredit(int out, int vc_begin, int vc_end ) const;
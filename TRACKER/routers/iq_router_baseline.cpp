@@ -116,6 +116,14 @@ IQRouterBaseline::IQRouterBaseline( const Configuration& config,
   }
 
   _sw_rr_offset.resize(_inputs*_input_speedup);
+
+  _can_sleep = _vc_allocator->IdleSkippable( ) && _sw_allocator->IdleSkippable( ) &&
+    ( ( _speculative < 2 ) || _spec_sw_allocator->IdleSkippable( ) );
+
+  _sel = GetSelectionFunction( config );
+  if ( gSim->oddeven_ports.empty( ) ) {
+    _BuildOddEvenPorts( );
+  }
   //cout<<"eiq"<<endl;
 }
 
@@ -138,7 +146,7 @@ void IQRouterBaseline::_Alloc( )//for a particular router
 //priority is set based on the number of free vcs available at the port.
 //if the number of free vcs is less than half of total vcs at that port, then the priority is set as 0(least)
 //otherwise the priority remains the same as set by the routing function
-int set_pri_free_vcs(BufferState *dest_vc,list<OutputSet::sSetElement>::const_iterator iset,int num_vcs)//added by KVM
+int set_pri_free_vcs(BufferState *dest_vc,OutputSet::SetList::const_iterator iset,int num_vcs)//added by KVM
 {
 	int free_vcs=0;
 	for(int out_vc = iset->vc_start; out_vc <= iset->vc_end; ++out_vc )
@@ -153,7 +161,7 @@ int set_pri_free_vcs(BufferState *dest_vc,list<OutputSet::sSetElement>::const_it
 	return free_vcs;
 }
 //this is wrong.have to be modified 
-int IQRouterBaseline::set_pri_stress(list<OutputSet::sSetElement>::const_iterator iset)//added by KVM
+int IQRouterBaseline::set_pri_stress(OutputSet::SetList::const_iterator iset)//added by KVM
 {  
 	int busy_vcs=0;
 	BufferState *dest_vc;
@@ -172,7 +180,7 @@ int IQRouterBaseline::set_pri_stress(list<OutputSet::sSetElement>::const_iterato
 
 //priority is set based on the number of flits that have already passed through the router.
 //a router through which less flits have passed has higher priority and vice versa
-int set_pri_num_flits(Router* router,list<OutputSet::sSetElement>::const_iterator iset)
+int set_pri_num_flits(Router* router,OutputSet::SetList::const_iterator iset)
 {
 	//cout<<"in set_pri_num_flits";
 	//cout<<"router:"<<router->GetID()<<endl;
@@ -193,7 +201,7 @@ int set_pri_num_flits(Router* router,list<OutputSet::sSetElement>::const_iterato
 	
 	
 }
-int set_pri_num_flits_ports(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset)
+int set_pri_num_flits_ports(Flit* f, Router* router,OutputSet::SetList::const_iterator iset)
 {
 	Router* next_router;
 	int dest,cur,next,destx,desty,curx,cury,nextx,nexty;
@@ -202,13 +210,13 @@ int set_pri_num_flits_ports(Flit* f, Router* router,list<OutputSet::sSetElement>
 	vector<int>::iterator p;
 	dest=f->dest;
 	cur=router->GetID();
-	destx=dest%gK;
-  	desty=dest/gK;
-  	curx=cur%gK;
-  	cury=cur/gK;
+	destx=dest%gSim->k;
+  	desty=dest/gSim->k;
+  	curx=cur%gSim->k;
+  	cury=cur/gSim->k;
   	if(f->id==28760)
   	{
-  		fp<<"current router:"<<cur<<endl;
+  		gSim->Trace( )<<"current router:"<<cur<<endl;
   	}
 	if(iset->output_port==4)
 	{
@@ -222,10 +230,10 @@ int set_pri_num_flits_ports(Flit* f, Router* router,list<OutputSet::sSetElement>
 		next=next_router->GetID();
 		if(f->id==28760)
   		{
-  			fp<<"next router:"<<next<<endl;
+  			gSim->Trace( )<<"next router:"<<next<<endl;
   		}
-		nextx=next%gK;
-		nexty=next/gK;
+		nextx=next%gSim->k;
+		nexty=next/gSim->k;
 		if(nextx==destx && nexty==desty)
 			return iset->pri;
 		if(nextx<destx)
@@ -251,7 +259,7 @@ int set_pri_num_flits_ports(Flit* f, Router* router,list<OutputSet::sSetElement>
 }
 
 
-/*int set_pri_num_flits_ports_vcs(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc)
+/*int set_pri_num_flits_ports_vcs(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc)
 {
 	Router* next_router;
 	int dest,cur,next,destx,desty,curx,cury,nextx,nexty;
@@ -260,13 +268,13 @@ int set_pri_num_flits_ports(Flit* f, Router* router,list<OutputSet::sSetElement>
 	vector<int>::iterator p;
 	dest=f->dest;
 	cur=router->GetID();
-	destx=dest%gK;
-  	desty=dest/gK;
-  	curx=cur%gK;
-  	cury=cur/gK;
+	destx=dest%gSim->k;
+  	desty=dest/gSim->k;
+  	curx=cur%gSim->k;
+  	cury=cur/gSim->k;
   	if(f->id==28760)
   	{
-  		fp<<"current router:"<<cur<<endl;
+  		gSim->Trace( )<<"current router:"<<cur<<endl;
   	}
 	if(iset->output_port==4)
 	{
@@ -280,10 +288,10 @@ int set_pri_num_flits_ports(Flit* f, Router* router,list<OutputSet::sSetElement>
 		next=next_router->GetID();
 		if(f->id==28760)
   		{
-  			fp<<"next router:"<<next<<endl;
+  			gSim->Trace( )<<"next router:"<<next<<endl;
   		}
-		nextx=next%gK;
-		nexty=next/gK;
+		nextx=next%gSim->k;
+		nexty=next/gSim->k;
 		if(nextx==destx && nexty==desty)
 			return iset->pri;
 		if(nextx<destx)
@@ -321,20 +329,20 @@ int set_pri_num_flits_ports(Flit* f, Router* router,list<OutputSet::sSetElement>
 		return -mean_flits;
 	
 }*/
-int IQRouterBaseline::set_pri_num_flits_ports_vcs(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc)
+int IQRouterBaseline::set_pri_num_flits_ports_vcs(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc)
 {
 	Router* next_router;
 	int dest,cur,next,in_channel;
 	int sum_flits=0,mean_flits=0;
 	int* NOF;
-	vector<int> paths; 
-	vector<int>::iterator p;
+	unsigned paths;
+	int p;
 	dest=f->dest;
 	cur=router->GetID();
 	
   	if(f->id==176)
   	{
-  		fp<<"current router:"<<cur<<endl;
+  		gSim->Trace( )<<"current router:"<<cur<<endl;
   	}
 	if(iset->output_port==4)
 	{
@@ -366,20 +374,21 @@ int IQRouterBaseline::set_pri_num_flits_ports_vcs(Flit* f, Router* router,list<O
 		
 		if(f->id==176)
   		{
-  			fp<<"next router:"<<next<<endl;
+  			gSim->Trace( )<<"next router:"<<next<<endl;
   			
   		}
-  		oddeven_modified_paths( next, f,in_channel,&paths );
-  		for(p=paths.begin();p<paths.end();p++)
+  		paths=oddeven_modified_ports( next, f, in_channel );
+  		for(unsigned bits=paths;bits;bits&=bits-1)
   		{
+  			p=__builtin_ctz(bits);
   			if(f->id==176)
   			{
-  				fp<<"p is"<<*p<<endl;
-  				fp<<"nof is"<<NOF[(*p)];
+  				gSim->Trace( )<<"p is"<<p<<endl;
+  				gSim->Trace( )<<"nof is"<<NOF[p];
   			}
-  			sum_flits=sum_flits+NOF[(*p)];	
+  			sum_flits=sum_flits+NOF[p];	
 		}
-		mean_flits=sum_flits/paths.size();
+		mean_flits=sum_flits/__builtin_popcount(paths);
 		
 		//cout<<"next router is:"<<next_router->GetID()<<endl;
 		//cout<<"returned 2"<<endl;	
@@ -396,27 +405,25 @@ int IQRouterBaseline::set_pri_num_flits_ports_vcs(Flit* f, Router* router,list<O
 		return -mean_flits;
 	
 }
-void IQRouterBaseline::oddeven_modified_paths( int cur, const Flit *f, int in_channel, vector<int>* paths )
+// odd-even admissible output ports of a packet at router cur, one bit per
+// port; the source only matters through whether cur is in its column
+unsigned IQRouterBaseline::_OddEvenPorts( int cur, int dest, bool src_column, int in_channel )
 {
+  unsigned paths = 0;
   //cout<<"odd-even"<<endl;
   //bool print_coords=false;
-  int out_port,dest,src;
-  int s0,s1,d0,d1,c0,c1,e0,e1;
+  int d0,d1,c0,c1,e0,e1;
   //cout<<"in-channel is"<<in_channel<<endl;
   //getchar();
-  dest=f->dest;
-  src=f->src;
-  s0=src%gK;
-  s1=src/gK;
-  d0=dest%gK;
-  d1=dest/gK;
-  c0=cur%gK;
-  c1=cur/gK;
+  d0=dest%gSim->k;
+  d1=dest/gSim->k;
+  c0=cur%gSim->k;
+  c1=cur/gSim->k;
 // if(f->id>=0)//added by KVM
   //{
   //print_coords=true;
   //cout<<"in dor_mesh"<<endl;
-  //fp<<(*f);
+  //gSim->Trace( )<<(*f);
   //getchar();
   //}
   
@@ -425,19 +432,19 @@ void IQRouterBaseline::oddeven_modified_paths( int cur, const Flit *f, int in_ch
   
   if(e0==0 && e1==0)
   {
-  	paths->push_back( 4); //deliver the packet to the local node and exit
+  	paths |= 1 << 4; //deliver the packet to the local node and exit
   }
   else if(e0==0)//currently in the same column as dest
   {
   	if(e1>0)
   	{
   		if(in_channel!=2)
-  			paths->push_back(2);;//add north
+  			paths |= 1 << 2;//add north
   	}
   	else
   	{
   		if(in_channel!=3)
-  			paths->push_back( 3);//add south
+  			paths |= 1 << 3;//add south
   	}
   }
   else
@@ -447,53 +454,72 @@ void IQRouterBaseline::oddeven_modified_paths( int cur, const Flit *f, int in_ch
   		if(e1==0)//currently in the same row as destination
   		{
   			if(in_channel!=0)
-  				paths->push_back( 0);//add east
+  				paths |= 1 << 0;//add east
   		}
   		else
   		{
-  			if((c0%2==1) || (c0==s0))
+  			if((c0%2==1) || src_column)
   			{
   				if(e1>0)
   				{
   					if(in_channel!=2)
-  						paths->push_back( 2);//add north
+  						paths |= 1 << 2;//add north
   				}
   				else
   				{
   					if(in_channel!=3)
-  						paths->push_back( 3);//add south
+  						paths |= 1 << 3;//add south
   				}
   			}
   			if((d0%2==1) || (e0!=1))//odd dest column or >= 2 columns to dest
   			{
   				if(in_channel!=0)
-  					paths->push_back( 0);//add east
+  					paths |= 1 << 0;//add east
   			}
   		}
   	}
   	else //west-bound messages
   	{
   		if(in_channel!=1)
-  			paths->push_back( 1);//add west
+  			paths |= 1 << 1;//add west
   		if(c0%2==0)
   		{
   			if(e1>0)
   			{
   				if(in_channel!=2)
-  					paths->push_back( 2);//add north
+  					paths |= 1 << 2;//add north
   			}
   			else if(e1<0)
   			{
   				if(in_channel!=3)
-  					paths->push_back( 3);//add south
+  					paths |= 1 << 3;//add south
   			}
   		}
   	}
-  }  
-  
+  }
+  return paths;
+}
+
+
+// precomputes _OddEvenPorts for every (router, source column, destination,
+// input channel) so the selection functions only do a table lookup
+void IQRouterBaseline::_BuildOddEvenPorts( )
+{
+  int channels = 2*gSim->n + 1;
+  gSim->oddeven_ports.resize( gSim->nodes * gSim->nodes * 2 * channels );
+  for ( int cur = 0; cur < gSim->nodes; ++cur ) {
+    for ( int dest = 0; dest < gSim->nodes; ++dest ) {
+      for ( int src_column = 0; src_column < 2; ++src_column ) {
+	for ( int in_channel = 0; in_channel < channels; ++in_channel ) {
+	  gSim->oddeven_ports[ ( ( cur * gSim->nodes + dest ) * 2 + src_column ) * channels + in_channel ] =
+	    _OddEvenPorts( cur, dest, src_column, in_channel );
+	}
+      }
+    }
+  }
 }
 //old function
-/*int IQRouterBaseline::set_pri_num_flits_ports_weighted(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc)
+/*int IQRouterBaseline::set_pri_num_flits_ports_weighted(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc)
 {
 	Router* next_router;
 	int dest,cur,next,destx,desty,curx,cury,nextx,nexty;
@@ -502,13 +528,13 @@ void IQRouterBaseline::oddeven_modified_paths( int cur, const Flit *f, int in_ch
 	vector<int>::iterator p;
 	dest=f->dest;
 	cur=router->GetID();
-	destx=dest%gK;
-  	desty=dest/gK;
-  	curx=cur%gK;
-  	cury=cur/gK;
+	destx=dest%gSim->k;
+  	desty=dest/gSim->k;
+  	curx=cur%gSim->k;
+  	cury=cur/gSim->k;
   	if(f->id==28760)
   	{
-  		fp<<"current router:"<<cur<<endl;
+  		gSim->Trace( )<<"current router:"<<cur<<endl;
   	}
 	if(iset->output_port==4)
 	{
@@ -522,10 +548,10 @@ void IQRouterBaseline::oddeven_modified_paths( int cur, const Flit *f, int in_ch
 		next=next_router->GetID();
 		if(f->id==28760)
   		{
-  			fp<<"next router:"<<next<<endl;
+  			gSim->Trace( )<<"next router:"<<next<<endl;
   		}
-		nextx=next%gK;
-		nexty=next/gK;
+		nextx=next%gSim->k;
+		nexty=next/gSim->k;
 		if(nextx==destx && nexty==desty)
 			return iset->pri;
 		if(nextx<destx)
@@ -565,20 +591,20 @@ void IQRouterBaseline::oddeven_modified_paths( int cur, const Flit *f, int in_ch
 	
 }*/
 //new function  (TRACKER)
-int IQRouterBaseline::set_pri_num_flits_ports_weighted(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc)
+int IQRouterBaseline::set_pri_num_flits_ports_weighted(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc)
 {
 	Router* next_router;
 	int dest,cur,next,in_channel;
 	int sum_flits=0,mean_flits=0;
 	int* NOF_weighted;
-	vector<int> paths; 
-	vector<int>::iterator p;
+	unsigned paths;
+	int p;
 	dest=f->dest;
 	cur=router->GetID();
 	
   	if(f->id==176)
   	{
-  		fp<<"current router:"<<cur<<endl;
+  		gSim->Trace( )<<"current router:"<<cur<<endl;
   	}
 	if(iset->output_port==4)
 	{
@@ -611,20 +637,21 @@ int IQRouterBaseline::set_pri_num_flits_ports_weighted(Flit* f, Router* router,l
 		
 		if(f->id==176)
   		{
-  			fp<<"next router:"<<next<<endl;
+  			gSim->Trace( )<<"next router:"<<next<<endl;
   			
   		}
-  		oddeven_modified_paths( next, f,in_channel,&paths );
-  		for(p=paths.begin();p<paths.end();p++)
+  		paths=oddeven_modified_ports( next, f, in_channel );
+  		for(unsigned bits=paths;bits;bits&=bits-1)
   		{
+  			p=__builtin_ctz(bits);
   			if(f->id==176)
   			{
-  				fp<<"p is"<<*p<<endl;
-  				fp<<"nof is"<<NOF_weighted[(*p)];
+  				gSim->Trace( )<<"p is"<<p<<endl;
+  				gSim->Trace( )<<"nof is"<<NOF_weighted[p];
   			}
-  			sum_flits=sum_flits+NOF_weighted[(*p)];	
+  			sum_flits=sum_flits+NOF_weighted[p];	
 		}
-		mean_flits=sum_flits/paths.size();
+		mean_flits=sum_flits/__builtin_popcount(paths);
 		
 		//cout<<"next router is:"<<next_router->GetID()<<endl;
 		//cout<<"returned 2"<<endl;	
@@ -643,17 +670,18 @@ int IQRouterBaseline::set_pri_num_flits_ports_weighted(Flit* f, Router* router,l
 	
 }
 // Fluidity of Neighbors (FON)
-int IQRouterBaseline::set_pri_by_fluidity(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc)
+int IQRouterBaseline::set_pri_by_fluidity(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc)
 {
 	Router* next_router;
 	Router* next_next;
 	int dest,cur,next,in_channel;
-	vector<int> paths;
-	vector<int>::iterator p;
+	unsigned paths;
+	int p;
 	dest=f->dest;
 	int fluidity=0;
 	cur=router->GetID();
-	if(iset->output_port==4)
+	// ejection, or a port without a mesh neighbour (cmesh, flatfly)
+	if(iset->output_port>=(int)router->_neighbours->size())
 	{
 		//cout<<"returned 1"<<endl;
 		return iset->pri;
@@ -680,13 +708,14 @@ int IQRouterBaseline::set_pri_by_fluidity(Flit* f, Router* router,list<OutputSet
 				break;
 		};
 
-		oddeven_modified_paths( next, f,in_channel,&paths );
+		paths=oddeven_modified_ports( next, f, in_channel );
 		int i=0;
 		//cout<<"\n";
-  		for(p=paths.begin();p<paths.end();p++)
+  		for(unsigned bits=paths;bits;bits&=bits-1)
   		{
-  			next_next=(next_router->_neighbours)->at(*p);
-  			switch(*p)
+  			p=__builtin_ctz(bits);
+  			next_next=(next_router->_neighbours)->at(p);
+  			switch(p)
   			{
   				case 0:	in_channel=1;	break;
   				case 1: in_channel=0;	break;
@@ -707,21 +736,21 @@ int IQRouterBaseline::set_pri_by_fluidity(Flit* f, Router* router,list<OutputSet
 
 }
 // BOFAR
-int IQRouterBaseline::time_spent_out_router(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc)
+int IQRouterBaseline::time_spent_out_router(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc)
 {
 				Router* next_router;
 				int dest,cur,next,in_channel,temp;
 				int total_time=0,mean_time=0;
 				int* time_from_neig;
 				//int* port_util;
-				vector<int> paths;
-				vector<int>::iterator p;
+				unsigned paths;
+				int p;
 				dest=f->dest;
 				cur=router->GetID();
 			  	if(f->id==200)
 			  	{
-					fp<<"src"<<f->src<<"dest"<<f->dest<<endl;
-			  		fp<<"current router:"<<cur<<endl;
+					gSim->Trace( )<<"src"<<f->src<<"dest"<<f->dest<<endl;
+			  		gSim->Trace( )<<"current router:"<<cur<<endl;
 			  	}
 				if(iset->output_port==4)
 				{
@@ -756,16 +785,17 @@ int IQRouterBaseline::time_spent_out_router(Flit* f, Router* router,list<OutputS
 
 					if(f->id==200)
 			  		{
-			  			fp<<"next router:"<<next<<endl;
+			  			gSim->Trace( )<<"next router:"<<next<<endl;
 
 			  		}
-			  		oddeven_modified_paths( next, f,in_channel,&paths );
-			  		for(p=paths.begin();p<paths.end();p++)
+			  		paths=oddeven_modified_ports( next, f, in_channel );
+			  		for(unsigned bits=paths;bits;bits&=bits-1)
 			  		{
-			  			//	total_time=total_time+time_from_neig[(*p)];
-			  			total_time=total_time+(time_from_neig[(*p)]);
+			  			p=__builtin_ctz(bits);
+			  			//	total_time=total_time+time_from_neig[p];
+			  			total_time=total_time+(time_from_neig[p]);
 					}
-					mean_time=total_time/paths.size();
+					mean_time=total_time/__builtin_popcount(paths);
 				}
 						return -mean_time;
 
@@ -774,7 +804,7 @@ int IQRouterBaseline::time_spent_out_router(Flit* f, Router* router,list<OutputS
 
 /*
 wrong one (iccad initial)
-int IQRouterBaseline::nop(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset)
+int IQRouterBaseline::nop(Flit* f, Router* router,OutputSet::SetList::const_iterator iset)
 {
 	//cout<<"nop"<<endl;
 	Router* next_router;
@@ -782,14 +812,14 @@ int IQRouterBaseline::nop(Flit* f, Router* router,list<OutputSet::sSetElement>::
 	int sum_vcs=0,mean_vcs=0;
 	int *free_vcs;
 	//IQRouterBaseline *next_iqbl;
-	vector<int> paths; 
-	vector<int>::iterator p;
+	unsigned paths;
+	int p;
 	dest=f->dest;
 	cur=router->GetID();
 	
   	if(f->id==176)
   	{
-  		fp<<"current router:"<<cur<<endl;
+  		gSim->Trace( )<<"current router:"<<cur<<endl;
   	}
 	if(iset->output_port==4)
 	{
@@ -823,14 +853,15 @@ int IQRouterBaseline::nop(Flit* f, Router* router,list<OutputSet::sSetElement>::
 		
 		if(f->id==176)
   		{
-  			fp<<"next router:"<<next<<endl;
+  			gSim->Trace( )<<"next router:"<<next<<endl;
   			
   		}
-  		oddeven_modified_paths( next, f,in_channel,&paths );
+  		paths=oddeven_modified_ports( next, f, in_channel );
   		Router* next_next;
-  		for(p=paths.begin();p<paths.end();p++)
+  		for(unsigned bits=paths;bits;bits&=bits-1)
   		{
-  			next_next=(next_router->_neighbours)->at(*p);
+  			p=__builtin_ctz(bits);
+  			next_next=(next_router->_neighbours)->at(p);
   			free_vcs=next_next->get_free_vcs_old();
   			switch(iset->output_port)
 			{
@@ -850,11 +881,11 @@ int IQRouterBaseline::nop(Flit* f, Router* router,list<OutputSet::sSetElement>::
   			
   			if(f->id==176)
   			{
-  				fp<<"p is"<<*p<<endl;
-  				fp<<"fv is"<<free_vcs[(*p)];
+  				gSim->Trace( )<<"p is"<<p<<endl;
+  				gSim->Trace( )<<"fv is"<<free_vcs[p];
   			}
-  			//cout<<"p is"<<*p<<endl;
-  			//cout<<"nof is"<<free_vcs[(*p)]<<endl;
+  			//cout<<"p is"<<p<<endl;
+  			//cout<<"nof is"<<free_vcs[p]<<endl;
   			sum_vcs=sum_vcs+free_vcs[in_channel];	
 		}
 
@@ -863,14 +894,14 @@ int IQRouterBaseline::nop(Flit* f, Router* router,list<OutputSet::sSetElement>::
 		//cout<<"returned 2"<<endl;	
 	}
 	
-	//return sum_vcs/paths.size();   //  to return mean fvcs at 2 hop neighbor
+	//return sum_vcs/__builtin_popcount(paths);   //  to return mean fvcs at 2 hop neighbor
 	//cout<<cur<< "  " << sum_vcs<<endl;
 	 return sum_vcs; 		 // to return sum of all fvcs at 2 hop neighbor
 	
 }
 */
 //// this is correct.. see below
-int IQRouterBaseline::nop(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset)
+int IQRouterBaseline::nop(Flit* f, Router* router,OutputSet::SetList::const_iterator iset)
 {
 	//cout<<"nop"<<endl;
 	Router* next_router;
@@ -878,14 +909,14 @@ int IQRouterBaseline::nop(Flit* f, Router* router,list<OutputSet::sSetElement>::
 	int sum_vcs=0,mean_vcs=0;
 	int *free_vcs;
 	//IQRouterBaseline *next_iqbl;
-	vector<int> paths; 
-	vector<int>::iterator p;
+	unsigned paths;
+	int p;
 	dest=f->dest;
 	cur=router->GetID();
 	
   	if(f->id==200)
   	{
-  		fp<<"current router:"<<cur<<endl;
+  		gSim->Trace( )<<"current router:"<<cur<<endl;
   	}
 	if(iset->output_port==4)
 	{
@@ -919,20 +950,21 @@ int IQRouterBaseline::nop(Flit* f, Router* router,list<OutputSet::sSetElement>::
 		
 		if(f->id==200)
   		{
-  			fp<<"next router:"<<next<<endl;
+  			gSim->Trace( )<<"next router:"<<next<<endl;
   			
   		}
-  		oddeven_modified_paths( next, f,in_channel,&paths );
-  		for(p=paths.begin();p<paths.end();p++)
+  		paths=oddeven_modified_ports( next, f, in_channel );
+  		for(unsigned bits=paths;bits;bits&=bits-1)
   		{
+  			p=__builtin_ctz(bits);
   			if(f->id==200)
   			{
-  				fp<<"p is"<<*p<<endl;
-  				fp<<"fv is"<<free_vcs[(*p)];
+  				gSim->Trace( )<<"p is"<<p<<endl;
+  				gSim->Trace( )<<"fv is"<<free_vcs[p];
   			}
-  			//cout<<"p is"<<*p<<endl;
-  			//cout<<"nof is"<<free_vcs[(*p)]<<endl;
-  			//sum_vcs=sum_vcs+free_vcs[(*p)];	 //use one of this
+  			//cout<<"p is"<<p<<endl;
+  			//cout<<"nof is"<<free_vcs[p]<<endl;
+  			//sum_vcs=sum_vcs+free_vcs[p];	 //use one of this
 			sum_vcs=sum_vcs+free_vcs[(in_channel)];	
 		}
 
@@ -949,7 +981,7 @@ int IQRouterBaseline::nop(Flit* f, Router* router,list<OutputSet::sSetElement>::
 
 
 //.. nop ends here
-int set_pri_flits_through_channel(Router* router,list<OutputSet::sSetElement>::const_iterator iset)
+int set_pri_flits_through_channel(Router* router,OutputSet::SetList::const_iterator iset)
 {
 	int flits;
 	flits=router->GetNOF_port(iset->output_port);
@@ -957,13 +989,14 @@ int set_pri_flits_through_channel(Router* router,list<OutputSet::sSetElement>::c
 }
 
 // tracker&BOFAR together
+// (the history below is per router when routers are stepped in parallel)
 
-int IQRouterBaseline::bofar_tracker_comp(Flit* f,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc)
+int IQRouterBaseline::bofar_tracker_comp(Flit* f,OutputSet::SetList::const_iterator iset,BufferState *dest_vc)
 {
-	static int prev_bofar=-1;
-	static int prev_tracker=-1;
-        static int prev_pri=-1;
-        static int prev_fid=-1;
+	int &prev_bofar=_history->bofar_tracker.bofar;
+	int &prev_tracker=_history->bofar_tracker.tracker;
+        int &prev_pri=_history->bofar_tracker.pri;
+        int &prev_fid=_history->bofar_tracker.fid;
         int in_priority=0;
         int present_bofar,present_tracker;
 	 
@@ -1081,11 +1114,11 @@ int IQRouterBaseline::bofar_tracker_comp(Flit* f,list<OutputSet::sSetElement>::c
 }
 
 
-int free_vcs_comp(Flit* f,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc)
+int free_vcs_comp(Flit* f,OutputSet::SetList::const_iterator iset,BufferState *dest_vc,Router* router)
 {
-	static int prev_fv=-1;
-        static int prev_pri=-1;
-        static int prev_fid=-1;
+	int &prev_fv=router->GetSelectHistory( )->fvc.fv;
+        int &prev_pri=router->GetSelectHistory( )->fvc.pri;
+        int &prev_fid=router->GetSelectHistory( )->fvc.fid;
         int in_priority=0;
 	int free_vcs_count=0;
 	for(int out_vc = iset->vc_start; out_vc <= iset->vc_end; ++out_vc )
@@ -1124,13 +1157,14 @@ int free_vcs_comp(Flit* f,list<OutputSet::sSetElement>::const_iterator iset,Buff
 	prev_fid=f->id;
 	return in_priority;
 }
-int flits_comp(Flit* f,list<OutputSet::sSetElement>::const_iterator iset,Router* router)
+int flits_comp(Flit* f,OutputSet::SetList::const_iterator iset,Router* router)
 {
-	static int ne=0,nw=0,se=0,sw=0;
-	static int prev_port=-1;
+	SelectHistory *h=router->GetSelectHistory( );
+	int &ne=h->flits.ne,&nw=h->flits.nw,&se=h->flits.se,&sw=h->flits.sw;
+	int &prev_port=h->flits.port;
 	int in_priority,flits;
-	static int prev_flits,prev_pri;
-	static int prev_fid=-1;
+	int &prev_flits=h->flits.flits,&prev_pri=h->flits.pri;
+	int &prev_fid=h->flits.fid;
 	flits=router->GetNOF_port(iset->output_port);
 	
 	if(prev_fid==f->id)
@@ -1290,6 +1324,129 @@ int flits_comp(Flit* f,list<OutputSet::sSetElement>::const_iterator iset,Router*
 	return in_priority;
 }
 
+// ============================================================
+//  Selection functions
+//
+//  Every strategy above is wrapped to one signature and
+//  registered by name; the router resolves selection_function
+//  once at construction.
+// ============================================================
+
+map<string, tSelectionFunction> gSelectionFunctionMap;
+
+// the routing function's own priority
+int sel_none( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return iset->pri;
+}
+
+// ==== classical selection strategies ====
+
+int sel_fvc( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return set_pri_free_vcs( dest_vc, iset, gSim->num_vcs );
+}
+
+int sel_nop( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return router->nop( f, router, iset );
+}
+
+int sel_tracker( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return router->set_pri_num_flits_ports_weighted( f, router, iset, dest_vc );
+}
+
+int sel_bofar( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return router->time_spent_out_router( f, router, iset, dest_vc );
+}
+
+int sel_fluidity( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return router->set_pri_by_fluidity( f, router, iset, dest_vc );
+}
+
+// ==== combined priority ====
+
+int sel_bofar_tracker( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return router->bofar_tracker_comp( f, iset, dest_vc );
+}
+
+int sel_fvc_comp( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return free_vcs_comp( f, iset, dest_vc, router );
+}
+
+int sel_flits_comp( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return flits_comp( f, iset, router );
+}
+
+// ==== other suboptimal selection strategies ====
+
+int sel_stress( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return router->set_pri_stress( iset );
+}
+
+int sel_channel( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return set_pri_flits_through_channel( router, iset );
+}
+
+int sel_nof( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return set_pri_num_flits( router, iset );
+}
+
+int sel_nof_ports( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return set_pri_num_flits_ports( f, router, iset );
+}
+
+int sel_nof_ports_vcs( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc )
+{
+  return router->set_pri_num_flits_ports_vcs( f, router, iset, dest_vc );
+}
+
+void InitializeSelectionMap( )
+{
+  gSelectionFunctionMap["none"]          = &sel_none;
+
+  gSelectionFunctionMap["fvc"]           = &sel_fvc;
+  gSelectionFunctionMap["nop"]           = &sel_nop;
+  gSelectionFunctionMap["tracker"]       = &sel_tracker;
+  gSelectionFunctionMap["bofar"]         = &sel_bofar;
+  gSelectionFunctionMap["fluidity"]      = &sel_fluidity;
+
+  gSelectionFunctionMap["bofar_tracker"] = &sel_bofar_tracker;
+  gSelectionFunctionMap["fvc_comp"]      = &sel_fvc_comp;
+  gSelectionFunctionMap["flits_comp"]    = &sel_flits_comp;
+
+  gSelectionFunctionMap["stress"]        = &sel_stress;
+  gSelectionFunctionMap["channel"]       = &sel_channel;
+  gSelectionFunctionMap["nof"]           = &sel_nof;
+  gSelectionFunctionMap["nof_ports"]     = &sel_nof_ports;
+  gSelectionFunctionMap["nof_ports_vcs"] = &sel_nof_ports_vcs;
+}
+
+tSelectionFunction GetSelectionFunction( const Configuration& config )
+{
+  map<string, tSelectionFunction>::const_iterator match;
+  string fn;
+
+  config.GetStr( "selection_function", fn );
+  match = gSelectionFunctionMap.find( fn );
+
+  if ( match == gSelectionFunctionMap.end( ) ) {
+    cout << "Error: Undefined selection function '" << fn << "'." << endl;
+    exit(-1);
+  }
+  return match->second;
+}
+
 void IQRouterBaseline::_VCAlloc( )//for a particular router
 {
   //cout<<"alloc"<<this->GetID()<<endl;
@@ -1305,8 +1462,7 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
   _vc_allocator->Clear( );
 
 
-  for ( set<int>::iterator item = _vcalloc_vcs.begin(); item!=_vcalloc_vcs.end(); ++item ) {
-    int vc_encode = *item;
+  for ( int vc_encode = _vcalloc_vcs.First(); vc_encode >= 0; vc_encode = _vcalloc_vcs.Next(vc_encode) ) {
     int input =  vc_encode/_vcs;
     int vc =vc_encode%_vcs;
     cur_vc = _vc[input][vc];
@@ -1317,14 +1473,14 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
       f = cur_vc->FrontFlit( );
       if(f->id==28760)//added by KVM
       {
-      fp<< GetSimTime() << " | " << FullName() << " | " 
+      gSim->Trace( )<< GetSimTime() << " | " << FullName() << " | " 
 		   << "VC " << vc << " at input " << input
 		   << " is requesting VC allocation for flit " << f->id
 		   << "." << endl;
 		   //getchar();
       }
       if(f->watch) {
-	*gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+	*gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 		   << "VC " << vc << " at input " << input
 		   << " is requesting VC allocation for flit " << f->id
 		   << "." << endl;
@@ -1335,12 +1491,12 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
       //OutputSet *route_set    = cur_vc->GetRouteSet( );
       
       int out_priority = cur_vc->GetPriority( );
-      const list<OutputSet::sSetElement>* setlist = route_set ->GetSetList();//GetSetList() is in outputset.cpp;it returns _outputs which is also for a single flit  
-      //list<OutputSet::sSetElement>* setlist = route_set ->GetSetList();
+      const OutputSet::SetList* setlist = route_set ->GetSetList();//GetSetList() is in outputset.cpp;it returns _outputs which is also for a single flit  
+      //OutputSet::SetList* setlist = route_set ->GetSetList();
       //cout<<setlist->size()<<endl;
-      list<OutputSet::sSetElement>::const_iterator iset = setlist->begin( );
+      OutputSet::SetList::const_iterator iset = setlist->begin( );
       
-      //list<OutputSet::sSetElement>::iterator iset = setlist->begin( );
+      //OutputSet::SetList::iterator iset = setlist->begin( );
       int iset_count=0;
       int add_req_count=0;
       
@@ -1362,25 +1518,8 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
 		//getchar();
 		//added by KVM
 		
-		//************  other suboptimal  selection strategies *********
-		//in_priority=free_vcs_comp(f,iset,dest_vc);
-		//in_priority=flits_comp(f,iset,this);
-		//in_priority=set_pri_stress(iset);
-		//in_priority=set_pri_flits_through_channel(this,iset);
-		//in_priority=set_pri_num_flits_ports_vcs(f,this,iset,dest_vc);
-		//in_priority=set_pri_num_flits_ports(f,this,iset);
-				//in_priority=set_pri_num_flits(this,iset);
-		//cout<<"pri returned is:"<<in_priority<<endl;
-
-		//************  classical selection strategies ********* (by John )
-		//in_priority=set_pri_free_vcs(dest_vc,iset,_vcs); //FVC
-		in_priority=set_pri_by_fluidity(f,this,iset,dest_vc);//Fluidity
-		//in_priority=nop(f,this,iset); // NOP
-		//in_priority=set_pri_num_flits_ports_weighted(f,this,iset,dest_vc); // TRACKER
-		//in_priority=time_spent_out_router(f,this,iset,dest_vc);//BOFAR
-		
-		// *******       combined prirority   ************* //
-		//in_priority=bofar_tracker_comp(f,iset,dest_vc);
+		// selection strategy chosen by selection_function
+		in_priority=_sel(this,f,iset,dest_vc);
 		
 		for ( int out_vc = iset->vc_start; out_vc <= iset->vc_end; ++out_vc ) 
 		{
@@ -1398,7 +1537,7 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
 	 
 	    			if(f->id==176)//added by KVM
 	    			{
-	    				fp<< GetSimTime() << " | " << FullName() << " | "
+	    				gSim->Trace( )<< GetSimTime() << " | " << FullName() << " | "
 			 		<< "Requesting VC " << out_vc
 			 		<< " at output " << iset->output_port 
 			 		<< " with priorities " << in_priority
@@ -1408,7 +1547,7 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
 	    			}
 	    			if(f->watch)
 	    			{
-	      				*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	      				*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			 		<< "Requesting VC " << out_vc
 			 		<< " at output " << iset->output_port 
 			 		<< " with priorities " << in_priority
@@ -1428,13 +1567,13 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
 	  		{
 	    			if(f->id==176)
 	    			{
-	    				fp<< GetSimTime() << " | " << FullName() << " | "
+	    				gSim->Trace( )<< GetSimTime() << " | " << FullName() << " | "
 			 		<< "VC " << out_vc << " at output " << iset->output_port 
 			 		<< " is unavailable." << endl;
 			 		//getchar();
 	    			}
 	    			if(f->watch)
-	      				*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	      				*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			 		<< "VC " << out_vc << " at output " << iset->output_port 
 			 		<< " is unavailable." << endl;
 	  		}
@@ -1450,8 +1589,8 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
   }
   //  watched = true;
   if ( watched ) {
-    *gWatchOut << GetSimTime() << " | " << _vc_allocator->FullName() << " | ";
-    _vc_allocator->PrintRequests( gWatchOut );
+    *gSim->watch_out << GetSimTime() << " | " << _vc_allocator->FullName() << " | ";
+    _vc_allocator->PrintRequests( gSim->watch_out );
   }
 //cout<<"in bl"<<endl<<_inputs<<endl<<_outputs<<endl;
   _vc_allocator->Allocate( );//Allocate() present in selalloc.cpp for select allocator
@@ -1476,7 +1615,7 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
 	  cur_vc->SetState( VC::vc_spec_grant );
 	else
 	  cur_vc->SetState( VC::active );
-	_vcalloc_vcs.erase(match_input*_vcs+match_vc);
+	_vcalloc_vcs.Reset(match_input*_vcs+match_vc);
 	
 	cur_vc->SetOutput( output, vc );
 	dest_vc->TakeBuffer( vc );
@@ -1489,14 +1628,14 @@ void IQRouterBaseline::_VCAlloc( )//for a particular router
 	
 	if(f->id==176)
 	{
-		fp<<GetSimTime() << " | " << FullName() << " | "
+		gSim->Trace( )<<GetSimTime() << " | " << FullName() << " | "
 		     << "Granted VC " << vc << " at output " << output
 		     << " to VC " << match_vc << " at input " << match_input
 		     << " (flit: " << f->id << ")." << endl;
 		     //getchar();
 	}
 	if(f->watch)
-	  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		     << "Granted VC " << vc << " at output " << output
 		     << " to VC " << match_vc << " at input " << match_input
 		     << " (flit: " << f->id << ")." << endl;
@@ -1591,7 +1730,7 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 		  Flit * f = cur_vc->FrontFlit();
 		  assert(f);
 		  if(f->id==176) {
-		    fp << GetSimTime() << " | " << FullName() << " | "
+		    gSim->Trace( ) << GetSimTime() << " | " << FullName() << " | "
 			       << "VC " << vc << " at input " << input 
 			       << " requested output " << output 
 			       << " (non-spec., exp. input: " << expanded_input
@@ -1602,7 +1741,7 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 		    
 		  }
 		  if(f->watch) {
-		    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+		    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			       << "VC " << vc << " at input " << input 
 			       << " requested output " << output 
 			       << " (non-spec., exp. input: " << expanded_input
@@ -1647,8 +1786,8 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 	      assert( expanded_input == (vc%_input_speedup)*_inputs + input );
 	      
 	      const OutputSet * route_set = cur_vc->GetRouteSet( );
-	      const list<OutputSet::sSetElement>* setlist = route_set ->GetSetList();
-	      list<OutputSet::sSetElement>::const_iterator iset = setlist->begin( );
+	      const OutputSet::SetList* setlist = route_set ->GetSetList();
+	      OutputSet::SetList::const_iterator iset = setlist->begin( );
 	      while(iset!=setlist->end( )){
 		BufferState * dest_vc = _next_vcs[iset->output_port];
 		bool do_request = false;
@@ -1672,7 +1811,7 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 		    Flit * f = cur_vc->FrontFlit();
 		    assert(f);
 		    if(f->id==176) {
-		      fp << GetSimTime() << " | " << FullName() << " | "
+		      gSim->Trace( ) << GetSimTime() << " | " << FullName() << " | "
 				 << "VC " << vc << " at input " << input 
 				 << " requested output " << iset->output_port
 				 << " (spec., exp. input: " << expanded_input
@@ -1683,7 +1822,7 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 		      
 		    }
 		    if(f->watch) {
-		      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+		      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 				 << "VC " << vc << " at input " << input 
 				 << " requested output " << iset->output_port
 				 << " (spec., exp. input: " << expanded_input
@@ -1720,11 +1859,11 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
   }
   
   if(watched) {
-    *gWatchOut << GetSimTime() << " | " << _sw_allocator->FullName() << " | ";
-    _sw_allocator->PrintRequests( gWatchOut );
+    *gSim->watch_out << GetSimTime() << " | " << _sw_allocator->FullName() << " | ";
+    _sw_allocator->PrintRequests( gSim->watch_out );
     if(_speculative >= 2) {
-      *gWatchOut << GetSimTime() << " | " << _spec_sw_allocator->FullName() << " | ";
-      _spec_sw_allocator->PrintRequests( gWatchOut );
+      *gSim->watch_out << GetSimTime() << " | " << _spec_sw_allocator->FullName() << " | ";
+      _spec_sw_allocator->PrintRequests( gSim->watch_out );
     }
   }
   
@@ -1845,26 +1984,26 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 	  f = cur_vc->RemoveFlit( );
 	  assert(f);
 	  if(f->id==176) {
-	    fp << GetSimTime() << " | " << FullName() << " | "
+	    gSim->Trace( ) << GetSimTime() << " | " << FullName() << " | "
 		       << "Output " << output
 		       << " granted to VC " << vc << " at input " << input;
 	    if(cur_vc->GetState() == VC::vc_spec_grant)
-	      fp << " (spec";
+	      gSim->Trace( ) << " (spec";
 	    else
-	      fp << " (non-spec";
-	    fp << ", exp. input: " << expanded_input
+	      gSim->Trace( ) << " (non-spec";
+	    gSim->Trace( ) << ", exp. input: " << expanded_input
 		       << ", exp. output: " << expanded_output
 		       << ", flit: " << f->id << ")." << endl;
 	  }
 	  if(f->watch) {
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		       << "Output " << output
 		       << " granted to VC " << vc << " at input " << input;
 	    if(cur_vc->GetState() == VC::vc_spec_grant)
-	      *gWatchOut << " (spec";
+	      *gSim->watch_out << " (spec";
 	    else
-	      *gWatchOut << " (non-spec";
-	    *gWatchOut << ", exp. input: " << expanded_input
+	      *gSim->watch_out << " (non-spec";
+	    *gSim->watch_out << ", exp. input: " << expanded_input
 		       << ", exp. output: " << expanded_output
 		       << ", flit: " << f->id << ")." << endl;
 	  }
@@ -1876,9 +2015,9 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 	
 	if(f->id==28760)
 	{
-	fp<<"curent router"<<this->GetID()<<endl;
-	fp<<"NOF"<<this->GetNOF_port(output)<<endl;
-	fp<<"out port"<<output<<endl;
+	gSim->Trace( )<<"curent router"<<this->GetID()<<endl;
+	gSim->Trace( )<<"NOF"<<this->GetNOF_port(output)<<endl;
+	gSim->Trace( )<<"out port"<<output<<endl;
 	
 	}
 	//added by KVM
@@ -1893,10 +2032,10 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 	
 	if(f->id==28760)
 	{
-	fp<<"after incrementing"<<endl;
-	fp<<"curent router"<<this->GetID()<<endl;
-	fp<<"NOF"<<this->GetNOF_port(output)<<endl;
-	fp<<"out port"<<output<<endl;
+	gSim->Trace( )<<"after incrementing"<<endl;
+	gSim->Trace( )<<"curent router"<<this->GetID()<<endl;
+	gSim->Trace( )<<"NOF"<<this->GetNOF_port(output)<<endl;
+	gSim->Trace( )<<"out port"<<output<<endl;
 	}
 	  
 	  //
@@ -1906,13 +2045,13 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 	  bufferMonitor.read(input, f) ;
 	  
 	  if(f->id==176)
-	    fp<< GetSimTime() << " | " << FullName() << " | "
+	    gSim->Trace( )<< GetSimTime() << " | " << FullName() << " | "
 		       << "Forwarding flit " << f->id << " through crossbar "
 		       << "(exp. input: " << expanded_input
 		       << ", exp. output: " << expanded_output
 		       << ")." << endl;
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		       << "Forwarding flit " << f->id << " through crossbar "
 		       << "(exp. input: " << expanded_input
 		       << ", exp. output: " << expanded_output
@@ -1935,13 +2074,15 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 	  if(f->tail) {
 	    if(cur_vc->Empty()) {
 	      cur_vc->SetState(VC::idle);
+	    } else if(_LookAheadRoute(cur_vc, cur_vc->FrontFlit())) {
+	      _vcalloc_vcs.Set(input*_vcs+vc);
 	    } else if(_routing_delay > 0) {
 	      cur_vc->SetState(VC::routing);
-	      _routing_vcs.push(input*_vcs+vc);
+	      _routing_vcs.Push(input*_vcs+vc);
 	    } else {
 	      cur_vc->Route(_rf, this, cur_vc->FrontFlit(), input);
 	      cur_vc->SetState(VC::vc_alloc);
-	      _vcalloc_vcs.insert(input*_vcs+vc);
+	      _vcalloc_vcs.Set(input*_vcs+vc);
 	    }
 	    _switch_hold_in[expanded_input]   = -1;
 	    _switch_hold_vc[expanded_input]   = -1;
@@ -1957,13 +2098,13 @@ void IQRouterBaseline::_SWAlloc( )//for a particular router
 	  Flit * f = cur_vc->FrontFlit();
 	  assert(f);
 	  if(f->id==176)
-	    fp << GetSimTime() << " | " << FullName() << " | "
+	    gSim->Trace( ) << GetSimTime() << " | " << FullName() << " | "
 		       << "Speculation failed at output " << output
 		       << "(exp. input: " << expanded_input
 		       << ", exp. output: " << expanded_output
 		       << ", flit: " << f->id << ")." << endl;
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		       << "Speculation failed at output " << output
 		       << "(exp. input: " << expanded_input
 		       << ", exp. output: " << expanded_output
@@ -35,9 +35,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "module.hpp"
 #include "iq_router_base.hpp"
+#include "globals.hpp"
 
 class Allocator;
 
+class IQRouterBaseline;
+
+// output selection strategy: priority of one routing option during VC allocation
+typedef int (*tSelectionFunction)( IQRouterBaseline *router, Flit *f, OutputSet::SetList::const_iterator iset, BufferState *dest_vc );
+
+void InitializeSelectionMap( );
+tSelectionFunction GetSelectionFunction( const Configuration& config );
+
+extern map<string, tSelectionFunction> gSelectionFunctionMap;
+
 class IQRouterBaseline : public IQRouterBase {
 
 private:
@@ -48,6 +59,15 @@ private:
   Allocator *_vc_allocator;
   Allocator *_sw_allocator;
   Allocator *_spec_sw_allocator;
+
+  tSelectionFunction _sel;
+
+  bool _can_sleep;  // the allocators allow skipping idle cycles
+
+  // odd-even admissible ports, one bit per port, shared by all routers of
+  // a simulation and kept in gSim->oddeven_ports
+  static void _BuildOddEvenPorts( );
+  static unsigned _OddEvenPorts( int cur, int dest, bool src_column, int in_channel );
   
   vector<int> _sw_rr_offset;
 
@@ -55,7 +75,6 @@ protected:
 
   void _VCAlloc( );
   void _SWAlloc( );
-  int set_pri_stress(list<OutputSet::sSetElement>::const_iterator);
   virtual void _Alloc( );
   
 public:
@@ -65,6 +84,8 @@ public:
 	    int inputs, int outputs );
   
   virtual ~IQRouterBaseline( );
+
+  bool Quiescent( ) const { return _can_sleep && _Drained( ) && _MetricsSettled( ) && !_Incoming( ); }
   //vector<Router *> *_neighbours;//added by KVM
  void free_vcs_all_ports(int* fv)
 {
@@ -82,14 +103,19 @@ public:
 	}
 }
 
-  int nop(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset);
-  int set_pri_num_flits_ports_weighted(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc); //TRACKER
-  int set_pri_num_flits_ports_vcs(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc);
-  void oddeven_modified_paths( int cur, const Flit *f, int in_channel, vector<int>* paths );
+  int set_pri_stress(OutputSet::SetList::const_iterator);
+  int nop(Flit* f, Router* router,OutputSet::SetList::const_iterator iset);
+  int set_pri_num_flits_ports_weighted(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc); //TRACKER
+  int set_pri_num_flits_ports_vcs(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc);
+  inline unsigned oddeven_modified_ports( int cur, const Flit *f, int in_channel ) const
+  {
+    int src_column = ( ( cur % gSim->k ) == ( f->src % gSim->k ) );
+    return gSim->oddeven_ports[ ( ( cur * gSim->nodes + f->dest ) * 2 + src_column ) * ( 2*gSim->n + 1 ) + in_channel ];
+  }
  // ****
-  int time_spent_out_router(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc); // BOFAR
-  int set_pri_by_fluidity(Flit* f, Router* router,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc);
-  int bofar_tracker_comp(Flit* f,list<OutputSet::sSetElement>::const_iterator iset,BufferState *dest_vc);
+  int time_spent_out_router(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc); // BOFAR
+  int set_pri_by_fluidity(Flit* f, Router* router,OutputSet::SetList::const_iterator iset,BufferState *dest_vc);
+  int bofar_tracker_comp(Flit* f,OutputSet::SetList::const_iterator iset,BufferState *dest_vc);
   
 };
 
@@ -153,7 +153,7 @@ void IQRouterCombined::_Alloc( )
 	      if(do_request) {
 		
 		if(f->watch) {
-		  *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+		  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			      << "VC " << vc << " at input "
 			      << input << " requests output " << output 
 			      << " (flit: " << f->id
@@ -189,8 +189,8 @@ void IQRouterCombined::_Alloc( )
   }
   
   if(watched) {
-    *gWatchOut << GetSimTime() << " | " << _sw_allocator->FullName() << " | ";
-    _sw_allocator->PrintRequests( gWatchOut );
+    *gSim->watch_out << GetSimTime() << " | " << _sw_allocator->FullName() << " | ";
+    _sw_allocator->PrintRequests( gSim->watch_out );
   }
   
   _sw_allocator->Allocate();
@@ -271,7 +271,7 @@ void IQRouterCombined::_Alloc( )
 	    _vc_rr_offset[expanded_input*_vcs+vc] = (output + 1) % _outputs;
 	    
 	    if(f->watch)
-	      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			  << "VC " << sel_vc << " at output " << output
 			  << " granted to VC " << vc << " at input " << input
 			  << " (flit: " << f->id << ")." << endl;
@@ -298,7 +298,7 @@ void IQRouterCombined::_Alloc( )
 	  f = cur_vc->RemoveFlit();
 	  
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			<< "Output " << output
 			<< " granted to VC " << vc << " at input " << input
 			<< " (flit: " << f->id
@@ -315,7 +315,7 @@ void IQRouterCombined::_Alloc( )
 	  bufferMonitor.read(input, f);
 	  
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			<< "Forwarding flit " << f->id << " through crossbar "
 			<< "(exp. input: " << expanded_input
 			<< ", exp. output: " << expanded_output
@@ -338,9 +338,11 @@ void IQRouterCombined::_Alloc( )
 	  if(f->tail) {
 	    if(cur_vc->Empty()) {
 	      cur_vc->SetState(VC::idle);
+	    } else if(_LookAheadRoute(cur_vc, cur_vc->FrontFlit())) {
+	      // next hop already decoded, VC goes straight to allocation
 	    } else if(_routing_delay > 0) {
 	      cur_vc->SetState(VC::routing);
-	      _routing_vcs.push(input*_vcs+vc);
+	      _routing_vcs.Push(input*_vcs+vc);
 	    } else {
 	      cur_vc->Route(_rf, this, cur_vc->FrontFlit(), input);
 	      cur_vc->SetState(VC::vc_alloc);
@@ -111,7 +111,7 @@ void IQRouterSplit::_Alloc( )
 	VC::eVCState vc_state = cur_vc->GetState();
 	
 	if(cur_vc->FrontFlit() && cur_vc->FrontFlit()->watch) 
-	  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		      << "Saw flit " << cur_vc->FrontFlit()->id
 		      << " in slow path." << endl;
 	
@@ -123,7 +123,7 @@ void IQRouterSplit::_Alloc( )
 	  if(((vc_state != VC::vc_alloc) && (vc_state != VC::active)) ||
 	     (cur_vc->GetStateTime() < _sw_alloc_delay)) {
 	    if(f->watch)
-	      *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+	      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			  << "VC " << vc << " at input " << input 
 			  << " is not ready for slow-path allocation (flit: " << f->id 
 			  << ", state: " << VC::VCSTATE[vc_state] 
@@ -134,7 +134,7 @@ void IQRouterSplit::_Alloc( )
 	  }	    
 	  
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			<< "VC " << vc << " at input " << input
 			<< " is requesting slow-path allocation (flit: " << f->id 
 			<< ", state: " << VC::VCSTATE[vc_state]
@@ -179,7 +179,7 @@ void IQRouterSplit::_Alloc( )
 		if((vc_state == VC::vc_alloc) &&
 		   !dest_vc->IsAvailableFor(out_vc)) {
 		  if(f->watch)
-		    *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+		    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 				<< "VC " << out_vc << " at output "
 				<< output << " is busy." << endl;
 		  continue;
@@ -190,14 +190,14 @@ void IQRouterSplit::_Alloc( )
 		
 		if(dest_vc->IsFullFor(out_vc)) {
 		  if(f->watch)
-		    *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+		    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 				<< "VC " << out_vc << " at output "
 				<< output << " has no buffers available." << endl;
 		  continue;
 		}
 		
 		if(f->watch)
-		  *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+		  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			      << "VC " << out_vc << " at output "
 			      << output << " is available." << endl;
 		if(!do_request || (vc_prio > in_priority)) {
@@ -209,7 +209,7 @@ void IQRouterSplit::_Alloc( )
 	      if(do_request) {
 		
 		if(f->watch) {
-		  *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+		  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			      << "VC " << vc << " at input "
 			      << input << " requests output " << output 
 			      << " (flit: " << f->id
@@ -259,7 +259,7 @@ void IQRouterSplit::_Alloc( )
 	assert(f);
 	
 	if(f->watch)
-	  *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+	  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 		      << "Saw flit " << f->id
 		      << " in fast path." << endl;
 	
@@ -268,7 +268,7 @@ void IQRouterSplit::_Alloc( )
 	if(((vc_state != VC::vc_alloc) && (vc_state != VC::active)) ||
 	   (cur_vc->GetStateTime() < _sw_alloc_delay)) {
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			<< "VC " << vc << " at input " << input 
 			<< " is not ready for fast-path allocation (flit: " << f->id 
 			<< ", state: " << VC::VCSTATE[vc_state] 
@@ -278,7 +278,7 @@ void IQRouterSplit::_Alloc( )
 	}	    
 	
 	if(f->watch)
-	  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		      << "VC " << vc << " at input " << input
 		      << " is requesting fast-path allocation (flit: " << f->id 
 		      << ", state: " << VC::VCSTATE[vc_state]
@@ -311,7 +311,7 @@ void IQRouterSplit::_Alloc( )
 	  
 	  if(_sw_allocator->ReadRequest(expanded_input, expanded_output) >= 0) {
 	    if(f->watch)
-	      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			  << "Crossbar slot is already in use by slow path "
 			  << "(exp. input: " << expanded_input
 			  << ", exp. output: " << expanded_output
@@ -336,7 +336,7 @@ void IQRouterSplit::_Alloc( )
 	    if((vc_state == VC::vc_alloc) && 
 	       !dest_vc->IsAvailableFor(out_vc)) {
 	      if(f->watch)
-		*gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+		*gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			    << "VC " << out_vc << " at output "
 			    << output << " is busy." << endl;
 	      continue;
@@ -347,14 +347,14 @@ void IQRouterSplit::_Alloc( )
 	    
 	    if(dest_vc->IsFullFor(out_vc)) {
 	      if(f->watch)
-		*gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+		*gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			    << "VC " << out_vc << " at output "
 			    << output << " has no buffers available." << endl;
 	      continue;
 	    }
 	    
 	    if(f->watch)
-	      *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+	      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			  << "VC " << out_vc << " at output "
 			  << output << " is available." << endl;
 	    if(!do_request || (vc_prio > in_priority)) {
@@ -366,7 +366,7 @@ void IQRouterSplit::_Alloc( )
 	  if(do_request) {
 	    
 	    if(f->watch)
-	      *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+	      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			  << "VC " << vc << " at input "
 			  << input << " requests output " << output 
 			  << " (flit: " << f->id
@@ -394,14 +394,14 @@ void IQRouterSplit::_Alloc( )
   }
   
   if(watched) {
-    *gWatchOut << GetSimTime() << " | " << _sw_allocator->FullName() << " | ";
-    _sw_allocator->PrintRequests(gWatchOut);
+    *gSim->watch_out << GetSimTime() << " | " << _sw_allocator->FullName() << " | ";
+    _sw_allocator->PrintRequests(gSim->watch_out);
   }
   
   _sw_allocator->Allocate();
   
   if(watched) {
-    *gWatchOut << GetSimTime() << " | " << _sw_allocator->FullName() << " | "
+    *gSim->watch_out << GetSimTime() << " | " << _sw_allocator->FullName() << " | "
 		<< "Grants = [ ";
     for(int input = 0; input < _inputs; ++input)
       for(int s = 0; s < _input_speedup; ++s) {
@@ -410,10 +410,10 @@ void IQRouterSplit::_Alloc( )
 	if(expanded_output > -1) {
 	  int output = expanded_output % _outputs;
 	  int vc = _sw_allocator->ReadRequest(expanded_input, expanded_output);
-	  *gWatchOut << input << " -> " << output << " (vc:" << vc << ")  ";
+	  *gSim->watch_out << input << " -> " << output << " (vc:" << vc << ")  ";
 	}
       }
-    *gWatchOut << "]." << endl;
+    *gSim->watch_out << "]." << endl;
   }
   
   // Winning flits cross the switch
@@ -467,13 +467,13 @@ void IQRouterSplit::_Alloc( )
 	
 	if(vc == fvc) {
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			<< "Fast-path allocation successful for VC " << vc
 			<< " at input " << input << " (flit: " << f->id
 			<< ")." << endl;
 	} else {
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			<< "Slow-path allocation successful for VC " << vc
 			<< " at input " << input << " (flit: " << f->id
 			<< ")." << endl;
@@ -505,21 +505,21 @@ void IQRouterSplit::_Alloc( )
 	      int out_vc = route_set->GetVC(output, vc_index, &out_prio);
 	      if(!dest_vc->IsAvailableFor(out_vc)) {
 		if(f->watch)
-		  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+		  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			      << "VC " << out_vc << " at output "
 			      << output << " is busy." << endl;
 		continue;
 	      }
 	      if(dest_vc->IsFullFor(out_vc)) {
 		if(f->watch)
-		  *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+		  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			      << "VC " << out_vc << " at output "
 			      << output << " has no buffers available." << endl;
 		continue;
 	      }
 	      
 	      if(f->watch)
-		*gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+		*gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			    << "VC " << out_vc << " at output "
 			    << output << " is available." << endl;
 	      if(out_prio > sel_prio) {
@@ -549,7 +549,7 @@ void IQRouterSplit::_Alloc( )
 	    _vc_rr_offset[input*_vcs+vc] = (output + 1) % _outputs;
 	    
 	    if(f->watch)
-	      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			  << "VC " << sel_vc << " at output " << output
 			  << " granted to VC " << vc << " at input " << input
 			  << " (flit: " << f->id << ")." << endl;
@@ -576,7 +576,7 @@ void IQRouterSplit::_Alloc( )
 	  f = cur_vc->RemoveFlit();
 	  
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | " 
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | " 
 			<< "Output " << output
 			<< " granted to VC " << vc << " at input " << input
 			<< " (flit: " << f->id
@@ -593,7 +593,7 @@ void IQRouterSplit::_Alloc( )
 	  bufferMonitor.read(input, f);
 	  
 	  if(f->watch)
-	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			<< "Forwarding flit " << f->id << " through crossbar "
 			<< "(exp. input: " << expanded_input
 			<< ", exp. output: " << expanded_output
@@ -616,7 +616,7 @@ void IQRouterSplit::_Alloc( )
 	  if(f->tail) {
 	    if(cur_vc->Empty()) {
 	      cur_vc->SetState(VC::idle);
-	    } else {
+	    } else if(!_LookAheadRoute(cur_vc, cur_vc->FrontFlit())) {
 	      cur_vc->Route(_rf, this, cur_vc->FrontFlit(), input);
 	      cur_vc->SetState(VC::vc_alloc);
 	    }
@@ -634,7 +634,7 @@ void IQRouterSplit::_Alloc( )
 	  
 	  if(cur_vc->Empty() && !_use_fast_path[input*_vcs+vc]) {
 	    if(f->watch)
-	      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 			  << "Enabling fast-path allocation for VC " << vc
 			  << " at input " << input << "." << endl;
 	    _use_fast_path[input*_vcs+vc] = true;
@@ -650,7 +650,7 @@ void IQRouterSplit::_Alloc( )
 	assert(f);
 	
 	if(f->watch)
-	  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	  *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		      << "Disabling fast-path allocation for VC " << fvc
 		      << " at input " << input << "." << endl;
 	_use_fast_path[input*_vcs+fvc] = false;
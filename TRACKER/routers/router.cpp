@@ -44,6 +44,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "booksim.hpp"
 #include <iostream>
 #include <assert.h>
+#include <climits>
+#include <algorithm>
 #include "router.hpp"
 
 //////////////////Sub router types//////////////////////
@@ -62,7 +64,8 @@ Router::Router( const Configuration& config,
   Module( parent, name ),
   _id( id ),
   _inputs( inputs ),
-  _outputs( outputs )
+  _outputs( outputs ),
+  _credit_pool( config.GetInt( "num_vcs" ) )
 {
 
   _st_prepare_delay = config.GetInt( "st_prepare_delay" );
@@ -91,7 +94,17 @@ Router::Router( const Configuration& config,
  
  //initialise number of flits through each port to 0
  for(int i=0;i<5;i++)
+ {
 	 _num_of_flits_routed_per_port[i]=0;
+	 _nof_snapshot[i]=0;
+ }
+ _snapshot_metrics=false;
+ _history=&gSim->select_history;
+ _clock=0;
+ _sleep_index=-1;
+ _asleep=false;
+ _woken=false;
+ _wake_at=INT_MAX;
 	 
  //initialise past and present flits through each port
   for(int i=0;i<5;i++)
@@ -213,20 +226,41 @@ void Router::update_wnof_values()
 	{
 		wnof_old[i]=_weighted_NOF_per_port[i];
 	} 
+	for(int i=0;i<5;i++)
+	{
+		_nof_snapshot[i]=_num_of_flits_routed_per_port[i];
+	}
 	//calc_wnof_all_ports();
 }
+// n rounds of Update_cum_flits in closed form, each divides by 4
+static int _DecayNOF( int w, int n )
+{
+	return ( n >= 16 ) ? 0 : ( w >> ( 2 * n ) );
+}
+
 int* Router::get_wnof_old()
 {
+	// a sleeping router missed the copies of the decayed live values
+	if ( _asleep && ( _old_decays != _clock->decays_prev ) )
+	{
+		for(int i=0;i<4;i++)
+		{
+			wnof_old[i]=_DecayNOF( wnof_old[i], _clock->decays_prev - _old_decays );
+		}
+		_old_decays=_clock->decays_prev;
+	}
 	return wnof_old;
 }
 
 void Router::IncrementNOF_port(int port)
 {
+	if ( port >= METRIC_PORTS )
+		return;
 	_num_of_flits_routed_per_port[port]++;
 }
 int Router::GetNOF_port(int port)
 {
-	return _num_of_flits_routed_per_port[port];
+	return _NOF_ports()[port];
 }
 int Router::GetNOF_mean(vector<int> neighbour_ports)
 {
@@ -236,10 +270,10 @@ int Router::GetNOF_mean(vector<int> neighbour_ports)
 	{
 			/*if(f->id==28760)
 			{
-				fp<<"port:"<<*p<<endl;
-				fp<<"num of flits"<<next_router->GetNOF_port(*p)<<endl;
+				gSim->Trace( )<<"port:"<<*p<<endl;
+				gSim->Trace( )<<"num of flits"<<next_router->GetNOF_port(*p)<<endl;
 			}*/
-			sum_flits=sum_flits+_num_of_flits_routed_per_port[(*p)];
+			sum_flits=sum_flits+_NOF_ports()[(*p)];
 			
 	}
 		mean_flits=sum_flits/neighbour_ports.size();
@@ -258,7 +292,7 @@ int Router::GetNOF_mean(vector<int> neighbour_ports)
 }*/
 int* Router::GetNOF_neighbours()
 {	
-	return (_num_of_flits_routed_per_port);
+	return (_NOF_ports());
 }
 
 void Router::Update_cum_flits()  // updation of metric with alpha (if alpha=0.25 divide by 4)
@@ -281,6 +315,8 @@ void Router::Update_cum_flits()  // updation of metric with alpha (if alpha=0.25
 
 void Router::Increment_present_flits(int port) // updation of wnof at Flit movement (TRACKER modified)
 {
+	if ( port >= METRIC_PORTS )
+		return;
 	/*if(_present_flits_per_port[port]<15)
 	_present_flits_per_port[port]++;*/
 	//_present_flits_per_port=1;
@@ -375,19 +411,131 @@ void Router::Update_fluidity()
 
 
 
-Credit *Router::_NewCredit( int vcs )
+// true when a cycle without flits would leave every metric unchanged
+bool Router::_MetricsSettled( ) const
 {
-  Credit *c;
-  //cout<<"new credit created"<<endl;
-  //getchar();
+	for(int i=0;i<5;i++)
+	{
+		if(has_input[i] || (_nof_snapshot[i]!=_num_of_flits_routed_per_port[i]))
+			return false;
+		for(int j=0;j<count_VCs_port;j++)
+			if(has_input_vc[i][j])
+				return false;
+	}
+	for(int i=0;i<4;i++)
+	{
+		if((wnof_old[i]!=_weighted_NOF_per_port[i]) ||
+		   (free_vcs_old[i]!=free_vcs_new[i]) ||
+		   (cum_time_out_this_clock[i]!=cum_time_out_previous_clock[i]))
+			return false;
+		for(int j=0;j<count_VCs_port;j++)
+			if((fluidity[i][j]!=new_fluidity[i][j]) || (new_fluidity[i][j]!=update_fluidity[i][j]))
+				return false;
+		for(list<int>::const_iterator b=bit_time_per_outport[i].begin();b!=bit_time_per_outport[i].end();++b)
+			if(*b)
+				return false;
+	}
+	return true;
+}
+
+void Router::Sleep( )
+{
+	_asleep      = true;
+	_woken       = false;
+	_wake_at     = INT_MAX;
+	_sleep_cycle = _clock->cycles;
+	_sleep_step  = _clock->steps;
+	_live_decays = _clock->decays;
+	_old_decays  = _clock->decays;
+}
 
-  c = new Credit( vcs );
-  return c;
+// flits or credits on their way here
+bool Router::_Incoming( ) const
+{
+	for ( int i = 0; i < _inputs; ++i )
+	{
+		if ( (*_input_channels)[i]->InFlight( ) )
+			return true;
+	}
+	for ( int o = 0; o < _outputs; ++o )
+	{
+		if ( (*_output_credits)[o]->InFlight( ) )
+			return true;
+	}
+	return false;
+}
+
+// the empty reads and writes of a skipped cycle, which keep the channel
+// queues in step with their other end
+void Router::IdleTick( )
+{
+	for ( int i = 0; i < _inputs; ++i )
+	{
+		(*_input_channels)[i]->Receive( );
+		(*_input_credits)[i]->Send( 0 );
+	}
+	for ( int o = 0; o < _outputs; ++o )
+	{
+		(*_output_credits)[o]->Receive( );
+		(*_output_channels)[o]->Send( 0 );
+	}
+}
+
+// only a router that may sleep listens to its channels, so routers stepped
+// on several threads never have _woken written by a neighbour's thread
+void Router::UseSleepClock( SleepClock *clock, int index )
+{
+	_clock       = clock;
+	_sleep_index = index;
+	for ( int i = 0; i < _inputs; ++i )
+		(*_input_channels)[i]->SetListener( this );
+	for ( int o = 0; o < _outputs; ++o )
+		(*_output_credits)[o]->SetListener( this );
+}
+
+// a sleeping router on a timed clock is put on the wheel for the first
+// cycle it can receive something in
+void Router::Arriving( int due )
+{
+	_woken = true;
+	if ( !_asleep || !_clock->Timed( ) )
+		return;
+	int at = max( due, _clock->next );
+	if ( at < _wake_at )
+	{
+		_wake_at = at;
+		_clock->wheel[at & ( _clock->wheel.size( ) - 1 )].push_back( _sleep_index );
+	}
+}
+
+void Router::Wake( )
+{
+	int decays = _clock->decays - _live_decays;
+	for(int i=0;i<5;i++)
+	{
+		_weighted_NOF_per_port[i]=_DecayNOF( _weighted_NOF_per_port[i], decays );
+	}
+	get_wnof_old( );
+	int cycles = _clock->cycles - _sleep_cycle;
+	_CatchUp( cycles, _clock->steps - _sleep_step );
+	if ( _clock->Timed( ) )
+	{
+		// the idle sends IdleTick would have made
+		for ( int o = 0; o < _outputs; ++o )
+			(*_output_channels)[o]->AddIdle( cycles );
+	}
+	_asleep = false;
+}
+
+Credit *Router::_NewCredit( int vcs )
+{
+  assert( vcs <= _credit_pool.Capacity( ) );
+  return _credit_pool.New( );
 }
 
 void Router::_RetireCredit( Credit *c )
 {
-  delete c;
+  _credit_pool.Free( c );
 }
 
 void Router::AddInputChannel( FlitChannel *channel, CreditChannel *backchannel )
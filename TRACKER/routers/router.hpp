@@ -41,9 +41,26 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "channel.hpp"
 #include "config_utils.hpp"
 #include "booksim_config.hpp"
+#include "simcontext.hpp"
 #include <list>
 
 typedef Channel<Credit> CreditChannel;
+
+// counters of a network that skips its idle routers (see
+// Network::SetSkipIdle); a sleeping router catches up from them
+struct SleepClock {
+  int cycles;       // network cycles completed
+  int steps;        // internal steps completed
+  int decays;       // Update_cum_flits rounds so far
+  int decays_prev;  // the same at the end of the previous cycle
+
+  // with event_driven (see Network::SetEventDriven) sleeping routers are
+  // woken from a timing wheel, indexed by cycle modulo its size
+  int written;      // last cycle whose outputs were written
+  int next;         // first cycle whose wake-ups are still to come
+  vector<vector<int> > wheel;
+  bool Timed( ) const { return !wheel.empty( ); }
+};
 union fluid_info
 {
 mutable	int vc1:1;
@@ -52,7 +69,7 @@ mutable	int vc3:1;
 mutable int vc4:1;
 mutable	int x; //vc1=1 indicated vc1 is fluid
 };
-class Router : public Module {
+class Router : public Module, public ChannelListener {
 
 protected:
   int _id;
@@ -67,8 +84,18 @@ protected:
   int _st_final_delay;
   
   int _credit_delay;
+
   int _num_of_flits_routed;//added by KVM
   int _num_of_flits_routed_per_port[5];//added by KVM
+  // copy of the above taken by update_wnof_values; neighbours read it
+  // instead of the live counts when routers are stepped in parallel
+  int _nof_snapshot[5];
+  bool _snapshot_metrics;
+  int *_NOF_ports( ) { return _snapshot_metrics ? _nof_snapshot : _num_of_flits_routed_per_port; }
+  // serially stepped routers share one history, as the selection
+  // strategies always did; routers stepped on threads keep their own
+  SelectHistory *_history;
+  SelectHistory _own_history;
   // int _cum_past_flits_per_port[5];//added by KVM
   //int _present_flits_per_port[5];//added by KVM
   int _weighted_NOF_per_port[5];//added by kvm
@@ -94,15 +121,39 @@ protected:
   vector<CreditChannel *> *_output_credits;
   vector<bool>            *_channel_faults;
 
+  // a sleeping router is skipped by its network until a flit or credit
+  // arrives; what it missed is caught up in Wake or, for the decay of
+  // wnof_old that neighbours read, in get_wnof_old
+  SleepClock *_clock;
+  int  _sleep_index;  // position in the network, kept by its wake-ups
+  bool _asleep;
+  bool _woken;        // raised by the channels on anything sent here
+  int  _wake_at;      // cycle of the earliest wake-up on a timed clock
+  int  _sleep_cycle;
+  int  _sleep_step;
+  int  _live_decays;  // rounds applied to _weighted_NOF_per_port
+  int  _old_decays;   // rounds applied to wnof_old
+
+  bool _MetricsSettled( ) const;
+  bool _Incoming( ) const;
+  virtual void _CatchUp( int cycles, int steps ) { }
+
+  CreditPool _credit_pool;
   Credit *_NewCredit( int vcs = 1 );
   void    _RetireCredit( Credit *c );
 
 public:
+  // the per-port congestion metrics below only cover the mesh ports and
+  // injection/ejection, the fluidity rows only the mesh inputs; wider
+  // routers (cmesh, flatfly) skip the rest
+  const static int METRIC_PORTS   = 5;
+  const static int FLUIDITY_PORTS = 4;
+
   int count_VCs_port;
 	//union fluid_info fluidity[5];
-  int update_fluidity[4][20];    // second index is count of vcs  arbitarly fixed up to 20
-  int fluidity[4][20];		//older value  
-  int new_fluidity[4][20];	//newer value
+  int update_fluidity[FLUIDITY_PORTS][20];    // second index is count of vcs  arbitarly fixed up to 20
+  int fluidity[FLUIDITY_PORTS][20];		//older value  
+  int new_fluidity[FLUIDITY_PORTS][20];	//newer value
   int has_input[5];
   int has_input_vc[5][20];
 
@@ -125,6 +176,19 @@ public:
   virtual void InternalStep( ) = 0;
   virtual void WriteOutputs( ) = 0;
 
+  // idle cycle skipping, only routers that override Quiescent sleep
+  void UseSleepClock( SleepClock *clock, int index );
+  int  SleepIndex( ) const { return _sleep_index; }
+  virtual bool Quiescent( ) const { return false; }
+  virtual int  IdleVCs( ) const { return 0; }
+  bool Asleep( ) const { return _asleep; }
+  void Sleep( );
+  bool Woken( ) const { return _woken; }
+  bool WakeDue( int cycle ) const { return _asleep && ( _wake_at == cycle ); }
+  void Arriving( int due );
+  void IdleTick( );
+  void Wake( );
+
   void OutChannelFault( int c, bool fault = true );
   bool IsFaultyOutput( int c ) const;
 
@@ -143,6 +207,9 @@ public:
   void calc_wnof_all_ports();
   void update_wnof_values();
   int* get_wnof_old();
+  void UseMetricSnapshots( bool snapshot ) { _snapshot_metrics = snapshot; }
+  void UseOwnSelectHistory( ) { _history = &_own_history; }
+  SelectHistory *GetSelectHistory( ) { return _history; }
   
   void Increment_present_flits(int port);
   void Update_cum_flits();
@@ -176,6 +243,9 @@ public:
   virtual void ResetFlitStats() = 0;
 
   int NumOutputs(){return _outputs;}
+  int NumInputs(){return _inputs;}
+  FlitChannel *GetInputChannel(int in){return (*_input_channels)[in];}
+  FlitChannel *GetOutputChannel(int out){return (*_output_channels)[out];}
 };
 
 #endif
@@ -0,0 +1,565 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*routetable.cpp
+ *
+ *Source routes for every (source, destination) pair. The route of a packet
+ *is a table lookup when the packet is generated.
+ *
+ *Routes come from a route builder (gRouteBuilderMap, keyed algorithm_topology
+ *like the routing functions) or are compiled from a
+ *hop-by-hop routing function (gRoutingFunctionMap): a probe head flit is
+ *walked from the source's injection channel to the destination's ejection
+ *channel. Every output the function offers is followed, highest priority
+ *first, until route_candidates paths reach the destination; path 0 is
+ *always the highest priority choice at every hop. Randomized functions are
+ *sampled once per branch. The VC class of a hop is the part of the VCs,
+ *split into route_vc_classes, holding the first VC the function offers.
+ *
+ *Because a packet may use any VC of its class on a channel, the table is
+ *only deadlock free if the (channel, class) dependency graph of all its
+ *paths has no cycle. That is checked for every table, built or loaded;
+ *multiple paths per pair need a turn-model function such as
+ *oddeven_modified or west_first.
+ *
+ *Route table file layout (native byte order):
+ *  header      magic "SRTB", version, route_table "_" topology, nodes,
+ *              route_candidates, route_vc_classes, port bits, paths,
+ *              class bits, words
+ *  first       unsigned int per pair plus one, first path of the pair
+ *  length      unsigned int per path, hops in the route
+ *  offset      unsigned int per path, first word of the route
+ *  (padding)   to a multiple of 8 bytes
+ *  words       unsigned long long, packed routes (see sourceroute.hpp)
+ *
+ *Pair (src, dest) is entry src * nodes + dest.
+ */
+
+#include "booksim.hpp"
+#include <iostream>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "routetable.hpp"
+#include "router.hpp"
+#include "outputset.hpp"
+#include "globals.hpp"
+
+map<string, tRouteBuilder> gRouteBuilderMap;
+
+struct RouteTableHeader {
+  char               magic[4];
+  unsigned int       version;
+  char               algorithm[64];
+  unsigned int       nodes;
+  unsigned int       candidates;
+  unsigned int       vc_classes;
+  unsigned int       port_bits;
+  unsigned int       paths;
+  unsigned int       class_bits;
+  unsigned long long words;
+};
+
+const static unsigned int ROUTE_TABLE_VERSION = 4;
+
+//bytes of the unsigned int arrays, padded so the words stay aligned
+static size_t _IndexBytes( size_t pairs, size_t paths )
+{
+  size_t bytes = ( pairs + 1 + 2 * paths ) * sizeof( unsigned int );
+  return ( bytes + 7 ) & ~(size_t)7;
+}
+
+//=============================================================
+
+//x first, then y
+void xy_route( int src, int dest, SourceRoute *r )
+{
+  int dx = ( dest % gSim->k ) - ( src % gSim->k );
+  int dy = ( dest / gSim->k ) - ( src / gSim->k );
+
+  for ( int h = 0; h < abs( dx ); ++h ) {
+    r->Push( ( dx > 0 ) ? 0 : 1 );
+  }
+  for ( int h = 0; h < abs( dy ); ++h ) {
+    r->Push( ( dy > 0 ) ? 2 : 3 );
+  }
+  r->Push( 2*gSim->n );
+}
+
+//=============================================================
+
+//minimal odd-even, ported from the legacy _Sourcerouteoddeven1 heuristic:
+//eastbound packets turn north or south out of odd columns, westbound
+//packets go west first; a destination in an even column still gets an EN or
+//ES turn there, so this relies on _CheckDeadlock
+void oddeven_route( int src, int dest, SourceRoute *r )
+{
+  int cur = src;
+  int d0  = dest % gSim->k;
+  int d1  = dest / gSim->k;
+
+  while ( cur != dest ) {
+    int e0 = d0 - ( cur % gSim->k );
+    int e1 = d1 - ( cur / gSim->k );
+
+    if ( e0 == 0 ) {
+      //same column as the destination
+      if ( e1 > 0 ) {
+	r->Push( 2 );
+	cur += gSim->k;
+      } else {
+	r->Push( 3 );
+	cur -= gSim->k;
+      }
+    } else if ( e0 > 0 ) {
+      r->Push( 0 );
+      cur += 1;
+      if ( ( e1 != 0 ) && ( ( cur % gSim->k ) % 2 == 1 ) ) {
+	if ( e1 > 0 ) {
+	  r->Push( 2 );
+	  cur += gSim->k;
+	} else {
+	  r->Push( 3 );
+	  cur -= gSim->k;
+	}
+      }
+    } else {
+      r->Push( 1 );
+      cur -= 1;
+    }
+  }
+  r->Push( 2*gSim->n );
+}
+
+//=============================================================
+
+void InitializeRouteBuilderMap( )
+{
+  gRouteBuilderMap["xy_mesh"]      = &xy_route;
+  gRouteBuilderMap["oddeven_mesh"] = &oddeven_route;
+}
+
+//=============================================================
+
+RouteTable::RouteTable( const Configuration &config, Network *net )
+  : _nodes(net->NumDests( )), _map(0), _map_size(0)
+{
+  string algorithm, filename, topo;
+
+  config.GetStr( "route_table", algorithm );
+  config.GetStr( "route_table_file", filename );
+  config.GetStr( "topology", topo );
+  _max_paths = config.GetInt( "route_candidates" );
+
+  if ( _max_paths < 1 ) {
+    cout << "Error: route_candidates must be at least 1." << endl;
+    exit(-1);
+  }
+
+  int classes = config.GetInt( "route_vc_classes" );
+  if ( ( classes < 1 ) || ( classes > gSim->num_vcs ) ) {
+    cout << "Error: route_vc_classes must be between 1 and num_vcs." << endl;
+    exit(-1);
+  }
+
+  int ports = 0;
+  for ( int r = 0; r < net->NumRouters( ); ++r ) {
+    if ( net->GetRouters( )[r]->NumOutputs( ) > ports ) {
+      ports = net->GetRouters( )[r]->NumOutputs( );
+    }
+  }
+  _format = SourceRouteFormat( ports, classes );
+
+  bool loaded = ( filename != "" ) && _Load( filename, algorithm + "_" + topo );
+
+  if ( !loaded ) {
+    map<string, tRouteBuilder>::const_iterator builder = 
+      gRouteBuilderMap.find( algorithm + "_" + topo );
+    map<string, tRoutingFunction>::const_iterator rf = 
+      gRoutingFunctionMap.find( algorithm + "_" + topo );
+
+    if ( builder != gRouteBuilderMap.end( ) ) {
+      _Build( builder->second );
+    } else if ( ( rf != gRoutingFunctionMap.end( ) ) && ( algorithm != "rajagiri" ) ) {
+      _Compile( rf->second, net );
+    } else {
+      cout << "Error: Undefined route table algorithm '" << algorithm 
+	   << "' for the topology '" << topo << "'." << endl;
+      exit(-1);
+    }
+  }
+
+  _CheckDeadlock( net, loaded ? filename : "" );
+
+  if ( !loaded && ( filename != "" ) ) {
+    _Save( filename, algorithm + "_" + topo );
+  }
+}
+
+RouteTable::~RouteTable( )
+{
+  if ( _map ) {
+    munmap( _map, _map_size );
+  }
+}
+
+void RouteTable::_Build( tRouteBuilder builder )
+{
+  SourceRoute r( &_format );
+
+  for ( int src = 0; src < _nodes; ++src ) {
+    for ( int dest = 0; dest < _nodes; ++dest ) {
+      r.Reset( );
+      builder( src, dest, &r );
+      _first_storage.push_back( _length_storage.size( ) );
+      _Append( r );
+    }
+  }
+  _Finish( );
+}
+
+void RouteTable::_Compile( tRoutingFunction rf, Network *net )
+{
+  vector<SourceRoute> paths;
+
+  for ( int src = 0; src < _nodes; ++src ) {
+    for ( int dest = 0; dest < _nodes; ++dest ) {
+      Flit f;
+      f.src  = src;
+      f.dest = dest;
+      f.head = true;
+      f.tail = true;
+
+      paths.clear( );
+      _Walk( rf, net, src, dest, net->GetInject( )[src], f, SourceRoute( &_format ), &paths );
+
+      _first_storage.push_back( _length_storage.size( ) );
+      for ( unsigned int p = 0; p < paths.size( ); ++p ) {
+	_Append( paths[p] );
+      }
+    }
+  }
+  _Finish( );
+}
+
+static bool _HigherPriority( const OutputSet::sSetElement &a, const OutputSet::sSetElement &b )
+{
+  return a.pri > b.pri;
+}
+
+void RouteTable::_Walk( tRoutingFunction rf, Network *net, int src, int dest,
+			FlitChannel *channel, Flit f, const SourceRoute &r,
+			vector<SourceRoute> *paths ) const
+{
+  if ( channel == net->GetEject( )[dest] ) {
+    paths->push_back( r );
+    return;
+  }
+
+  // a route longer than every channel in the network must contain a cycle
+  if ( ( channel->GetSink( ) < 0 ) || ( r.Length( ) > net->NumChannels( ) ) ) {
+    cout << "Error: Route table algorithm does not route from " << src 
+	 << " to " << dest << "." << endl;
+    exit(-1);
+  }
+
+  Router *router = net->GetRouters( )[channel->GetSink( )];
+
+  int in_channel = 0;
+  while ( router->GetInputChannel( in_channel ) != channel ) {
+    ++in_channel;
+  }
+
+  OutputSet outputs( router->NumOutputs( ) );
+  rf( router, &f, in_channel, &outputs, false );
+
+  // highest priority first, the order of the set on a tie
+  const OutputSet::SetList *set = outputs.GetSetList( );
+  vector<OutputSet::sSetElement> choices( set->begin( ), set->end( ) );
+  stable_sort( choices.begin( ), choices.end( ), _HigherPriority );
+
+  if ( choices.empty( ) ) {
+    cout << "Error: Route table algorithm does not route from " << src 
+	 << " to " << dest << "." << endl;
+    exit(-1);
+  }
+
+  for ( unsigned int c = 0; 
+	( c < choices.size( ) ) && ( (int)paths->size( ) < _max_paths ); ++c ) {
+    SourceRoute next = r;
+    next.Push( choices[c].output_port, _format.ClassOf( choices[c].vc_start, 0, gSim->num_vcs - 1 ) );
+
+    Flit g = f;
+    g.vc = choices[c].vc_start;
+    g.hops++;
+
+    _Walk( rf, net, src, dest, router->GetOutputChannel( choices[c].output_port ),
+	   g, next, paths );
+  }
+}
+
+void RouteTable::_Append( const SourceRoute &r )
+{
+  _length_storage.push_back( r.Length( ) );
+  _offset_storage.push_back( _word_storage.size( ) );
+  _word_storage.insert( _word_storage.end( ), r.Words( ), r.Words( ) + r.NumWords( ) );
+}
+
+void RouteTable::_Finish( )
+{
+  _first_storage.push_back( _length_storage.size( ) );
+
+  //keeps Words( ) valid for the last path even if its route is empty
+  _word_storage.push_back( 0 );
+
+  _first  = &_first_storage[0];
+  _length = &_length_storage[0];
+  _offset = &_offset_storage[0];
+  _words  = &_word_storage[0];
+}
+
+//a path this network cannot follow comes from a corrupt file or a broken
+//builder
+static void _BadPath( const string &filename, int src, int dest, const char *what )
+{
+  if ( filename != "" ) {
+    cout << "Error: Route table file '" << filename << "' is corrupt, the path from " 
+	 << src << " to " << dest << " " << what << "." << endl;
+  } else {
+    cout << "Error: Route table path from " << src << " to " << dest 
+	 << " " << what << "." << endl;
+  }
+  exit(-1);
+}
+
+//filename is the file the table was loaded from, empty for a built table
+void RouteTable::_CheckDeadlock( Network *net, const string &filename ) const
+{
+  const vector<Router *> &routers = net->GetRouters( );
+  int num_routers = net->NumRouters( );
+  int classes     = _format.vc_classes;
+
+  // node c = ( router * ports + output port ) * classes + VC class
+  int ports = 0;
+  for ( int r = 0; r < num_routers; ++r ) {
+    if ( routers[r]->NumOutputs( ) > ports ) {
+      ports = routers[r]->NumOutputs( );
+    }
+  }
+
+  vector<vector<int> > depend( num_routers * ports * classes );
+
+  for ( int src = 0; src < _nodes; ++src ) {
+    for ( int dest = 0; dest < _nodes; ++dest ) {
+      for ( int p = 0; p < NumPaths( src, dest ); ++p ) {
+	SourceRouteCursor cursor;
+	cursor.Start( &_format, Words( src, dest, p ), Length( src, dest, p ) );
+
+	int r    = net->GetInject( )[src]->GetSink( );
+	int prev = -1;
+	FlitChannel *last = 0;
+	while ( ( cursor.hop < cursor.length ) && ( r >= 0 ) ) {
+	  int vc_class;
+	  int port = cursor.Pop( &vc_class );
+	  if ( ( port >= routers[r]->NumOutputs( ) ) || ( vc_class >= classes ) ) {
+	    _BadPath( filename, src, dest, "uses a missing port or VC class" );
+	  }
+	  int chan = ( r * ports + port ) * classes + vc_class;
+	  if ( prev >= 0 ) {
+	    depend[prev].push_back( chan );
+	  }
+	  prev = chan;
+	  last = routers[r]->GetOutputChannel( port );
+	  r    = last->GetSink( );
+	}
+
+	// the last hop must be the ejection port of dest
+	if ( ( cursor.hop < cursor.length ) || ( last != net->GetEject( )[dest] ) ) {
+	  _BadPath( filename, src, dest, "does not reach its destination" );
+	}
+      }
+    }
+  }
+
+  for ( unsigned int c = 0; c < depend.size( ); ++c ) {
+    sort( depend[c].begin( ), depend[c].end( ) );
+    depend[c].erase( unique( depend[c].begin( ), depend[c].end( ) ), depend[c].end( ) );
+  }
+
+  // depth first search, a back edge to a node still on the stack is a cycle
+  enum { unvisited, active, done };
+  vector<int> state( depend.size( ), unvisited );
+  vector<pair<int, unsigned int> > stack;
+
+  for ( unsigned int root = 0; root < depend.size( ); ++root ) {
+    if ( state[root] != unvisited ) {
+      continue;
+    }
+    state[root] = active;
+    stack.push_back( make_pair( (int)root, 0u ) );
+    while ( !stack.empty( ) ) {
+      int c = stack.back( ).first;
+      if ( stack.back( ).second == depend[c].size( ) ) {
+	state[c] = done;
+	stack.pop_back( );
+	continue;
+      }
+      int next = depend[c][stack.back( ).second++];
+      if ( state[next] == active ) {
+	cout << "Error: Route table is not deadlock free, its paths form a cycle"
+	     << " through router " << next / classes / ports 
+	     << " output " << ( next / classes ) % ports 
+	     << " VC class " << next % classes
+	     << ". Use fewer route_candidates, a turn-model routing function"
+	     << " or more route_vc_classes." << endl;
+	exit(-1);
+      }
+      if ( state[next] == unvisited ) {
+	state[next] = active;
+	stack.push_back( make_pair( next, 0u ) );
+      }
+    }
+  }
+}
+
+bool RouteTable::_Load( const string &filename, const string &algorithm )
+{
+  int fd = open( filename.c_str( ), O_RDONLY );
+  if ( fd < 0 ) {
+    return false;
+  }
+
+  struct stat st;
+  if ( fstat( fd, &st ) < 0 ) {
+    close( fd );
+    return false;
+  }
+
+  void *m = mmap( 0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  close( fd );
+  if ( m == MAP_FAILED ) {
+    cout << "Error: Unable to map route table file '" << filename << "'." << endl;
+    exit(-1);
+  }
+
+  const RouteTableHeader *h = (const RouteTableHeader *)m;
+  size_t pairs = (size_t)_nodes * _nodes;
+
+  if ( ( (size_t)st.st_size < sizeof( RouteTableHeader ) ) ||
+       strncmp( h->magic, "SRTB", 4 ) ||
+       ( h->version != ROUTE_TABLE_VERSION ) ||
+       strncmp( h->algorithm, algorithm.c_str( ), sizeof( h->algorithm ) ) ||
+       ( h->nodes != (unsigned int)_nodes ) ||
+       ( h->candidates != (unsigned int)_max_paths ) ||
+       ( h->vc_classes != (unsigned int)_format.vc_classes ) ||
+       ( h->port_bits != (unsigned int)_format.port_bits ) ||
+       ( h->class_bits != (unsigned int)_format.class_bits ) ||
+       ( (size_t)st.st_size != sizeof( RouteTableHeader ) + _IndexBytes( pairs, h->paths ) + 
+	 h->words * sizeof( unsigned long long ) ) ) {
+    cout << "Error: Route table file '" << filename 
+	 << "' does not match this network (" << algorithm << ", " << _nodes 
+	 << " nodes, " << _max_paths << " candidates, " << _format.vc_classes 
+	 << " VC classes)." << endl;
+    exit(-1);
+  }
+
+  _map      = m;
+  _map_size = st.st_size;
+
+  _first  = (const unsigned int *)( h + 1 );
+  _length = _first + pairs + 1;
+  _offset = _length + h->paths;
+  _words  = (const unsigned long long *)( (const char *)_first + _IndexBytes( pairs, h->paths ) );
+
+  //every pair must own 1 to route_candidates paths, and every route must
+  //fit in the words
+  bool valid = ( _first[0] == 0 ) && ( _first[pairs] == h->paths );
+  for ( size_t p = 0; valid && ( p < pairs ); ++p ) {
+    valid = ( _first[p] < _first[p+1] ) && 
+      ( _first[p+1] - _first[p] <= (unsigned int)_max_paths );
+  }
+  for ( size_t i = 0; valid && ( i < h->paths ); ++i ) {
+    size_t used = ( (size_t)_length[i] + _format.hops_per_word - 1 ) / _format.hops_per_word;
+    valid = ( (size_t)_offset[i] + used <= h->words );
+  }
+  if ( !valid ) {
+    cout << "Error: Route table file '" << filename << "' is corrupt." << endl;
+    exit(-1);
+  }
+
+  return true;
+}
+
+void RouteTable::_Save( const string &filename, const string &algorithm ) const
+{
+  RouteTableHeader h;
+  size_t pairs = (size_t)_nodes * _nodes;
+  size_t paths = _length_storage.size( );
+
+  if ( algorithm.size( ) >= sizeof( h.algorithm ) ) {
+    cout << "Error: Route table algorithm '" << algorithm 
+	 << "' is too long for the route table file." << endl;
+    exit(-1);
+  }
+
+  memset( &h, 0, sizeof( h ) );
+  memcpy( h.magic, "SRTB", 4 );
+  h.version    = ROUTE_TABLE_VERSION;
+  strcpy( h.algorithm, algorithm.c_str( ) );
+  h.nodes      = _nodes;
+  h.candidates = _max_paths;
+  h.vc_classes = _format.vc_classes;
+  h.port_bits  = _format.port_bits;
+  h.paths      = paths;
+  h.class_bits = _format.class_bits;
+  h.words      = _word_storage.size( );
+
+  FILE *out = fopen( filename.c_str( ), "wb" );
+  if ( !out ) {
+    cout << "Error: Unable to write route table file '" << filename << "'." << endl;
+    exit(-1);
+  }
+
+  size_t index_bytes = ( pairs + 1 + 2 * paths ) * sizeof( unsigned int );
+  char   pad[8]      = { 0 };
+
+  fwrite( &h, sizeof( h ), 1, out );
+  fwrite( _first, sizeof( unsigned int ), pairs + 1, out );
+  fwrite( _length, sizeof( unsigned int ), paths, out );
+  fwrite( _offset, sizeof( unsigned int ), paths, out );
+  fwrite( pad, 1, _IndexBytes( pairs, paths ) - index_bytes, out );
+  fwrite( _words, sizeof( unsigned long long ), h.words, out );
+  fclose( out );
+}
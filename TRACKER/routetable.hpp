@@ -0,0 +1,127 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _ROUTETABLE_HPP_
+#define _ROUTETABLE_HPP_
+
+#include <string>
+#include <map>
+#include <vector>
+
+#include "config_utils.hpp"
+#include "network.hpp"
+#include "routefunc.hpp"
+#include "sourceroute.hpp"
+
+using namespace std;
+
+//fills in the route from src to dest, one output port per hop with the
+//eject port last
+typedef void (*tRouteBuilder)( int src, int dest, SourceRoute *r );
+
+extern map<string, tRouteBuilder> gRouteBuilderMap;
+
+void InitializeRouteBuilderMap( );
+
+//all-pairs table of packed source routes, built once at startup or mapped
+//in from a route table file; read only while simulating
+//
+//route_table names either a route builder (one path per pair) or any
+//registered hop-by-hop routing function, which is compiled by walking it
+//through the network; up to route_candidates paths are kept per pair
+//
+//every hop also carries one of route_vc_classes VC classes, taken from the
+//VCs the compiled routing function offers (dateline classes on a torus);
+//rajagiri gives the hop every VC of that class, so the channel and class
+//dependencies of all the paths together must be acyclic; a table that is
+//not is rejected
+class RouteTable {
+  int _nodes;
+  int _max_paths;
+
+  SourceRouteFormat _format;
+
+  //storage when the table is built here
+  vector<unsigned int>       _first_storage;
+  vector<unsigned int>       _length_storage;
+  vector<unsigned int>       _offset_storage;
+  vector<unsigned long long> _word_storage;
+
+  //storage when the table is mapped from a file
+  void   *_map;
+  size_t  _map_size;
+
+  const unsigned int       *_first;
+  const unsigned int       *_length;
+  const unsigned int       *_offset;
+  const unsigned long long *_words;
+
+  void _Build( tRouteBuilder builder );
+  void _Compile( tRoutingFunction rf, Network *net );
+  void _Walk( tRoutingFunction rf, Network *net, int src, int dest,
+	      FlitChannel *channel, Flit f, const SourceRoute &r,
+	      vector<SourceRoute> *paths ) const;
+  void _Append( const SourceRoute &r );
+  void _Finish( );
+  void _CheckDeadlock( Network *net, const string &filename ) const;
+  bool _Load( const string &filename, const string &algorithm );
+  void _Save( const string &filename, const string &algorithm ) const;
+
+public:
+  RouteTable( const Configuration &config, Network *net );
+  ~RouteTable( );
+
+  inline int NumNodes( ) const
+  {
+    return _nodes;
+  }
+
+  inline const SourceRouteFormat *Format( ) const
+  {
+    return &_format;
+  }
+
+  inline int NumPaths( int src, int dest ) const
+  {
+    int pair = src * _nodes + dest;
+    return _first[pair + 1] - _first[pair];
+  }
+
+  inline int Length( int src, int dest, int path = 0 ) const
+  {
+    return _length[_first[src * _nodes + dest] + path];
+  }
+
+  inline const unsigned long long *Words( int src, int dest, int path = 0 ) const
+  {
+    return &_words[_offset[_first[src * _nodes + dest] + path]];
+  }
+};
+
+#endif
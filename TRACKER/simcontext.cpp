@@ -0,0 +1,73 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*simcontext.cpp
+ *
+ *The state owned by one simulation
+ *
+ */
+
+#include "booksim.hpp"
+#include "simcontext.hpp"
+
+thread_local SimContext *gSim = 0;
+
+SimContext::SimContext( ) :
+  _owner( this_thread::get_id( ) ),
+  k( 0 ), n( 0 ), c( 0 ), log2_c( 0 ), real_k( 0 ), real_n( 0 ), nodes( 0 ),
+  xr( 0 ), yr( 0 ), x( 0 ), y( 0 ),
+  num_vcs( 0 ),
+  read_req_begin_vc( 0 ), read_req_end_vc( 0 ),
+  write_req_begin_vc( 0 ), write_req_end_vc( 0 ),
+  read_reply_begin_vc( 0 ), read_reply_end_vc( 0 ),
+  write_reply_begin_vc( 0 ), write_reply_end_vc( 0 ),
+  const_packet_size( 0 ), burst_alpha( 0.0 ), burst_beta( 0.0 ),
+  perm( 0 ), perm_seed( 0 ), reset_traffic( 0 ), step_traffic( 0 ),
+  anynet_routing_table( 0 ),
+  manager( 0 ), watch_out( 0 ), log( 0 ),
+  ran_arr_dummy( -1 ), ran_arr_started( -1 ), ran_arr_ptr( &ran_arr_dummy ),
+  ranf_arr_dummy( -1.0 ), ranf_arr_started( -1.0 ), ranf_arr_ptr( &ranf_arr_dummy )
+{
+}
+
+SimContext::~SimContext( )
+{
+  delete [] perm;
+}
+
+ostream &SimContext::Trace( )
+{
+  static thread_local ofstream closed;
+
+  if ( this_thread::get_id( ) != _owner ) {
+    return closed;
+  }
+  return trace;
+}
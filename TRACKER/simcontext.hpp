@@ -0,0 +1,139 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _SIMCONTEXT_HPP_
+#define _SIMCONTEXT_HPP_
+
+#include <map>
+#include <vector>
+#include <thread>
+#include <iostream>
+#include <fstream>
+
+using namespace std;
+
+class TrafficManager;
+
+//what the bofar_tracker, fvc_comp and flits_comp selection strategies
+//remember of the candidate evaluated before (see IQRouterBaseline)
+struct SelectHistory {
+  struct { int bofar, tracker, pri, fid; } bofar_tracker;
+  struct { int fv, pri, fid; } fvc;
+  struct { int ne, nw, se, sw, port, flits, pri, fid; } flits;
+
+  SelectHistory( )
+  {
+    bofar_tracker.bofar = bofar_tracker.tracker = bofar_tracker.pri = bofar_tracker.fid = -1;
+    fvc.fv = fvc.pri = fvc.fid = -1;
+    flits.ne = flits.nw = flits.se = flits.sw = 0;
+    flits.port  = -1;
+    flits.flits = flits.pri = 0;
+    flits.fid   = -1;
+  }
+};
+
+//Everything a simulation changes while it is set up and run
+//
+//Each simulation, the single run in main( ) or one point of a sweep, owns
+//a context and installs it in gSim on the thread that drives it; the
+//threads stepping its routers (see ParallelStepper) install the same one.
+//Independent simulations can then coexist in one process. Registries
+//(routing, traffic, selection, injection maps) and command line options
+//stay process wide.
+class SimContext {
+  thread::id _owner;
+
+  SimContext( const SimContext & );
+  SimContext &operator=( const SimContext & );
+
+public:
+  enum { RAN_KK = 100, RAN_QUALITY = 1009 };  // KK and QUALITY of rng.cpp
+
+  // topology, set by the Network constructors
+  int k;        // radix
+  int n;        // dimension
+  int c;        // concentration
+  int log2_c;
+  int real_k;   // radix and dimension the traffic patterns see: under
+  int real_n;   // concentration, radix 4 with 4 nodes per router is radix 8
+  int nodes;
+  int xr, yr;   // nodes per router in x and y (cmesh, flatfly, MECS)
+  int x, y;     // routers in x and y
+
+  // virtual channel classes, set by GetRoutingFunction( )
+  int num_vcs;
+  int read_req_begin_vc,    read_req_end_vc;
+  int write_req_begin_vc,   write_req_end_vc;
+  int read_reply_begin_vc,  read_reply_end_vc;
+  int write_reply_begin_vc, write_reply_end_vc;
+
+  // injection, set by GetInjectionProcess( )
+  int    const_packet_size;
+  double burst_alpha;
+  double burst_beta;
+  vector<int> node_states;  // on_off
+
+  // traffic patterns
+  int *perm;                // randperm
+  int  perm_seed;
+  int  reset_traffic;
+  int  step_traffic;
+
+  vector<unsigned char> oddeven_ports;  // see IQRouterBaseline
+  SelectHistory select_history;         // shared by serially stepped routers
+  map<int, int> *anynet_routing_table;
+
+  TrafficManager *manager;
+  ostream        *watch_out;
+  ostream        *log;      // cout of a sweep point, see RunSweep
+  ofstream        trace;    // track.txt
+  ofstream        stats;    // stats_lat.txt
+
+  // the state of Knuth's generators, rng.cpp and rng_double.cpp
+  long   ran_x[RAN_KK];
+  long   ran_arr_buf[RAN_QUALITY];
+  long   ran_arr_dummy, ran_arr_started;
+  long  *ran_arr_ptr;
+  double ran_u[RAN_KK];
+  double ranf_arr_buf[RAN_QUALITY];
+  double ranf_arr_dummy, ranf_arr_started;
+  double *ranf_arr_ptr;
+
+  SimContext( );
+  ~SimContext( );
+
+  // the debug trace; threads other than the owner get a closed stream, so
+  // router stepping threads never write into it
+  ostream &Trace( );
+};
+
+extern thread_local SimContext *gSim;
+
+#endif
@@ -0,0 +1,106 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*sourceroute.cpp
+ *
+ *A source route is filled in one hop at a time by a route builder, then
+ *copied into the all-pairs route table (routetable.cpp). The table picks
+ *the format: enough port bits for its widest router, and class bits when
+ *the routes carry VC classes (torus datelines).
+ */
+
+#include "booksim.hpp"
+#include "sourceroute.hpp"
+
+static int _BitsFor( int values )
+{
+  int bits = 0;
+  while ( ( 1 << bits ) < values ) {
+    ++bits;
+  }
+  return bits;
+}
+
+SourceRouteFormat::SourceRouteFormat( int ports, int classes )
+{
+  port_bits     = _BitsFor( ports ) > 0 ? _BitsFor( ports ) : 1;
+  class_bits    = _BitsFor( classes );
+  vc_classes    = classes;
+  hop_bits      = port_bits + class_bits;
+  hops_per_word = 64 / hop_bits;
+  port_mask     = ( 1ULL << port_bits ) - 1;
+  hop_mask      = ( 1ULL << hop_bits ) - 1;
+}
+
+void SourceRouteFormat::ClassRange( int vc_class, int lo, int hi, int *vc_min, int *vc_max ) const
+{
+  int size = hi - lo + 1;
+  *vc_min = lo + ( vc_class * size ) / vc_classes;
+  *vc_max = lo + ( ( vc_class + 1 ) * size ) / vc_classes - 1;
+}
+
+int SourceRouteFormat::ClassOf( int vc, int lo, int hi ) const
+{
+  return ( ( vc - lo ) * vc_classes ) / ( hi - lo + 1 );
+}
+
+SourceRoute::SourceRoute( const SourceRouteFormat *format )
+  : _format(format)
+{
+  Reset( );
+}
+
+void SourceRoute::Reset( )
+{
+  // keep the capacity, the table builder reuses one route for every pair
+  _words.clear( );
+  _length = 0;
+}
+
+void SourceRoute::Push( int out_port, int vc_class )
+{
+  assert( ( out_port >= 0 ) && ( (unsigned long long)out_port <= _format->port_mask ) );
+  assert( ( vc_class >= 0 ) && ( vc_class < _format->vc_classes ) );
+
+  int w = _length / _format->hops_per_word;
+  if ( w == (int)_words.size( ) ) {
+    _words.push_back( 0 );
+  }
+  unsigned long long code = ( (unsigned long long)vc_class << _format->port_bits ) | out_port;
+  _words[w] |= code << ( _format->hop_bits * ( _length % _format->hops_per_word ) );
+  ++_length;
+}
+
+int SourceRoute::Port( int hop ) const
+{
+  assert( ( hop >= 0 ) && ( hop < _length ) );
+  return int( ( _words[hop / _format->hops_per_word] >> 
+		( _format->hop_bits * ( hop % _format->hops_per_word ) ) ) & _format->port_mask );
+}
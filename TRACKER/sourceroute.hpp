@@ -0,0 +1,125 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _SOURCEROUTE_HPP_
+#define _SOURCEROUTE_HPP_
+
+#include <vector>
+#include <assert.h>
+
+using namespace std;
+
+//how the hops of a route are packed: the output port in the low port_bits,
+//the VC class above it, hops_per_word hops to a 64 bit word and hop 0 in
+//the low bits of word 0
+struct SourceRouteFormat {
+  int port_bits;
+  int class_bits;
+  int vc_classes;
+  int hop_bits;
+  int hops_per_word;
+  unsigned long long port_mask;
+  unsigned long long hop_mask;
+
+  SourceRouteFormat( int ports = 8, int classes = 1 );
+
+  //VC class c is the c-th of vc_classes equal parts of [lo, hi]
+  void ClassRange( int vc_class, int lo, int hi, int *vc_min, int *vc_max ) const;
+  int  ClassOf( int vc, int lo, int hi ) const;
+};
+
+//the output port, and VC class, to take at every hop of a packet, filled
+//in by a route builder and flattened into the route table; routes can be
+//any length
+class SourceRoute {
+public:
+  SourceRoute( const SourceRouteFormat *format );
+
+  void Reset( );
+  void Push( int out_port, int vc_class = 0 );
+
+  inline int Length( ) const
+  {
+    return _length;
+  }
+
+  inline const unsigned long long *Words( ) const
+  {
+    return _words.empty( ) ? 0 : &_words[0];
+  }
+
+  inline int NumWords( ) const
+  {
+    return (int)_words.size( );
+  }
+
+  int Port( int hop ) const;
+
+private:
+  const SourceRouteFormat *_format;
+  vector<unsigned long long> _words;
+  int _length;
+};
+
+//shift-and-pop cursor into packed route words; the low bits of word are
+//always the next hop
+struct SourceRouteCursor {
+  const SourceRouteFormat *format;
+  const unsigned long long *words;
+  unsigned long long word;
+  int length;
+  int hop;
+
+  inline void Start( const SourceRouteFormat *f, const unsigned long long *w, int l )
+  {
+    format = f;
+    words  = w;
+    length = l;
+    word   = 0;
+    hop    = 0;
+  }
+
+  inline int Pop( int *vc_class = 0 )
+  {
+    assert( words && ( hop < length ) );
+    if ( ( hop % format->hops_per_word ) == 0 ) {
+      word = words[hop / format->hops_per_word];
+    }
+    unsigned long long code = word & format->hop_mask;
+    word >>= format->hop_bits;
+    ++hop;
+    if ( vc_class ) {
+      *vc_class = int( code >> format->port_bits );
+    }
+    return int( code & format->port_mask );
+  }
+};
+
+#endif
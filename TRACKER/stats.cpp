@@ -115,6 +115,27 @@ void Stats::AddSample( int val )
   AddSample( (double)val );
 }
 
+// n samples of val at once; the sum matches n single samples as long as
+// they add up exactly, e.g. for whole numbers
+void Stats::AddSamples( double val, int n )
+{
+  int b;
+
+  if ( n <= 0 )
+    return;
+
+  _num_samples += n;
+  _sample_sum += val * n;
+
+  _max = fmax(val, _max);
+  _min = fmin(val, _min);
+
+  b = (int)fmax(floor( val / _bin_size ), 0.0);
+  b = (b >= _num_bins) ? (_num_bins - 1) : b;
+
+  _hist[b] += n;
+}
+
 void Stats::Display( ) const
 {
   cout << *this << endl;
@@ -60,6 +60,7 @@ public:
 
   void AddSample( double val );
   void AddSample( int val );
+  void AddSamples( double val, int n );
 
   int GetBin(int b){ return _hist[b];}
 
@@ -0,0 +1,233 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*sweep.cpp
+ *
+ *Runs the points of a parameter sweep concurrently inside one process
+ *
+ */
+
+#include "booksim.hpp"
+#include <sys/time.h>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <streambuf>
+
+#include "sweep.hpp"
+#include "trafficmanager.hpp"
+#include "globals.hpp"
+
+SweepPoint::SweepPoint( const BookSimConfig &base ) :
+  config( base ), result( false ), accepted( 0.0 ), hops( 0.0 )
+{
+}
+
+void SweepPoint::Record( TrafficManager *tm )
+{
+  latency.resize( tm->NumClasses( ) );
+  for ( int c = 0; c < tm->NumClasses( ); ++c ) {
+    latency[c] = tm->GetOverallLatency( c )->Average( );
+  }
+  accepted = tm->GetAccepted( )->Average( );
+  hops     = tm->GetHops( )->Average( );
+}
+
+// cout while a sweep runs: threads of a point (its own and those stepping
+// its routers) write into the point's log, any other thread to the terminal
+class SweepOutput : public streambuf {
+  streambuf *_terminal;
+  mutex      _lock;
+
+protected:
+  virtual int overflow( int c )
+  {
+    if ( c != EOF ) {
+      char ch = c;
+      xsputn( &ch, 1 );
+    }
+    return c;
+  }
+
+  virtual streamsize xsputn( const char *s, streamsize n )
+  {
+    lock_guard<mutex> lock( _lock );
+    if ( gSim && gSim->log ) {
+      gSim->log->write( s, n );
+    } else {
+      _terminal->sputn( s, n );
+    }
+    return n;
+  }
+
+  // endl; keeps a point's log complete even if the run exits
+  virtual int sync( )
+  {
+    lock_guard<mutex> lock( _lock );
+    if ( gSim && gSim->log ) {
+      gSim->log->flush( );
+    }
+    return _terminal->pubsync( );
+  }
+
+public:
+  SweepOutput( streambuf *terminal ) : _terminal( terminal ) { }
+};
+
+bool RunSweep( const BookSimConfig &config )
+{
+  const vector< pair<string, vector<string> > > &sweeps = config.GetSweeps( );
+  SimContext *parent = gSim;
+
+  int threads = config.GetInt( "sweep_threads" );
+  if ( threads <= 0 ) {
+    threads = thread::hardware_concurrency( );
+  }
+  if ( threads < 1 ) {
+    threads = 1;
+  }
+  if ( parent->watch_out && threads > 1 ) {
+    cout << "Error: watch_out needs sweep_threads = 1." << endl;
+    exit(-1);
+  }
+  // the VC state counters are process wide
+  if ( config.GetInt( "print_vc_stats" ) && threads > 1 ) {
+    cout << "Error: print_vc_stats needs sweep_threads = 1." << endl;
+    exit(-1);
+  }
+
+  // the cross product, last field varying fastest
+  vector<SweepPoint *> points;
+  vector<int> index( sweeps.size( ), 0 );
+  int f;
+  do {
+    SweepPoint *point = new SweepPoint( config );
+    for ( f = 0; f < (int)sweeps.size( ); ++f ) {
+      point->values.push_back( sweeps[f].second[index[f]] );
+      point->config.AssignText( sweeps[f].first, point->values.back( ) );
+    }
+    points.push_back( point );
+
+    for ( f = sweeps.size( ) - 1;
+	  f >= 0 && ++index[f] == (int)sweeps[f].second.size( ); --f ) {
+      index[f] = 0;
+    }
+  } while ( f >= 0 );
+
+  for ( size_t p = 0; p < points.size( ); ++p ) {
+    ostringstream name;
+    name << "sweep_" << p << ".txt";
+    points[p]->log.open( name.str( ).c_str( ) );
+    if ( !points[p]->log ) {
+      cout << "Error: Unable to open " << name.str( ) << "." << endl;
+      exit(-1);
+    }
+  }
+
+  cout << "Sweeping " << points.size( ) << " points on " << threads
+       << " threads, point output in sweep_<point>.txt" << endl;
+
+  SweepOutput output( cout.rdbuf( ) );
+  streambuf *terminal = cout.rdbuf( &output );
+
+  struct timeval start_time, end_time;
+  gettimeofday( &start_time, NULL );
+
+  // Every point runs in a fresh thread with a fresh SimContext, so its
+  // state (topology, random generator, traffic permutation, ...) starts out
+  // exactly as in a separate booksim process.
+  mutex lock;
+  condition_variable idle;
+  int running = 0;
+  vector<thread> workers;
+
+  for ( size_t p = 0; p < points.size( ); ++p ) {
+    unique_lock<mutex> wait( lock );
+    idle.wait( wait, [&] { return running < threads; } );
+    ++running;
+    wait.unlock( );
+
+    SweepPoint *point = points[p];
+    workers.push_back( thread( [&, point] {
+	  SimContext sim;
+	  sim.watch_out = parent->watch_out;
+	  sim.log       = &point->log;
+	  gSim = &sim;
+	  point->result = AllocatorSim( point->config, point );
+	  gSim = 0;
+	  lock_guard<mutex> done( lock );
+	  --running;
+	  idle.notify_one( );
+	} ) );
+  }
+  for ( size_t w = 0; w < workers.size( ); ++w ) {
+    workers[w].join( );
+  }
+  cout.rdbuf( terminal );
+
+  gettimeofday( &end_time, NULL );
+
+  ostringstream table;
+  bool result = true;
+
+  table << "#";
+  for ( f = 0; f < (int)sweeps.size( ); ++f ) {
+    table << " " << sweeps[f].first;
+  }
+  table << " class latency accepted hops status" << endl;
+
+  for ( size_t p = 0; p < points.size( ); ++p ) {
+    SweepPoint *point = points[p];
+    for ( size_t c = 0; c < point->latency.size( ); ++c ) {
+      for ( f = 0; f < (int)sweeps.size( ); ++f ) {
+	table << point->values[f] << " ";
+      }
+      table << c << " ";
+      if ( point->result ) {
+	table << point->latency[c] << " " << point->accepted << " "
+	      << point->hops << " ok" << endl;
+      } else {
+	table << "- - - unstable" << endl;
+      }
+    }
+    result = result && point->result;
+    delete point;
+  }
+
+  cout << "====== Sweep results ======" << endl << table.str( );
+  cout << "Total sweep time "
+       << ( end_time.tv_sec - start_time.tv_sec ) +
+          ( end_time.tv_usec - start_time.tv_usec ) / 1000000.0 << endl;
+  parent->stats << table.str( );
+
+  return result;
+}
@@ -0,0 +1,70 @@
+// $Id$
+
+/*
+Copyright (c) 2007-2009, Trustees of The Leland Stanford Junior University
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this 
+list of conditions and the following disclaimer in the documentation and/or 
+other materials provided with the distribution.
+Neither the name of the Stanford University nor the names of its contributors 
+may be used to endorse or promote products derived from this software without 
+specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND 
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR 
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _SWEEP_HPP_
+#define _SWEEP_HPP_
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "booksim_config.hpp"
+
+using namespace std;
+
+class TrafficManager;
+
+// One point of a sweep: its own copy of the configuration, and the results
+// its traffic manager left behind.
+struct SweepPoint {
+  BookSimConfig  config;
+  vector<string> values;   // one per swept field
+  bool           result;   // Run( ) completed
+  vector<double> latency;  // overall average latency per class
+  double         accepted;
+  double         hops;
+  ofstream       log;      // everything the point writes to cout
+
+  SweepPoint( const BookSimConfig &base );
+
+  void Record( TrafficManager *tm );
+};
+
+// Runs every point of a "field = {...};" sweep, the cross product of the
+// swept fields, each in its own thread with its own SimContext, networks
+// and traffic manager, at most sweep_threads at a time, then prints and
+// appends to stats_lat.txt one table of the results. What a point writes
+// to cout goes to sweep_<point>.txt instead, so only the table reaches cout.
+bool RunSweep( const BookSimConfig &config );
+
+// main.cpp: one complete run; fills point when given
+bool AllocatorSim( const Configuration& config, SweepPoint *point );
+
+#endif
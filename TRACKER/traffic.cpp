@@ -39,8 +39,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 map<string, tTrafficFunction> gTrafficFunctionMap;
 
-int gResetTraffic = 0;
-int gStepTraffic  = 0;
 
 void src_dest_bin( int source, int dest, int lg )
 {
@@ -188,12 +186,12 @@ int tornado( int source, int total_nodes )
   int offset = 1;
   int dest = 0;
   
-  //cout<<"realgn"<<realgn<<endl<<"realgk"<<realgk<<endl;
+  //cout<<"gSim->real_n"<<gSim->real_n<<endl<<"gSim->real_k"<<gSim->real_k<<endl;
 
-  for ( int n = 0; n < realgn; ++n ) {
+  for ( int n = 0; n < gSim->real_n; ++n ) {
     dest += offset *
-      ( ( ( source / offset ) % realgk + ( realgk/2 - 1 ) ) % realgk );
-    offset *= realgk;
+      ( ( ( source / offset ) % gSim->real_k + ( gSim->real_k/2 - 1 ) ) % gSim->real_k );
+    offset *= gSim->real_k;
   }
   //cout<<source<<" "<<dest<<endl;
   //getchar();
@@ -207,10 +205,10 @@ int neighbor( int source, int total_nodes )
   int offset = 1;
   int dest = 0;
 
-  for ( int n = 0; n < realgn; ++n ) {
+  for ( int n = 0; n < gSim->real_n; ++n ) {
     dest += offset *
-      ( ( ( source / offset ) % realgk + 1 ) % realgk );
-    offset *= realgk;
+      ( ( ( source / offset ) % gSim->real_k + 1 ) % gSim->real_k );
+    offset *= gSim->real_k;
   }
 
   //cout<<"Source "<<source<<" destination "<<dest<<endl;
@@ -219,8 +217,7 @@ int neighbor( int source, int total_nodes )
 
 //=============================================================
 
-int *gPerm = 0;
-int gPermSeed;
+// the permutation and its seed live in gSim
 
 void GenerateRandomPerm( int total_nodes )
 {
@@ -230,14 +227,14 @@ void GenerateRandomPerm( int total_nodes )
   unsigned long prev_rand;
   
   prev_rand = RandomIntLong( );
-  RandomSeed( gPermSeed );
+  RandomSeed( gSim->perm_seed );
 
-  if ( !gPerm ) {
-    gPerm = new int [total_nodes];
+  if ( !gSim->perm ) {
+    gSim->perm = new int [total_nodes];
   }
 
   for ( i = 0; i < total_nodes; ++i ) {
-    gPerm[i] = -1;
+    gSim->perm[i] = -1;
   }
 
   for ( i = 0; i < total_nodes; ++i ) {
@@ -246,8 +243,8 @@ void GenerateRandomPerm( int total_nodes )
     j   = 0;
     cnt = 0;
     while( ( cnt < ind ) ||
-	   ( gPerm[j] != -1 ) ) {
-      if ( gPerm[j] == -1 ) { ++cnt; }
+	   ( gSim->perm[j] != -1 ) ) {
+      if ( gSim->perm[j] == -1 ) { ++cnt; }
       ++j;
 
       if ( j >= total_nodes ) {
@@ -256,7 +253,7 @@ void GenerateRandomPerm( int total_nodes )
       }
     }
     
-    gPerm[j] = i;
+    gSim->perm[j] = i;
   }
 
   RandomSeed( prev_rand );
@@ -264,12 +261,12 @@ void GenerateRandomPerm( int total_nodes )
 
 int randperm( int source, int total_nodes )
 {
-  if ( gResetTraffic || !gPerm ) {
+  if ( gSim->reset_traffic || !gSim->perm ) {
     GenerateRandomPerm( total_nodes );
-    gResetTraffic = 0;
+    gSim->reset_traffic = 0;
   }
 
-  return gPerm[source];
+  return gSim->perm[source];
 }
 
 //=============================================================
@@ -329,8 +326,8 @@ int taper64( int source, int total_nodes )
 
 int badperm_dfly( int source, int total_nodes )
 {
-  int grp_size_routers = powi(realgk, realgn - 1);
-  int grp_size_nodes = grp_size_routers * realgk;
+  int grp_size_routers = powi(gSim->real_k, gSim->real_n - 1);
+  int grp_size_nodes = grp_size_routers * gSim->real_k;
 
   int temp;
   int dest;
@@ -343,8 +340,8 @@ int badperm_dfly( int source, int total_nodes )
 
 int badperm_dflynew( int source, int total_nodes )
 {
-  int grp_size_routers = 2*realgk;
-  int grp_size_nodes = grp_size_routers * realgk;
+  int grp_size_routers = 2*gSim->real_k;
+  int grp_size_nodes = grp_size_routers * gSim->real_k;
 
   int temp;
   int dest;
@@ -395,12 +392,12 @@ void InitializeTrafficMap( )
 
 void ResetTrafficFunction( )
 {
-  gResetTraffic++;
+  gSim->reset_traffic++;
 }
 
 void StepTrafficFunction( )
 {
-  gStepTraffic++;
+  gSim->step_traffic++;
 }
 
 
@@ -409,11 +406,11 @@ tTrafficFunction GetTrafficFunction( const Configuration& config )
 
   if(config.GetInt( "c" )!=1){
     int temp =  config.GetInt("xr");
-    realgk = temp*gK;
-    realgn = gN;
+    gSim->real_k = temp*gSim->k;
+    gSim->real_n = gSim->n;
   } else {
-    realgk = gK;
-    realgn = gN;
+    gSim->real_k = gSim->k;
+    gSim->real_n = gSim->n;
   }
 
   string topo;
@@ -434,7 +431,7 @@ tTrafficFunction GetTrafficFunction( const Configuration& config )
     exit(-1);
   }
 
-  gPermSeed = config.GetInt( "perm_seed" );
+  gSim->perm_seed = config.GetInt( "perm_seed" );
 
   //seed the network
   RandomSeed(config.GetInt("seed"));
@@ -37,7 +37,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vc.hpp"
 
 TrafficManager::TrafficManager( const Configuration &config, const vector<Network *> & net )
-  : Module( 0, "traffic_manager" ), _net(net), _cur_id(0), _cur_pid(0),
+  : Module( 0, "traffic_manager" ), _net(net),
+   _credit_pool( config.GetInt( "num_vcs" ) ), _cur_id(0), _cur_pid(0),
    _time(0), _warmup_time(-1), _drain_time(-1), _empty_network(false),
    _deadlock_counter(1), _sub_network(0), _timed_mode(false), _last_id(-1), 
    _last_pid(-1)
@@ -47,12 +48,6 @@ TrafficManager::TrafficManager( const Configuration &config, const vector<Networ
 	_dests   = _net[0]->NumDests( );   // from network.cpp
 	_routers = _net[0]->NumRouters( );
 
-	Flit* ftemp = new Flit[  _sources ]; // instantiate flit .. see flit.cpp
-  	for(int i = 0; i<  _sources ; i++)
-	{
-		_flit_pool.push_back(&ftemp[i]);
-  	}
-
 	  //nodes higher than limit do not produce or receive packets
 	  //for default limit = sources
 
@@ -356,6 +351,11 @@ TrafficManager::TrafficManager( const Configuration &config, const vector<Networ
 	_routing_function  = GetRoutingFunction( config );
 	_injection_process = GetInjectionProcess( config );
 
+	string routing_function;
+	config.GetStr( "routing_function", routing_function );
+	_route_table = ( routing_function == "rajagiri" ) ? new RouteTable( config, _net[0] ) : 0;
+	_path_selector = _route_table ? new PathSelector( config, _net, _route_table ) : 0;
+
   	string sim_type;
   	config.GetStr( "sim_type", sim_type );  // recognise the type of simulation
 
@@ -397,6 +397,7 @@ TrafficManager::TrafficManager( const Configuration &config, const vector<Networ
 
   	_print_csv_results = config.GetInt( "print_csv_results" );
   	_print_vc_stats = config.GetInt( "print_vc_stats" );
+  	_print_flit_arena = config.GetInt( "print_flit_arena" );
   	config.GetStr( "traffic", _traffic ) ;
   	_drain_measured_only = config.GetInt( "drain_measured_only" );
 
@@ -404,6 +405,75 @@ TrafficManager::TrafficManager( const Configuration &config, const vector<Networ
   	config.GetStr( "watch_file", watch_file );
   	_LoadWatchList(watch_file);
 
+	string router, topology;
+	config.GetStr( "router", router );
+	config.GetStr( "topology", topology );
+	bool single_level_iq = ( router == "iq" || router == "iq_combined" || router == "iq_split" ) &&
+		topology != "MECS" && topology != "cmeshx2" && topology != "isolated_mesh";
+
+	int router_threads = config.GetInt( "router_threads" );
+	if ( router_threads > 0 )
+	{
+		if ( !single_level_iq )
+		{
+			cout << "Error: router_threads needs input-queued routers on a single level network." << endl;
+			exit(-1);
+		}
+		if ( ( router_threads > 1 ) && !_flits_to_watch.empty( ) )
+		{
+			cout << "Error: watching flits needs router_threads = 0 or 1." << endl;
+			exit(-1);
+		}
+		for ( int i = 0; i < _duplicate_networks; ++i )
+		{
+			_net[i]->SetRouterThreads( router_threads, config.GetInt( "seed" ) * _duplicate_networks + i );
+		}
+	}
+
+	_event_driven = ( config.GetInt( "event_driven" ) != 0 );
+	if ( config.GetInt( "skip_idle_routers" ) || _event_driven )
+	{
+		if ( router_threads > 0 )
+		{
+			cout << "Error: skip_idle_routers and event_driven need router_threads = 0." << endl;
+			exit(-1);
+		}
+		// the timed channels expect both ends to read and write once a cycle
+		if ( _event_driven && !single_level_iq )
+		{
+			cout << "Error: event_driven needs input-queued routers on a single level network." << endl;
+			exit(-1);
+		}
+		for ( int i = 0; i < _duplicate_networks; ++i )
+		{
+			if ( _event_driven )
+				_net[i]->SetEventDriven( );
+			else
+				_net[i]->SetSkipIdle( true );
+		}
+	}
+	_accept_cycles = 0;
+	_accept_synced.resize( _dests, 0 );
+
+	// subnetworks share no routers or channels, so each can be stepped
+	// on its own thread; injection and ejection stay on this thread
+	_subnet_stepper = 0;
+	int subnet_threads = config.GetInt( "subnet_threads" );
+	if ( subnet_threads > 0 )
+	{
+		if ( ( subnet_threads > 1 ) && !_flits_to_watch.empty( ) )
+		{
+			cout << "Error: watching flits needs subnet_threads = 0 or 1." << endl;
+			exit(-1);
+		}
+		_subnet_stepper = new SubnetStepper( _duplicate_networks, subnet_threads, config.GetInt( "seed" ),
+						     [this]( int i ) { _StepNetwork( i ); _net[i]->WriteOutputs( ); } );
+		for ( int i = 0; i < _duplicate_networks; ++i )
+		{
+			_net[i]->UseOwnSelectHistory( );
+		}
+	}
+
   	string stats_out_file;
   	config.GetStr( "stats_out", stats_out_file );
   	if(stats_out_file == "")
@@ -439,7 +509,9 @@ TrafficManager::TrafficManager( const Configuration &config, const vector<Networ
 
 TrafficManager::~TrafficManager( )
 {
-  	_flit_pool.clear();
+  	delete _subnet_stepper;
+  	delete _path_selector;
+  	delete _route_table;
 	//cout<<" counta="<<counta<<" countb="<<countb<<" countc="<<countc<<" countd="<<countd<<endl;
   	for ( int s = 0; s < _sources; ++s )
 	{
@@ -489,7 +561,7 @@ TrafficManager::~TrafficManager( )
     		delete _accepted_flits[i];
   	}
 
-  	if(gWatchOut && (gWatchOut != &cout)) delete gWatchOut;
+  	if(gSim->watch_out && (gSim->watch_out != &cout)) delete gSim->watch_out;
   	if(_stats_out && (_stats_out != &cout)) delete _stats_out;
   	if(_flow_out && (_flow_out != &cout)) delete _flow_out;
 
@@ -542,18 +614,11 @@ int TrafficManager::DivisionAlgorithm (int packet_type) {
 
 Flit *TrafficManager::_NewFlit( )
 {
-  if(_flit_pool.empty()){
-    Flit* ftemp = new Flit[  _sources ];
-    for(int i = 0; i<  _sources ; i++){
-      _flit_pool.push_back(&ftemp[i]);
-    }
-  }
   //the constructor should initialize everything
-  Flit * f = _flit_pool.back();
-  _flit_pool.pop_back();
+  Flit * f = _flit_arena.New( );
   f->id    = _cur_id;
-  _total_in_flight_flits[_cur_id] = f;
-  f->watch = gWatchOut && (_flits_to_watch.count(_cur_id) > 0);
+  _total_in_flight_flits.Insert(_cur_id, f);
+  f->watch = gSim->watch_out && (_flits_to_watch.count(_cur_id) > 0);
   ++_cur_id;
   return f;
 }
@@ -562,15 +627,13 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
 {
   _deadlock_counter = 1;
 
-  assert(_total_in_flight_flits.count(f->id) > 0);
-  _total_in_flight_flits.erase(f->id);
+  _total_in_flight_flits.Erase(f->id);
   
   if(f->record) {
-    assert(_measured_in_flight_flits.count(f->id) > 0);
-    _measured_in_flight_flits.erase(f->id);
+    _measured_in_flight_flits.Erase(f->id);
   }
    if ( f->id==28760 ) { 
-    fp << GetSimTime() << " | "
+    gSim->Trace( ) << GetSimTime() << " | "
 		<< "node" << dest << " | "
 		<< "Retiring flit " << f->id 
 		<< " (packet " << f->pid
@@ -581,7 +644,7 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
   }
 
   if ( f->watch ) { 
-    *gWatchOut << GetSimTime() << " | "
+    *gSim->watch_out << GetSimTime() << " | "
 		<< "node" << dest << " | "
 		<< "Retiring flit " << f->id 
 		<< " (packet " << f->pid
@@ -601,12 +664,11 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
   }
 
   if ( f->tail ) {
-    assert(_total_in_flight_packets.count(f->pid) > 0);
-    Flit * head = _total_in_flight_packets.lower_bound(f->pid)->second;
-    assert(head->head);
+    Flit * head = _total_in_flight_packets.Find(f->pid);
+    assert(head && head->head);
     assert(f->pid == head->pid);
     if ( f->id==28760 ) { 
-      fp << GetSimTime() << " | "
+      gSim->Trace( ) << GetSimTime() << " | "
 		 << "node" << dest << " | "
 		 << "Retiring packet " << f->pid 
 		 << " (lat = " << f->atime - head->time
@@ -616,7 +678,7 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
 		 << ")." << endl;
     }
     if ( f->watch ) { 
-      *gWatchOut << GetSimTime() << " | "
+      *gSim->watch_out << GetSimTime() << " | "
 		 << "node" << dest << " | "
 		 << "Retiring packet " << f->pid 
 		 << " (lat = " << f->atime - head->time
@@ -638,7 +700,7 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
       _repliesPending[dest].push_back(f->id);
     } else {
     if ( f->id==28760) { 
-	fp << GetSimTime() << " | "
+	gSim->Trace( ) << GetSimTime() << " | "
 		   << "node" << dest << " | "
 		   << "Retiring transation " //<< (transation id) 
 		   << " (lat = " << f->atime - head->ttime
@@ -647,7 +709,7 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
 		   << ")." << endl;
       }
       if ( f->watch ) { 
-	*gWatchOut << GetSimTime() << " | "
+	*gSim->watch_out << GetSimTime() << " | "
 		   << "node" << dest << " | "
 		   << "Retiring transation " //<< (transation id) 
 		   << " (lat = " << f->atime - head->ttime
@@ -698,23 +760,19 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
 	_pair_tlat[f->src*_dests+dest]->AddSample( f->atime - f->ttime );
       
       if ( f->record ) {
-	assert(_measured_in_flight_packets.count(f->pid) > 0);
-	_measured_in_flight_packets.erase(f->pid);
+	_measured_in_flight_packets.Erase(f->pid);
       }
     }
 
-    // free all flits associated with the current packet
-    int fpid = f->pid;
-    pair<multimap<int, Flit *>::iterator, multimap<int, Flit *>::iterator> res = _total_in_flight_packets.equal_range(fpid);
-    for(multimap<int, Flit *>::iterator iter = res.first; iter != res.second; ++iter) {
-      assert(iter->second->pid == fpid);
-      //reset the flit and back to the poool
-      iter->second->Reset();
-      _flit_pool.push_back(iter->second);
-    }
-    _total_in_flight_packets.erase(fpid);
+    // the head was kept for the packet statistics above
+    _total_in_flight_packets.Erase(f->pid);
+    _flit_arena.Free(head);
 
   }
+  // the other flits go back to the arena as they retire
+  if ( !f->head ) {
+    _flit_arena.Free(f);
+  }
 }
 
 int TrafficManager::_IssuePacket( int source, int cl )
@@ -753,7 +811,7 @@ int TrafficManager::_IssuePacket( int source, int cl )
 		 (_requestsOutstanding[source] >= _maxOutstanding)) {
 	result = 0;
       } else {
-	result = gConstPacketSize;
+	result = gSim->const_packet_size;
 	_packets_sent[source]++;
 	//here is means, how many flits can be waiting in the queue
 	_requestsOutstanding[source]++;
@@ -789,362 +847,6 @@ int TrafficManager::_IssuePacket( int source, int cl )
   }
   return result;
 }
-void TrafficManager::_Sourceroute(int source, int packet_destination, Flit *f)
-{
-	int xDistance,yDistance;
-	
-	xDistance = ((source % gK) - (packet_destination % gK));   // Calculate Distance along the x direction
-	
-	
-	int m=0;
-	if(xDistance!=0)
-	{
-	if(xDistance>0)
-	{
-		for(m=0;m<abs(xDistance);m++)
-		f->test[m]=1;//Towards East
-	}
-	else
-	{
-		for(;m<abs(xDistance);m++)
-		f->test[m]=0;//Towards West
-	}}
-	
-	yDistance = ((source / gK) - (packet_destination / gK));   // Calculate Distance along the y direction
-	
-	
-
-	if(yDistance!=0)
-	{
-	if(yDistance<0)
-	{
-		for(;m<(abs(yDistance)+abs(xDistance));m++)
-		f->test[m]=2;//Towards North
-	}
-	else
-	{
-		for(;m<(abs(yDistance)+abs(xDistance));m++)
-		f->test[m]=3;//Towards South
-	}}    
-	f->test[m++]=4;
-	// for(int k=0;k<m;k++)
-  	//  cout<<"path:"<<f->test[k];
-  	  
-  	//  cout<<"\n\n End";
-}
-
-void TrafficManager::_Sourcerouteoddeven1(int Source, int packet_destination, Flit *f)
- {
- 	// int m=0;
- 	 int out_port,cur,dest,src;
-  	int s0,s1,d0,d1,c0,c1,e0,e1,m=0,flag=0,c=0;
- 	
- 	dest=packet_destination;
-  src=Source;
-  cur=src;
-  s0=src%4;
-  s1=src/4;
-  d0=dest%4;
-  d1=dest/4;
-  c0=cur%4;
-  c1=cur/4;
-  e0=d0-c0;
-  e1=d1-c1;
-  while(c<10)
-  {
-  c++;
-  if(e0==0 && e1==0)
-  {
-  	//outputs->AddRange( 4, 0, gNumVCS-1,1 ); //deliver the packet to the local node and exit
-  	f->test[m++]=4;
-  	cout<<"\n"<<"source:"<<src<<"dest:"<<dest<< "path:";
- 	for(int i=0;i<10;i++)
-	cout<<f->test[i];
-  	return;
-  	
-  }
-  else if(e0==0)//currently in the same column as dest
-  {
-  	if(e1>0)
-  	{
-  		//outputs->AddRange( 2, 0, gNumVCS-1,1 );//add north
-  			
-  			f->test[m++]=2;//north
-  			cur+=4;
-  			c0=cur%4;
-  			c1=cur/4;
-  			e0=d0-c0;
-  			e1=d1-c1;
-  			continue;
-  	}
-  	else if (e1<0)
-  	{
-  		//outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
-  		
-  			f->test[m++]=3;//south
-  			cur-=4;
-  			c0=cur%4;
-  			c1=cur/4;
-  			e0=d0-c0;
-  			e1=d1-c1;
-  			continue;
-  	}
-  }
-  else
-  {
-  	if(e0>0) //east-bound messages
-  	{
-  		//outputs->AddRange( 0, 0, gNumVCS-1,2 );//add east
-  			f->test[m++]=0;//east
-  			cur+=1;
-  			c0=cur%4;
-  			c1=cur/4;
-  			e0=d0-c0;
-  			e1=d1-c1;
-  		if(e1>0&&c0%2==1)
-  		{
-  			//outputs->AddRange( 2, 0, gNumVCS-1,1 );//add north
-  			f->test[m++]=2;//north
-  			cur+=4;
-  			c0=cur%4;
-  			c1=cur/4;
-  			e0=d0-c0;
-  			e1=d1-c1;
-  			continue;
- 		}
-  		else if(e1<0&&c0%2==1)
-  		{
-  			//outputs->AddRange( 3, 0, gNumVCS-1,1 );//add south
-  			
-  			f->test[m++]=3;//south
-  			cur-=4;
-  			c0=cur%4;
-  			c1=cur/4;
-  			e0=d0-c0;
-  			e1=d1-c1;
-  			continue;
-  			
-  		}
-  	}
-  	else //west-bound messages
-  	{
-  		//outputs->AddRange( 1, 0, gNumVCS-1,1 );//add west
-  		f->test[m++]=1;//west
-  			cur-=1;
-  			c0=cur%4;
-  			c1=cur/4;
-  			e0=d0-c0;
-  			e1=d1-c1;
-  			continue;
-  		
-  	}
-  }
- }
- //cout<<"     "<<f->test[m-1];
- cout<<"\n"<<"source:"<<src<<"dest:"<<dest<< "path:";
- for(int i=0;i<10;i++)
- cout<<f->test[i];
- }
- 
- 
-  void TrafficManager::_Sourcerouteoddeven(int Source, int packet_destination, Flit *f)
- {
- 	int out_port,cur,dest,src;
-  	int s0,s1,d0,d1,c0,c1,e0,e1,m=0,flag=0;
-  //cout<<"in-channel is"<<in_channel<<endl;
-  //getchar();
- // outputs->Clear( );
-  //cur=r->GetID( );
-  dest=packet_destination;
-  src=Source;
-  cur=src;
-  s0=src%4;
-  s1=src/4;
-  d0=dest%4;
-  d1=dest/4;
-  c0=cur%4;
-  c1=cur/4;
- if(f->id>=0)//added by KVM
-  {
-  //print_coords=true;
-  //cout<<"in dor_mesh"<<endl;
- fp<<(*f);
-  //getchar();
-  }
- // cout<<"manu in sourcerouteoddeven";
-  e0=d0-c0;
-  e1=d1-c1;
-  
-  while(1)
-  {
-  	flag=1;
-  	c0=cur%4;
-  	c1=cur/4;
-  	e0=d0-c0;
-  	e1=d1-c1;
-  
-  
-  	if(e0==0&&e1==0)
-  	{
-  		f->test[m++]=4;
-  		cout<<"\n "<<"source:"<<src<<"destination:"<<dest<<"path";
- 		for(int i=0;i<7;i++)
- 		cout<<f->test[i];
-  		return;
-  	}
-  	if(e0==0)		//same col AS dest
-  	{
-  		if(e1>0)
-  		{
-  			if(f->test[m-1]!=2&&cur/4!=3)
-  			{
-  			f->test[m++]=2;//north
-  			cur+=4;
-  			c0=cur%4;
-  			c1=cur/4;
-  			e0=d0-c0;
-  			e1=d1-c1;
-  			continue;
-  			}
-  		}
-  		else
-  		{
-  			if(f->test[m-1]!=3&&cur/4!=0)
-  			{
-  			f->test[m++]=3;//south
-  			cur-=4;
-  			c0=cur%4;
-  			c1=cur/4;
-  			e0=d0-c0;
-  			e1=d1-c1;
-  			continue;
-  			}
-  		}
-  	}
-  	else 
-  	{
-  		if(e0>0)	//east bounded
-  		{
-  			if(e1==0)
-  			{
-  				if(f->test[m-1]!=1&&cur%4!=3)
-  				{
-  				f->test[m++]=1;		//east
-  				cur+=1;
-  				c0=cur%4;
-  				c1=cur/4;
-  				e0=d0-c0;
-  				e1=d1-c1;
-  				continue;
-  				}
-  			}
-  			else			//diff row and east bound
-  			{
-  				if(c0%2==1||c0==s0)
-  				{
-  					if(e1>0)
-  					{
-  						if(f->test[m-1]!=2&&cur/4!=3)
-  						{
-  						f->test[m++]=2;			//north
-  						cur+=4;
-  						c0=cur%4;
-  						c1=cur/4;
-  						e0=d0-c0;
-  						e1=d1-c1;
-  						//continue;
-  						}
-  					}
-  					else
-  					{
-  						if(f->test[m-1]!=3&&cur/4!=0)
-  						{
-  						f->test[m++]=3;		//south
-  						cur-=4;
-  						c0=cur%4;
-  						c1=cur/4;
-  						e0=d0-c0;
-  						e1=d1-c1;
-  						//continue;
-  						}
-  					}
-  				}
-  				if(d0%2==1||e0!=1)		//odd destination column or >= 2 columns to destination
-  				{	
-  					if(f->test[m-1]!=1&&cur%4!=3)
-  					{
-  					f->test[m++]=1;			//east
-  					cur+=1;
-  					c0=cur%4;
-  					c1=cur/4;
-  					e0=d0-c0;
-  					e1=d1-c1;
-  					continue;
-  					}
-  				}
-  		
-  			}
-  		}
-  		else
-  		{
-  			//west bounded messages
-  			if(f->test[m-1]!=0&&cur%4!=0)
-  			{
-  			f->test[m++]=0;
-  			cur-=1;
-  			c0=cur%4;
-  			c1=cur/4;
-  			e0=d0-c0;
-  			e1=d1-c1;
-  			}
-  			//continue;
-  			if(c0%2==0)
-  			{
-  				if(e1>0)
-  				{
-  					if(f->test[m-1]!=2&&cur/4!=3)			//north
-  					{
-  					f->test[m++]=2;
-  					cur+=4;
-  					c0=cur%4;
-  					c1=cur/4;
-  					e0=d0-c0;
-  					e1=d1-c1;
-  					//continue;
-  					}
-  				}
-  				else
-  				{
-  					if(f->test[m-1]!=3&&cur/4!=0)
-  					{	
-  					f->test[m++]=3;						//south
-  					cur-=4;
-  					c0=cur%4;
-  					c1=cur/4;
-  					e0=d0-c0;
-  					e1=d1-c1;
-  					//continue;
-  					}
-  				}
-  			}
-  		
-  		
-  		}	
-  	}
-  	
-  	
-  	
-  	
-  }
-  
-// if(flag==0)
-// f->test[m++]=4;
- 
- cout<<"\n "<<"source:"<<src<<"destination:"<<dest<<"path";
- for(int i=0;i<7;i++)
- cout<<f->test[i];
- }
-
 void TrafficManager::_GeneratePacket( int source, int stype, 
 				      int cl, int time)
 {
@@ -1156,7 +858,7 @@ void TrafficManager::_GeneratePacket( int source, int stype,
   }
 
   Flit::FlitType packet_type = Flit::ANY_TYPE;
-  int size = gConstPacketSize; //input size 
+  int size = gSim->const_packet_size; //input size 
   int ttime = time;
   int packet_destination;
   bool record = false;
@@ -1239,21 +941,30 @@ else if(rand1<=flitdc)
 
   _sub_network = DivisionAlgorithm(packet_type);
   
-  bool watch  = gWatchOut && (_packets_to_watch.count(_cur_pid) > 0);
+  bool watch  = gSim->watch_out && (_packets_to_watch.count(_cur_pid) > 0);
   
   
   if ( watch ) { 
-    *gWatchOut << GetSimTime() << " | "
+    *gSim->watch_out << GetSimTime() << " | "
 		<< "node" << source << " | "
 		<< "Enqueuing packet " << _cur_pid
 		<< " at time " << time
 		<< "." << endl;
   }
   
+  // the route is looked up once per packet; every flit shares the table entry
+  const unsigned long long * route_words = 0;
+  int route_length = 0;
+  if ( _route_table ) {
+    int path = _path_selector->Select( _sub_network, source, packet_destination, cl );
+    route_words  = _route_table->Words( source, packet_destination, path );
+    route_length = _route_table->Length( source, packet_destination, path );
+  }
+
   for ( int i = 0; i < size; ++i )
   {
     Flit * f = _NewFlit( );
-    fp<<"flit id is---------"<<f->id<<endl;
+    gSim->Trace( )<<"flit id is---------"<<f->id<<endl;
     f->pid = _cur_pid;
     f->watch |= watch;
     f->subnetwork = _sub_network;
@@ -1261,19 +972,10 @@ else if(rand1<=flitdc)
     f->time   = time;
     f->ttime  = ttime;
     f->record = record;
-    f->itest=-1;
-    
-    
-   _Sourceroute(source,packet_destination, f);
-    
-   // _Sourcerouteoddeven1(source,packet_destination, f);
-    
-  //   _Sourcerouteoddeven(source,packet_destination, f);
-    
-    
+    f->route.Start( _route_table ? _route_table->Format( ) : 0, route_words, route_length );
     
     if(record) {
-      _measured_in_flight_flits[f->id] = f;
+      _measured_in_flight_flits.Insert(f->id, f);
     }
     
     if(gTrace){
@@ -1285,9 +987,9 @@ else if(rand1<=flitdc)
       f->head = true;
       //packets are only generated to nodes smaller or equal to limit
       f->dest = packet_destination;
-      _total_in_flight_packets.insert(pair<int, Flit *>(f->pid, f));
+      _total_in_flight_packets.Insert(f->pid, f);
       if(record) {
-	_measured_in_flight_packets.insert(pair<int, Flit *>(f->pid, f));
+	_measured_in_flight_packets.Insert(f->pid, f);
       }
     } else {
       f->head = false;
@@ -1317,7 +1019,7 @@ else if(rand1<=flitdc)
 
    
     if ( f->id==28760 ) { 
-      fp<< GetSimTime() << " | "
+      gSim->Trace( )<< GetSimTime() << " | "
 		  << "node" << source << " | "
 		  << "Enqueuing flit " << f->id
 		  << " (packet " << f->pid
@@ -1325,7 +1027,7 @@ else if(rand1<=flitdc)
 		  << "." << endl;
      }
     if ( f->watch ) { 
-      *gWatchOut << GetSimTime() << " | "
+      *gSim->watch_out << GetSimTime() << " | "
 		  << "node" << source << " | "
 		  << "Enqueuing flit " << f->id
 		  << " (packet " << f->pid
@@ -1360,7 +1062,7 @@ void TrafficManager::_BatchInject(){
       Credit * cred = _net[i]->ReadCredit( input ); //ReadCredit() is present in network.cpp
       if ( cred ) {
         _buf_states[input][i]->ProcessCredit( cred ); //ProcessCredit() is present in buffer_state.cpp
-        delete cred;
+        _credit_pool.Free( cred );
       }
     }
     
@@ -1432,7 +1134,7 @@ void TrafficManager::_BatchInject(){
 	  }
 
 	  if(f->watch) {
-	    *gWatchOut << GetSimTime() << " | "
+	    *gSim->watch_out << GetSimTime() << " | "
 			<< "node" << input << " | "
 			<< "Injecting flit " << f->id
 			<< " at time " << _time
@@ -1471,7 +1173,7 @@ void TrafficManager::_NormalInject()
 		      	if ( cred )
 			{
 				_buf_states[input][i]->ProcessCredit( cred );
-				delete cred;
+				_credit_pool.Free( cred );
 	      		}
 	    	} // end for
     
@@ -1579,12 +1281,12 @@ void TrafficManager::_NormalInject()
 					}
 					if(f->id==28760)
 					{
-			    			fp << GetSimTime() << " | " << "node" << input << " | " << "Injecting flit " << f->id
+			    			gSim->Trace( ) << GetSimTime() << " | " << "node" << input << " | " << "Injecting flit " << f->id
 					<< " at time " << _time << " with priority " << f->pri << "." << endl;
 			  		}
 			  		if(f->watch)
 					{
-			    			*gWatchOut << GetSimTime() << " | " << "node" << input << " | " << "Injecting flit " << f->id
+			    			*gSim->watch_out << GetSimTime() << " | " << "node" << input << " | " << "Injecting flit " << f->id
 					<< " at time " << _time << " with priority " << f->pri << "." << endl;
 			  		}
 			  
@@ -1607,6 +1309,26 @@ void TrafficManager::_NormalInject()
   	}// end for input <_sources
 }
 //********************************************************************************************
+//Advances subnetwork i by one cycle, up to writing its outputs
+void TrafficManager::_StepNetwork( int i )
+{
+	_net[i]->WakeRouters( );
+	_net[i]->Clear_has_input();	//fluidity
+	_net[i]->ReadInputs( );
+	_partial_internal_cycles[i] += _internal_speedup;
+	while( _partial_internal_cycles[i] >= 1.0 )
+	{
+		_net[i]->InternalStep( );
+		_partial_internal_cycles[i] -= 1.0;
+	}
+	//**********update John  (calling network module for updations......)***************************
+	_net[i]->update_wnof_values();
+	_net[i]->update_nop_values();
+	_net[i]->Update_cum_time_out(); // BOFAR
+	// comment the following if condition for wnof to be calculated on all cycles, 
+	// change in router.cpp also to uncomment the call calc_wnof_all_ports(); in update_wnof_values();
+}
+//********************************************************************************************
 //A single step in simulation
 void TrafficManager::_Step( )
 {
@@ -1616,7 +1338,6 @@ void TrafficManager::_Step( )
 	}
 	// different types of injections based on sim type
 				//wnof resetting (RI)  Refresh interval   (Refresh Interval for TRACKER)
-				vector<Router *> routers;
 				if(_time%16==0)   // 16, 32, 64 etc...
 				{
 				for (int i = 0; i < _duplicate_networks; ++i)
@@ -1624,13 +1345,14 @@ void TrafficManager::_Step( )
 	
 					//reset counters in all routers
 		
-					routers=_net[i]->GetRouters();
-					for ( int r = 0; r < routers.size(); ++r )
-				 	{
-				    		routers[r]->Update_cum_flits();
-				 	}
+					_net[i]->Update_cum_flits();
 				}
 				}
+	// congestion snapshot for injection-time path selection
+	if(_path_selector)
+	{
+		_path_selector->Refresh( _time );
+	}
 	if(_sim_mode == batch)
 	{
 		_BatchInject();             // go up and see _BatchInject() ^|
@@ -1641,38 +1363,21 @@ void TrafficManager::_Step( )
 	}
         //cout<<"after injection"<<endl;
 	//advance networks
-	int count_step=0;
-	for (int i = 0; i < _duplicate_networks; ++i)
+	if ( _subnet_stepper )
 	{
-		/*cout<<"i------"<<i<<endl;
-		getchar();*/
-		//cout<<"before readinputs"<<endl;
-		_net[i]->Clear_has_input();	//fluidity
-		_net[i]->ReadInputs( );
-		//cout<<"after readinputs"<<endl;
-	    	_partial_internal_cycles[i] += _internal_speedup;
-	    	while( _partial_internal_cycles[i] >= 1.0 )
-		{
-	      		count_step++;
-	      		//cout<<"before internal step"<<endl;
-	      		_net[i]->InternalStep( );
-	      	        //cout<<"after internal step"<<endl;
-	      	     
-	      		_partial_internal_cycles[i] -= 1.0;
-	    	}
-	//**********update John  (calling network module for updations......)***************************
-	_net[i]->update_wnof_values();
-	_net[i]->update_nop_values();
-	_net[i]->Update_cum_time_out(); // BOFAR
-	
-	//cout<<"time="<<_time<<endl;
-		// comment the following if condition for wnof to be calculated on all cycles, 
-		// change in router.cpp also to uncomment the call calc_wnof_all_ports(); in update_wnof_values();
+		// ends with a barrier, ejection below is merged serially
+		_subnet_stepper->Run( );
 	}
-	//vector<Router *> routers;
-	for (int a = 0; a < _duplicate_networks; ++a)
+	else
 	{
-		_net[a]->WriteOutputs( );
+		for (int i = 0; i < _duplicate_networks; ++i)
+		{
+			_StepNetwork( i );
+		}
+		for (int a = 0; a < _duplicate_networks; ++a)
+		{
+			_net[a]->WriteOutputs( );
+		}
 	}
 	  
 	for (int i = 0; i < _duplicate_networks; ++i)
@@ -1680,6 +1385,8 @@ void TrafficManager::_Step( )
 	    // Eject traffic and send credits
 		for ( int output = 0; output < _dests; ++output )
 		{
+			if ( _event_driven && !_net[i]->Ejecting( output ) )
+				continue;	// sampled by _SyncAccepted
 	      		Flit * f = _net[i]->ReadFlit( output );  		
 	      		
 	      		
@@ -1690,27 +1397,27 @@ void TrafficManager::_Step( )
 				f->atime = _time;
 				if ( f->id==28760 )
 				{
-				  	fp << GetSimTime() << " | " << "node" << output << " | "
+				  	gSim->Trace( ) << GetSimTime() << " | " << "node" << output << " | "
 					      << "Ejecting flit " << f->id
 					      << " (packet " << f->pid << ")"
 					      << " from VC " << f->vc
 					      << "." << endl;
-				  	fp << GetSimTime() << " | "  << "node" << output << " | "
+				  	gSim->Trace( ) << GetSimTime() << " | "  << "node" << output << " | "
 					      << "Injecting credit for VC " << f->vc << "." << endl;
 				}
 				if ( f->watch )
 				{
-				  	*gWatchOut << GetSimTime() << " | " << "node" << output << " | "
+				  	*gSim->watch_out << GetSimTime() << " | " << "node" << output << " | "
 					      << "Ejecting flit " << f->id
 					      << " (packet " << f->pid << ")"
 					      << " from VC " << f->vc
 					      << "." << endl;
-				  	*gWatchOut << GetSimTime() << " | "  << "node" << output << " | "
+				  	*gSim->watch_out << GetSimTime() << " | "  << "node" << output << " | "
 					      << "Injecting credit for VC " << f->vc << "." << endl;
 				}
 				
 	      
-				Credit * cred = new Credit( 1 );
+				Credit * cred = _credit_pool.New( );
 				cred->vc[0] = f->vc;
 				cred->vc_cnt = 1;
 				cred->dest_router = f->from_router;
@@ -1718,18 +1425,22 @@ void TrafficManager::_Step( )
 				_RetireFlit( f, output );
 	      
 				if( ( _sim_state == warming_up ) || ( _sim_state == running ) )
-					_accepted_flits[output]->AddSample( 1 );
+					_AcceptSample( output, 1 );
 	      		}
 			else
 			{
 				_net[i]->WriteCredit( 0, output );
 				if( ( _sim_state == warming_up ) || ( _sim_state == running ) )
-				  	_accepted_flits[output]->AddSample( 0 );
+				  	_AcceptSample( output, 0 );
 			}
 		}
+		if( ( _sim_state == warming_up ) || ( _sim_state == running ) )
+			++_accept_cycles;
 
 	    	for(int j = 0; j < _routers; ++j)
 		{
+			if ( _router_map[i][j]->Asleep( ) )
+				continue;	// nothing received or sent
 			_received_flow[i*_routers+j] += _router_map[i][j]->GetReceivedFlits();
 			_sent_flow[i*_routers+j] += _router_map[i][j]->GetSentFlits();
 			_router_map[i][j]->ResetFlitStats();
@@ -1750,7 +1461,7 @@ bool TrafficManager::_PacketsOutstanding( ) const
 {
 	bool outstanding;
 
-	if ( _measured_in_flight_packets.empty() )
+	if ( _measured_in_flight_packets.Empty() )
 	{
 		outstanding = false;
 		for ( int c = 0; c < _classes; ++c )
@@ -1773,7 +1484,7 @@ bool TrafficManager::_PacketsOutstanding( ) const
 	else
 	{
 		#ifdef DEBUG_DRAIN
-	    	cout << "in flight = " << _measured_in_flight_packets.size() << endl;
+	    	cout << "in flight = " << _measured_in_flight_packets.Size() << endl;
 		#endif
 	    	outstanding = true;
 	}
@@ -1807,10 +1518,34 @@ void TrafficManager::_ClearStats( )
 	{
 	    	_accepted_flits[i]->Clear( );
 	}
+	_accept_synced.assign( _dests, _accept_cycles );
 	  
 	_hop_stats->Clear();
 
 } // end _ClearStats
+
+void TrafficManager::_AcceptSample( int output, int flits )
+{
+	if ( _event_driven )
+	{
+		_accepted_flits[output]->AddSamples( 0, _accept_cycles - _accept_synced[output] );
+		_accept_synced[output] = _accept_cycles + 1;
+	}
+	_accepted_flits[output]->AddSample( flits );
+}
+
+// adds the zero samples of the rounds event_driven skipped an output in;
+// needed before _accepted_flits is read
+void TrafficManager::_SyncAccepted( )
+{
+	if ( !_event_driven )
+		return;
+	for ( int d = 0; d < _dests; ++d )
+	{
+		_accepted_flits[d]->AddSamples( 0, _accept_cycles - _accept_synced[d] );
+		_accept_synced[d] = _accept_cycles;
+	}
+}
 //*****************************************************************************************
 int TrafficManager::_ComputeStats( const vector<Stats *> & stats, double *avg, double *min ) const 
 {
@@ -1834,33 +1569,38 @@ int TrafficManager::_ComputeStats( const vector<Stats *> & stats, double *avg, d
 
 void TrafficManager::_DisplayRemaining( ) const 
 {
-  map<int, Flit *>::const_iterator iter;
-  int i;
+  int id, i;
 
   cout << "Remaining flits: ";
-  for ( iter = _total_in_flight_flits.begin( ), i = 0;
-	( iter != _total_in_flight_flits.end( ) ) && ( i < 10 );
-	iter++, i++ ) {
-    cout << iter->first << " ";
+  for ( id = _total_in_flight_flits.Begin( ), i = 0;
+	( id < _total_in_flight_flits.End( ) ) && ( i < 10 );
+	id++ ) {
+    if ( _total_in_flight_flits.Find( id ) ) {
+      cout << id << " ";
+      i++;
+    }
   }
-  if(_total_in_flight_flits.size() > 10)
+  if(_total_in_flight_flits.Size() > 10)
     cout << "[...] ";
   
-  cout << "(" << _total_in_flight_flits.size() << " flits"
-       << ", " << _total_in_flight_packets.size() << " packets"
+  cout << "(" << _total_in_flight_flits.Size() << " flits"
+       << ", " << _total_in_flight_packets.Size() << " packets"
        << ")" << endl;
   
   cout << "Measured flits: ";
-  for ( iter = _measured_in_flight_flits.begin( ), i = 0;
-	( iter != _measured_in_flight_flits.end( ) ) && ( i < 10 );
-	iter++, i++ ) {
-    cout << iter->first << " ";
+  for ( id = _measured_in_flight_flits.Begin( ), i = 0;
+	( id < _measured_in_flight_flits.End( ) ) && ( i < 10 );
+	id++ ) {
+    if ( _measured_in_flight_flits.Find( id ) ) {
+      cout << id << " ";
+      i++;
+    }
   }
-  if(_measured_in_flight_flits.size() > 10)
+  if(_measured_in_flight_flits.Size() > 10)
     cout << "[...] ";
   
-  cout << "(" << _measured_in_flight_flits.size() << " flits"
-       << ", " << _measured_in_flight_packets.size() << " packets"
+  cout << "(" << _measured_in_flight_flits.Size() << " flits"
+       << ", " << _measured_in_flight_packets.Size() << " packets"
        << ")" << endl;
   
 }
@@ -1925,6 +1665,7 @@ bool TrafficManager::_SingleSim( )
 		  			*_stats_out << "%=================================" << endl;
 				double cur_latency = _latency_stats[0]->Average( );
 				double min, avg;
+				_SyncAccepted( );
 				int dmin = _ComputeStats( _accepted_flits, &avg, &min );
 	
 				cout << "Minimum latency = " << _latency_stats[0]->Min( ) << endl;
@@ -1940,7 +1681,7 @@ bool TrafficManager::_SingleSim( )
 			      << *_frag_stats[0] << ";" << endl;
 	      		}  // end if
 	    	} // end while
-    		cout << "Total inflight " << _total_in_flight_packets.size() << endl;
+    		cout << "Total inflight " << _total_in_flight_packets.Size() << endl;
     		converged = 1;
 
   	}  // end if batch & timed_mode
@@ -1986,7 +1727,7 @@ bool TrafficManager::_SingleSim( )
       			_sim_state = draining;
       			_drain_time = _time;
       			int empty_steps = 0;
-      			while( (_drain_measured_only ? _measured_in_flight_packets.size() : _total_in_flight_packets.size()) > 0 )
+      			while( (_drain_measured_only ? _measured_in_flight_packets.Size() : _total_in_flight_packets.Size()) > 0 )
 			{ 
 				_Step( );           // invoke the _Step function ().. go up ^| 
 				//count_step++;  // added John to know count of _Step calling
@@ -2017,6 +1758,7 @@ bool TrafficManager::_SingleSim( )
 				*_stats_out << "%=================================" << endl;
 		      	double cur_latency = _latency_stats[0]->Average( );
 		      	double min, avg;
+		      	_SyncAccepted( );
 		      	int dmin = _ComputeStats( _accepted_flits, &avg, &min );
 		      
 		      	cout << "Batch duration = " << _time - start_time << endl;
@@ -2143,6 +1885,7 @@ bool TrafficManager::_SingleSim( )
 		      	double cur_latency = _latency_stats[0]->Average( );
 		      	int dmin;
 		      	double min, avg;
+		      	_SyncAccepted( );
 		      	dmin = _ComputeStats( _accepted_flits, &avg, &min );
 		      	double cur_accepted = avg;
 			cout<<"simulation in Phase: Itertaion :"<<total_phases<<endl;
@@ -2319,10 +2062,12 @@ bool TrafficManager::_SingleSim( )
 				    
 					    	int res_latency = 0;
 					    	int res_count = 0;
-					    	map<int, Flit *>::const_iterator iter;
-					    	for(iter = _measured_in_flight_flits.begin();iter != _measured_in_flight_flits.end();iter++)
+					    	for(int id = _measured_in_flight_flits.Begin();id < _measured_in_flight_flits.End();id++)
 						{
-					      		res_latency += _time - iter->second->time;
+							Flit * f = _measured_in_flight_flits.Find(id);
+							if(!f)
+								continue;
+					      		res_latency += _time - f->time;
 					      		res_count++;
 					    	}
 						if((acc_latency + res_latency) / (acc_count + res_count) > _latency_thres)
@@ -2352,7 +2097,7 @@ bool TrafficManager::_SingleSim( )
 		cout << "Draining remaining packets ..." << endl;
 		_empty_network = true;
 		int empty_steps = 0;
-		while( (_drain_measured_only ? _measured_in_flight_packets.size() : _total_in_flight_packets.size()) > 0 )
+		while( (_drain_measured_only ? _measured_in_flight_packets.Size() : _total_in_flight_packets.Size()) > 0 )
 		{ 
 			_Step( );
 			if(_flow_out)
@@ -2413,6 +2158,7 @@ bool TrafficManager::Run( )  // called from main()  after Traffic manger object
 	    	}
 	    
 	    	double min, avg;
+	    	_SyncAccepted( );
 	    	_ComputeStats( _accepted_flits, &avg, &min );
 	    	_overall_accepted->AddSample( avg );
 	    	_overall_accepted_min->AddSample( min );
@@ -2430,6 +2176,10 @@ bool TrafficManager::Run( )  // called from main()  after Traffic manger object
 	    	}
 	    	VC::DisplayStats(_print_csv_results);
 	}
+	if(_print_flit_arena)
+	{
+		_flit_arena.Display( );
+	}
 
 	return true; // return to main "successful simulation status== true"
 
@@ -2469,7 +2219,7 @@ void TrafficManager::DisplayStats() {
 	 << " (" << _overall_min_latency[c]->NumSamples( ) << " samples)" << endl;
     cout << "Overall average latency = " << _overall_avg_latency[c]->Average( )
 	 << " (" << _overall_avg_latency[c]->NumSamples( ) << " samples)" << endl;
-    fp_stats<< _overall_avg_latency[c]->Average( )<<endl;
+    gSim->stats<< _overall_avg_latency[c]->Average( )<<endl;
     cout << "Overall maximum latency = " << _overall_max_latency[c]->Average( )
 	 << " (" << _overall_max_latency[c]->NumSamples( ) << " samples)" << endl;
     cout << "Overall minimum transaction latency = " << _overall_min_tlat[c]->Average( )
@@ -39,12 +39,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "config_utils.hpp"
 #include "network.hpp"
 #include "flit.hpp"
+#include "flitarena.hpp"
+#include "inflight.hpp"
 #include "buffer_state.hpp"
 #include "stats.hpp"
 #include "traffic.hpp"
 #include "routefunc.hpp"
 #include "outputset.hpp"
 #include "injection.hpp"
+#include "routetable.hpp"
+#include "pathselect.hpp"
 #include <assert.h>
 
 //register the requests to a node
@@ -79,7 +83,8 @@ bool stop;
 int flitac, flitbc, flitcc,flitdc;
 int counta,countb,countc,countd;
 
-  vector <Flit *> _flit_pool;
+  FlitArena _flit_arena;
+  CreditPool _credit_pool;   // ejection credits, refilled by injection
 
   // ============ Message priorities ============ 
 
@@ -99,10 +104,11 @@ int counta,countb,countc,countd;
   vector<vector<bool> > _qdrained;
   vector<vector<vector<list<Flit *> > > > _partial_packets;
 
-  map<int, Flit *> _measured_in_flight_flits;
-  multimap<int, Flit *> _measured_in_flight_packets;
-  map<int, Flit *> _total_in_flight_flits;
-  multimap<int, Flit *> _total_in_flight_packets;
+  // by flit id, and by packet id to the head flit
+  InFlightTable<Flit> _measured_in_flight_flits;
+  InFlightTable<Flit> _measured_in_flight_packets;
+  InFlightTable<Flit> _total_in_flight_flits;
+  InFlightTable<Flit> _total_in_flight_packets;
   bool                _empty_network;
   bool _use_lagging;
 
@@ -225,9 +231,6 @@ int counta,countb,countc,countd;
   int _cur_pid;
   int _time;
 
-  list<Flit *> _used_flits;
-  list<Flit *> _free_flits;
-
   tTrafficFunction  _traffic_function;
   tRoutingFunction  _routing_function;
   tInjectionProcess _injection_process;
@@ -237,6 +240,7 @@ int counta,countb,countc,countd;
 
   bool _print_csv_results;
   bool _print_vc_stats;
+  bool _print_flit_arena;
   string _traffic;
   bool _drain_measured_only;
 
@@ -244,6 +248,19 @@ int counta,countb,countc,countd;
   ostream * _stats_out;
   ostream * _flow_out;
 
+  // source routes of every pair, only used by source routing
+  RouteTable * _route_table;
+  PathSelector * _path_selector;
+
+  // steps the subnetworks in parallel, null when they are stepped serially
+  SubnetStepper * _subnet_stepper;
+
+  // event_driven: ejection only visits the outputs with a flit on its way,
+  // the zero samples of the others are added by _SyncAccepted
+  bool _event_driven;
+  int  _accept_cycles;          // ejection rounds sampled so far
+  vector<int> _accept_synced;   // rounds covered by each output's samples
+
   // ============ Internal methods ============ 
 protected:
   virtual Flit *_NewFlit( );
@@ -253,10 +270,8 @@ protected:
   void _NormalInject();
   void _BatchInject();
   void _LoadFileInject();
+  void _StepNetwork( int i );
   void _Step( );
-  void _Sourceroute(int source, int packet_destination, Flit *f);
-  void _Sourcerouteoddeven1(int source, int packet_destination, Flit *f);
-   void _Sourcerouteoddeven(int source, int packet_destination, Flit *f);
   bool _PacketsOutstanding( ) const;
   
   virtual int  _IssuePacket( int source, int cl );
@@ -264,6 +279,8 @@ protected:
  // virtual void load_GeneratePacket( int source, int size, int cl, int time,int load_dest );
 
   void _ClearStats( );
+  void _AcceptSample( int output, int flits );
+  void _SyncAccepted( );
 
   int  _ComputeStats( const vector<Stats *> & stats, double *avg, double *min ) const;
 
@@ -287,6 +304,7 @@ public:
   const Stats * GetAccepted() { return _overall_accepted; }
   const Stats * GetAcceptedMin() { return _overall_accepted_min; }
   const Stats * GetHops() { return _hop_stats; }
+  int NumClasses() const { return _classes; }
 
   inline int getTime() { return _time;}
   Stats * getStats(const string & name) { return _stats[name]; }
@@ -40,6 +40,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "booksim.hpp"
 #include "vc.hpp"
 
+#include <mutex>
+
 int VC::total_cycles = 0;
 const char * const VC::VCSTATE[] = {"idle",
 				    "routing",
@@ -55,6 +57,8 @@ VC::state_info_t VC::state_info[] = {{0},
 				     {0},
 				     {0}};
 int VC::occupancy = 0;
+thread_local VC::thread_stats_t VC::_thread_stats;
+static mutex gVCStatsLock;
 
 VC::VC( const Configuration& config, int outputs ) :
   Module( )
@@ -79,6 +83,7 @@ void VC::_Init( const Configuration& config, int outputs )
   _state_time = 0;
 
   _size = int( config.GetInt( "vc_buf_size" ) );
+  _buffer.Reserve( _size );
 
   _route_set = new OutputSet( outputs );
 
@@ -115,7 +120,7 @@ bool VC::AddFlit( Flit *f )
 {
   assert(f);
 
-  if((int)_buffer.size() >= _size) return false;
+  if(_buffer.Size() >= _size) return false;
 
   // update flit priority before adding to VC buffer
   if(_pri_type == local_age_based) {
@@ -124,22 +129,22 @@ bool VC::AddFlit( Flit *f )
     f->pri = f->hops;
   }
 
-  _buffer.push_back(f);
+  _buffer.Push(f);
   UpdatePriority();
   return true;
 }
 
 Flit *VC::FrontFlit( )
 {
-  return _buffer.empty() ? NULL : _buffer.front();
+  return _buffer.Empty() ? NULL : _buffer.Front();
 }
 
 Flit *VC::RemoveFlit( )
 {
   Flit *f = NULL;
-  if ( !_buffer.empty( ) ) {
-    f = _buffer.front( );
-    _buffer.pop_front( );
+  if ( !_buffer.Empty( ) ) {
+    f = _buffer.Front( );
+    _buffer.Pop( );
     UpdatePriority();
   }
   return f;
@@ -152,7 +157,7 @@ void VC::SetState( eVCState s )
   Flit * f = FrontFlit();
   
   if(f && f->watch)
-    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+    *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		<< "Changing state from " << VC::VCSTATE[_state]
 		<< " to " << VC::VCSTATE[s] << "." << endl;
   
@@ -161,11 +166,11 @@ void VC::SetState( eVCState s )
      ((_state == vc_spec) && (s == vc_spec_grant))) {
     assert(f);
     if(f->watch)
-      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		  << "Keeping state time at " << _state_time << "." << endl;
   } else {
     if(f && f->watch)
-      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		  << "Resetting state time." << endl;
     _state_time = 0;
   }
@@ -186,19 +191,19 @@ void VC::SetOutput( int port, int vc )
 
 void VC::UpdatePriority()
 {
-  if(_buffer.empty()) return;
+  if(_buffer.Empty()) return;
   if(_pri_type == queue_length_based) {
-    _pri = _buffer.size();
+    _pri = _buffer.Size();
   } else if(_pri_type != none) {
-    Flit * f = _buffer.front();
+    Flit * f = _buffer.Front();
     if((_pri_type != local_age_based) && _priority_donation) {
       Flit * df = f;
-      for(int i = 1; i < _buffer.size(); ++i) {
+      for(int i = 1; i < _buffer.Size(); ++i) {
 	Flit * bf = _buffer[i];
 	if(bf->pri > df->pri) df = bf;
       }
       if((df != f) && (df->watch || f->watch)) {
-	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
+	*gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		    << "Flit " << df->id
 		    << " donates priority to flit " << f->id
 		    << "." << endl;
@@ -206,7 +211,7 @@ void VC::UpdatePriority()
       f = df;
     }
     if(f->watch)
-      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+      *gSim->watch_out << GetSimTime() << " | " << FullName() << " | "
 		  << "Flit " << f->id
 		  << " sets priority to " << f->pri
 		  << "." << endl;
@@ -217,7 +222,7 @@ void VC::UpdatePriority()
 
 int VC::GetSize() const
 {
-  return (int)_buffer.size();
+  return _buffer.Size();
 }
 
 void VC::Route( tRoutingFunction rf, const Router* router, const Flit* f, int in_channel )//called for a particular router for a particular flit
@@ -225,13 +230,19 @@ void VC::Route( tRoutingFunction rf, const Router* router, const Flit* f, int in
   rf( router, f, in_channel, _route_set, false );
 }
 
+void VC::SetRoute( int out_port, int vc_start, int vc_end )
+{
+  _route_set->Clear( );
+  _route_set->AddRange( out_port, vc_start, vc_end );
+}
+
 void VC::AdvanceTime( )
 {
   if(!Empty()) {
     _state_time++;
   }
   
-  total_cycles++;
+  _thread_stats.total_cycles++;
   switch( _state ) {
   case idle          : _idle_cycles++; break;
   case active        : _active_cycles++; break;
@@ -240,8 +251,28 @@ void VC::AdvanceTime( )
   case vc_spec       : _vc_alloc_cycles++; break;
   case routing       : _routing_cycles++; break;
   }
-  state_info[_state].cycles++;
-  occupancy += _buffer.size();
+  _thread_stats.cycles[_state]++;
+  _thread_stats.occupancy += _buffer.Size();
+}
+
+void VC::CountIdle( int vc_steps )
+{
+  _thread_stats.total_cycles += vc_steps;
+  _thread_stats.cycles[idle] += vc_steps;
+}
+
+void VC::FlushStats( )
+{
+  if ( _thread_stats.total_cycles == 0 ) {
+    return;
+  }
+  lock_guard<mutex> lock( gVCStatsLock );
+  total_cycles += _thread_stats.total_cycles;
+  for(eVCState state = state_min; state <= state_max; state = eVCState(state+1)) {
+    state_info[state].cycles += _thread_stats.cycles[state];
+  }
+  occupancy += _thread_stats.occupancy;
+  _thread_stats = thread_stats_t( );
 }
 
 // ==== Debug functions ====
@@ -263,13 +294,14 @@ void VC::Display( ) const
 	 << " state: " << VCSTATE[_state]
 	 << " out_port: " << _out_port
 	 << " out_vc: " << _out_vc 
-	 << " fill: " << _buffer.size() 
+	 << " fill: " << _buffer.Size() 
 	 << endl ;
   }
 }
 
 void VC::DisplayStats( bool print_csv )
 {
+  FlushStats( );
   if(print_csv) {
     for(eVCState state = state_min; state <= state_max; state = eVCState(state+1)) {
       cout << (float)state_info[state].cycles/(float)total_cycles << ",";
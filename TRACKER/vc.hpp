@@ -31,12 +31,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef _VC_HPP_
 #define _VC_HPP_
 
-#include <deque>
-
 #include "flit.hpp"
 #include "outputset.hpp"
 #include "routefunc.hpp"
 #include "config_utils.hpp"
+#include "ring.hpp"
 
 class VCRouter;
 
@@ -52,7 +51,7 @@ public:
 private:
   int _size;
 
-  deque<Flit *> _buffer;
+  Ring<Flit *> _buffer;  // holds _size flits, see _Init
   
   eVCState _state;
   int      _state_time;
@@ -69,6 +68,15 @@ private:
   static int total_cycles;
   static state_info_t state_info[];
   static int occupancy;
+
+  // AdvanceTime counts into per-thread partial sums so routers can be
+  // stepped from several threads; FlushStats adds them to the totals above
+  struct thread_stats_t {
+    int total_cycles;
+    int cycles[state_max+1];
+    int occupancy;
+  };
+  static thread_local thread_stats_t _thread_stats;
   
   enum ePrioType { local_age_based, queue_length_based, hop_count_based, none, other };
 
@@ -97,12 +105,12 @@ public:
   
   inline bool Empty( ) const
   {
-    return _buffer.empty( );
+    return _buffer.Empty( );
   }
 
   inline bool Full( ) const
   {
-    return (int)_buffer.size( ) == _size;
+    return _buffer.Size( ) == _size;
   }
 
   inline VC::eVCState GetState( ) const
@@ -140,6 +148,8 @@ public:
     return _pri;
   }
   void Route( tRoutingFunction rf, const Router* router, const Flit* f, int in_channel );
+  // look-ahead routing: the route was decoded outside the routing stage
+  void SetRoute( int out_port, int vc_start, int vc_end );
 
   void AdvanceTime( );
 
@@ -149,6 +159,10 @@ public:
   bool IsWatched( ) const;
   int GetSize() const;
   void Display( ) const;
+  static void FlushStats( );
+  // steps of a sleeping router: per VC on waking, in bulk for the totals
+  void SkipIdle( int steps ) { _idle_cycles += steps; }
+  static void CountIdle( int vc_steps );
   static void DisplayStats( bool print_csv = false );
 };
 